@@ -9,6 +9,7 @@
 */
 
 #include "BenchmarkComponent.h"
+#include "BenchmarkReportComponent.h"
 #include "../Main.h"
 
 BenchmarkComponent::BenchmarkComponent (ProcessorHarness* processorHarnessA,
@@ -31,6 +32,7 @@ BenchmarkComponent::BenchmarkComponent (ProcessorHarness* processorHarnessA,
     // Initialise labels for showing results
     using cols = DspTestBenchLnF::ApplicationColours;
     jassert (values.size() == valueTooltips.size());
+    jassert (static_cast<int> (values.size()) == ProcessorHarness::numQueryValues);
     for (const auto& p : processors)
     {
         auto* lblP = processorLabels.add (new Label ("", p));
@@ -62,6 +64,19 @@ BenchmarkComponent::BenchmarkComponent (ProcessorHarness* processorHarnessA,
                 addAndMakeVisible (lblV);
             }
         }
+        auto* lblB = budgetLabels.add (new Label ("", "-"));
+        lblB->setFont (normalFont);
+        lblB->setColour (Label::backgroundColourId, cols::benchmarkAlternateRow());
+        lblB->setColour (Label::textColourId, cols::normalFontColour());
+        lblB->setTooltip ("Real-time budget for the process routine (block size / sample rate): the percentage of the budget used on average and at high percentiles, "
+                          "the number of calls which would have missed the deadline, and the number of instances which would fit in one callback");
+        addAndMakeVisible (lblB);
+        auto* lblC = counterLabels.add (new Label ("", "-"));
+        lblC->setFont (normalFont);
+        lblC->setColour (Label::backgroundColourId, cols::benchmarkRow());
+        lblC->setColour (Label::textColourId, cols::normalFontColour());
+        lblC->setTooltip ("Hardware performance counters for the process routine (counts are per sample per channel)");
+        addAndMakeVisible (lblC);
         for (auto v = 0; v < static_cast<int> (values.size()); ++v)
         {
             auto* lblVT = valueTitleLabels.add (new Label ("", values[v]));
@@ -133,10 +148,312 @@ BenchmarkComponent::BenchmarkComponent (ProcessorHarness* processorHarnessA,
     cmbIterations.setSelectedId (config->getIntAttribute ("ProcessIterations", 1000));
     addAndMakeVisible (cmbIterations);
 
+    lblTimer.setText ("Timer", dontSendNotification);
+    lblTimer.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblTimer);
+    cmbTimer.setTooltip ("Clock used to time the routines (the overhead of reading the clock is calibrated and subtracted from the results)");
+    for (const auto source : { BenchmarkTimer::Source::juceHighResolution, BenchmarkTimer::Source::tsc, BenchmarkTimer::Source::monotonicRaw })
+        if (BenchmarkTimer::isSourceAvailable (source))
+            cmbTimer.addItem (BenchmarkTimer::getSourceName (source), static_cast<int> (source));
+    cmbTimer.onChange = [this] { benchmarkThread.setTimingSource (static_cast<BenchmarkTimer::Source> (cmbTimer.getSelectedId())); };
+    cmbTimer.setSelectedId (config->getIntAttribute ("TimingSource", static_cast<int> (BenchmarkTimer::Source::juceHighResolution)));
+    if (cmbTimer.getSelectedId() == 0)
+        cmbTimer.setSelectedId (static_cast<int> (BenchmarkTimer::Source::juceHighResolution));
+    addAndMakeVisible (cmbTimer);
+
+    lblCounters.setText ("HW counters", dontSendNotification);
+    lblCounters.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblCounters);
+    btnCounters.setTooltip ("Count cycles, instructions, cache misses & branch misses around the processing iterations using perf_event_open (Linux only). "
+                            "The counters are read once per batch of iterations, so progress is updated less often while they are enabled.");
+    btnCounters.onClick = [this] { benchmarkThread.setPerformanceCountersEnabled (btnCounters.getToggleState()); };
+    btnCounters.setEnabled (PerformanceCounters::isSupported());
+    btnCounters.setToggleState (PerformanceCounters::isSupported() && config->getBoolAttribute ("PerformanceCounters", false), sendNotificationSync);
+    addAndMakeVisible (btnCounters);
+
+    lblMode.setText ("Mode", dontSendNotification);
+    lblMode.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblMode);
+    cmbMode.setTooltip ("Run the tests against the selected spec, sweep over a grid of block sizes, channel counts & sample rates, "
+                        "compare A & B by interleaving batches of process iterations, run concurrent instances of each processor on separate cores, "
+                        "run with warm caches & then cold caches, run with the buffers at a range of alignments, "
+                        "feed a signal decaying to silence with & without FTZ/DAZ to show any denormal slowdown, "
+                        "feed blocks of varying size as hosts do to show the fixed cost of each process call, "
+                        "change the controls while processing to show the cost of automation, "
+                        "step the controls across their range to find the worst case setting, "
+                        "or feed a set of input signals to show any signal dependent cost "
+                        "(these results are shown in a separate report)");
+    cmbMode.addItem ("Single spec", static_cast<int> (Mode::singleSpec));
+    cmbMode.addItem ("Sweep", static_cast<int> (Mode::sweep));
+    cmbMode.addItem ("Compare A/B", static_cast<int> (Mode::compare));
+    cmbMode.addItem ("Multi-instance", static_cast<int> (Mode::multiInstance));
+    cmbMode.addItem ("Cold vs warm cache", static_cast<int> (Mode::coldWarm));
+    cmbMode.addItem ("Alignment sweep", static_cast<int> (Mode::alignmentSweep));
+    cmbMode.addItem ("Denormals", static_cast<int> (Mode::denormals));
+    cmbMode.addItem ("Block size patterns", static_cast<int> (Mode::blockPatterns));
+    cmbMode.addItem ("Automation", static_cast<int> (Mode::automation));
+    cmbMode.addItem ("Control sweep", static_cast<int> (Mode::controlSweep));
+    cmbMode.addItem ("Stimuli", static_cast<int> (Mode::stimuli));
+    cmbMode.onChange = [this]
+    {
+        const auto isSweep = cmbMode.getSelectedId() == static_cast<int> (Mode::sweep);
+        txtSweepBlockSizes.setEnabled (isSweep);
+        txtSweepChannels.setEnabled (isSweep);
+        txtSweepSampleRates.setEnabled (isSweep);
+        const auto isAlignmentSweep = cmbMode.getSelectedId() == static_cast<int> (Mode::alignmentSweep);
+        txtAlignmentOffsets.setEnabled (isAlignmentSweep);
+        txtChannelPaddings.setEnabled (isAlignmentSweep);
+        cmbPrecision.setEnabled (cmbMode.getSelectedId() == static_cast<int> (Mode::compare));
+        const auto isControlSweep = cmbMode.getSelectedId() == static_cast<int> (Mode::controlSweep);
+        cmbControlSteps.setEnabled (isControlSweep);
+        txtControlPair.setEnabled (isControlSweep);
+        txtStimuli.setEnabled (cmbMode.getSelectedId() == static_cast<int> (Mode::stimuli));
+    };
+    lblPrecision.setText ("Compare precision", dontSendNotification);
+    lblPrecision.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblPrecision);
+    cmbPrecision.setTooltip ("The A/B comparison runs rounds of 'Process iterations' calls of each processor until the confidence interval "
+                             "of the B/A time ratio is this narrow (or 500 rounds have been run)");
+    cmbPrecision.addItem (CharPointer_UTF8 ("\xc2\xb1 0.5%"), 5);
+    cmbPrecision.addItem (CharPointer_UTF8 ("\xc2\xb1 1%"), 10);
+    cmbPrecision.addItem (CharPointer_UTF8 ("\xc2\xb1 2%"), 20);
+    cmbPrecision.addItem (CharPointer_UTF8 ("\xc2\xb1 5%"), 50);
+    cmbPrecision.onChange = [this] { benchmarkThread.setComparisonPrecision (cmbPrecision.getSelectedId() / 1000.0); };
+    cmbPrecision.setSelectedId (config->getIntAttribute ("ComparePrecision", 10));
+    addAndMakeVisible (cmbPrecision);
+
+    lblControlSteps.setText ("Control steps", dontSendNotification);
+    lblControlSteps.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblControlSteps);
+    cmbControlSteps.setTooltip ("Number of values from 0 to 1 to step each control through in control sweep mode (a pair of controls is run at every combination of values)");
+    cmbControlSteps.addItem ("5", 5);
+    cmbControlSteps.addItem ("11", 11);
+    cmbControlSteps.addItem ("21", 21);
+    cmbControlSteps.setSelectedId (config->getIntAttribute ("ControlSteps", 11));
+    if (cmbControlSteps.getSelectedId() == 0)
+        cmbControlSteps.setSelectedId (11);
+    addAndMakeVisible (cmbControlSteps);
+
+    lblCache.setText ("Cache", dontSendNotification);
+    lblCache.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblCache);
+    cmbCache.setTooltip ("Warm reuses the same block & processor state every iteration, so everything stays cached. The cold states evict the data caches "
+                         "(and optionally pollute the instruction cache) before every process call, as other plugins would in a DAW. "
+                         "This applies to the single spec & sweep modes, and selects the cold state for the cold vs warm mode. Cold runs are much slower.");
+    cmbCache.addItem ("Warm", static_cast<int> (BenchmarkRunner::CacheState::warm));
+    cmbCache.addItem ("Cold (evict data)", static_cast<int> (BenchmarkRunner::CacheState::cold));
+    cmbCache.addItem ("Cold (evict data & code)", static_cast<int> (BenchmarkRunner::CacheState::coldWithInstructionCache));
+    cmbCache.onChange = [this] { benchmarkThread.setCacheState (static_cast<BenchmarkRunner::CacheState> (cmbCache.getSelectedId())); };
+    cmbCache.setSelectedId (config->getIntAttribute ("CacheState", static_cast<int> (BenchmarkRunner::CacheState::warm)));
+    if (cmbCache.getSelectedId() == 0)
+        cmbCache.setSelectedId (static_cast<int> (BenchmarkRunner::CacheState::warm));
+    addAndMakeVisible (cmbCache);
+
+    lblRealtimeGuard.setText ("RT guard", dontSendNotification);
+    lblRealtimeGuard.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblRealtimeGuard);
+    cmbRealtimeGuard.setTooltip ("Count the memory allocations & blocking locks made by the process & reset routines (which aren't real-time safe), "
+                                 "optionally capturing their stack traces. Only operator new & delete are intercepted "
+                                 "on platforms other than Linux. This also applies to the live audio path while enabled. "
+                                 "The guard needs a build with DSP_TESTBENCH_RT_GUARD=1, as it replaces the global allocation functions.");
+    cmbRealtimeGuard.addItem ("Off", static_cast<int> (GuardSetting::off));
+    cmbRealtimeGuard.addItem ("Count", static_cast<int> (GuardSetting::count));
+    cmbRealtimeGuard.addItem ("Count & stack traces", static_cast<int> (GuardSetting::countWithStackTraces));
+    cmbRealtimeGuard.onChange = [this]
+    {
+        const auto setting = static_cast<GuardSetting> (cmbRealtimeGuard.getSelectedId());
+        for (auto* h : harnesses)
+            if (h) h->setRealtimeGuardEnabled (setting != GuardSetting::off, setting == GuardSetting::countWithStackTraces);
+    };
+    cmbRealtimeGuard.setSelectedId (config->getIntAttribute ("RealtimeGuard", static_cast<int> (GuardSetting::off)));
+    if (cmbRealtimeGuard.getSelectedId() == 0)
+        cmbRealtimeGuard.setSelectedId (static_cast<int> (GuardSetting::off));
+    if (!RealtimeGuard::isCompiledIn())
+    {
+        cmbRealtimeGuard.setSelectedId (static_cast<int> (GuardSetting::off));
+        cmbRealtimeGuard.setEnabled (false);
+    }
+    addAndMakeVisible (cmbRealtimeGuard);
+
+    const auto updateIsolation = [this]
+    {
+        benchmarkThread.setIsolation (cmbCpu.getSelectedId() - 2, static_cast<BenchmarkIsolation::Scheduling> (cmbScheduling.getSelectedId()), btnLockMemory.getToggleState());
+    };
+
+    lblCpu.setText ("Benchmark CPU", dontSendNotification);
+    lblCpu.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblCpu);
+    cmbCpu.setTooltip ("Pin the benchmark thread to one CPU, so it isn't migrated between cores during a run (Linux & Windows only). "
+                       "Choose a CPU with as little else running on it as possible (e.g. one isolated with isolcpus).");
+    cmbCpu.addItem ("Any", 1);
+    for (auto c = 0; c < SystemStats::getNumCpus(); ++c)
+        cmbCpu.addItem ("CPU " + String (c), c + 2);
+    cmbCpu.onChange = updateIsolation;
+    cmbCpu.setSelectedId (config->getIntAttribute ("BenchmarkCpu", 1));
+    if (cmbCpu.getSelectedId() == 0)
+        cmbCpu.setSelectedId (1);
+    addAndMakeVisible (cmbCpu);
+
+    lblScheduling.setText ("Scheduling", dontSendNotification);
+    lblScheduling.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblScheduling);
+    cmbScheduling.setTooltip ("Run the benchmark thread with a real-time scheduling policy (priority " + String (BenchmarkIsolation::defaultPriority)
+                              + "), so it isn't preempted by other threads (Linux & macOS only, needs CAP_SYS_NICE or an rtprio limit on Linux)");
+    for (const auto policy : { BenchmarkIsolation::Scheduling::normal, BenchmarkIsolation::Scheduling::fifo, BenchmarkIsolation::Scheduling::roundRobin })
+        cmbScheduling.addItem (BenchmarkIsolation::getSchedulingName (policy), static_cast<int> (policy));
+    cmbScheduling.onChange = updateIsolation;
+    cmbScheduling.setSelectedId (config->getIntAttribute ("Scheduling", static_cast<int> (BenchmarkIsolation::Scheduling::normal)));
+    if (cmbScheduling.getSelectedId() == 0)
+        cmbScheduling.setSelectedId (static_cast<int> (BenchmarkIsolation::Scheduling::normal));
+    addAndMakeVisible (cmbScheduling);
+
+    lblLockMemory.setText ("Lock memory", dontSendNotification);
+    lblLockMemory.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblLockMemory);
+    btnLockMemory.setTooltip ("Lock the process memory into RAM during a run, so the benchmark can't page fault (Linux only, needs a large enough memlock limit)");
+    btnLockMemory.onClick = updateIsolation;
+    btnLockMemory.setToggleState (config->getBoolAttribute ("LockMemory", false), sendNotificationSync);
+    addAndMakeVisible (btnLockMemory);
+
+    lblResourceUsage.setText ("Resource usage", dontSendNotification);
+    lblResourceUsage.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblResourceUsage);
+    btnResourceUsage.setTooltip ("Count the page faults, context switches & peak RSS growth of each call of prepare, process & reset using getrusage "
+                                 "(Linux & macOS). This adds a system call either side of each call, outside of the timed region.");
+    btnResourceUsage.onClick = [this]
+    {
+        for (auto* h : harnesses)
+            if (h) h->setResourceUsageEnabled (btnResourceUsage.getToggleState());
+    };
+    btnResourceUsage.setEnabled (ResourceUsage::isSupported());
+    btnResourceUsage.setToggleState (ResourceUsage::isSupported() && config->getBoolAttribute ("ResourceUsage", false), sendNotificationSync);
+    addAndMakeVisible (btnResourceUsage);
+
+    lblWarmup.setText ("Warm-up", dontSendNotification);
+    lblWarmup.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblWarmup);
+    cmbWarmup.setTooltip ("Process calls after each prepare which are left out of the statistics & reported on their own (auto ends the warm-up once "
+                          + String (IterationClassifier::autoWarmupStableCalls) + " calls in a row are close to the fastest). Process calls slower than "
+                          + String (IterationClassifier::defaultOutlierFactor, 0) + "x the median are reported as outliers with their cycle & call index.");
+    cmbWarmup.addItem ("None", 1);
+    cmbWarmup.addItem ("Auto", 2);
+    cmbWarmup.addItem ("10 calls", 3);
+    cmbWarmup.addItem ("100 calls", 4);
+    cmbWarmup.onChange = [this]
+    {
+        const std::array<int, 4> warmups { 0, IterationClassifier::autoWarmup, 10, 100 };
+        const auto warmup = warmups[static_cast<size_t> (jlimit (1, 4, cmbWarmup.getSelectedId()) - 1)];
+        for (auto* h : harnesses)
+            if (h) h->setWarmup (warmup);
+    };
+    cmbWarmup.setSelectedId (config->getIntAttribute ("Warmup", 1));
+    if (cmbWarmup.getSelectedId() == 0)
+        cmbWarmup.setSelectedId (1);
+    addAndMakeVisible (cmbWarmup);
+
+    lblSections.setText ("Sections", dontSendNotification);
+    lblSections.setJustificationType (Justification::centredRight);
+    addAndMakeVisible (lblSections);
+    btnSections.setTooltip ("Time the sections marked with DSP_TESTBENCH_SECTION in the processors' process methods & show the breakdown after a "
+                            "single spec run. Each section adds a timer read at either end, which is included in the process time.");
+    btnSections.onClick = [this]
+    {
+        for (auto* h : harnesses)
+            if (h) h->setSectionProfilingEnabled (btnSections.getToggleState());
+    };
+    btnSections.setEnabled (SectionProfiler::isCompiledIn());
+    btnSections.setToggleState (SectionProfiler::isCompiledIn() && config->getBoolAttribute ("SectionProfiling", false), sendNotificationSync);
+    addAndMakeVisible (btnSections);
+
+    cmbMode.setSelectedId (config->getIntAttribute ("Mode", static_cast<int> (Mode::singleSpec)));
+    if (cmbMode.getSelectedId() == 0)
+        cmbMode.setSelectedId (static_cast<int> (Mode::singleSpec));
+    addAndMakeVisible (cmbMode);
+
+    const auto initSweepEditor = [this] (Label& label, const String& labelText, TextEditor& editor, const String& tooltip, const String& configKey, const String& defaultList,
+                                         const Mode editorMode = Mode::sweep)
+    {
+        label.setText (labelText, dontSendNotification);
+        label.setJustificationType (Justification::centredRight);
+        addAndMakeVisible (label);
+        editor.setTooltip (tooltip);
+        editor.setText (config->getStringAttribute (configKey, defaultList), false);
+        editor.setEnabled (cmbMode.getSelectedId() == static_cast<int> (editorMode));
+        addAndMakeVisible (editor);
+    };
+    initSweepEditor (lblSweepBlockSizes, "Sweep block sizes", txtSweepBlockSizes, "Comma separated block sizes to sweep over (e.g. 16 to 8192)",
+                     "SweepBlockSizes", "16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192");
+    initSweepEditor (lblSweepChannels, "Sweep channels", txtSweepChannels, "Comma separated channel counts to sweep over (e.g. 1 to 64)",
+                     "SweepChannels", "1, 2, 8, 64");
+    initSweepEditor (lblSweepSampleRates, "Sweep sample rates", txtSweepSampleRates, "Comma separated sample rates to sweep over (e.g. 44100 to 384000)",
+                     "SweepSampleRates", "44100, 96000, 384000");
+    initSweepEditor (lblAlignmentOffsets, "Buffer offsets", txtAlignmentOffsets, "Comma separated byte offsets of the channel buffers from a 64 byte boundary "
+                     "(multiples of 4, less than 64)", "AlignmentOffsets", "0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60", Mode::alignmentSweep);
+    initSweepEditor (lblChannelPaddings, "Channel paddings", txtChannelPaddings, "Comma separated extra bytes between channels (multiples of 4). "
+                     "0 keeps channels a whole number of cache lines apart, which can alias in the cache for power of 2 block sizes", "ChannelPaddings", "0, 4, 64",
+                     Mode::alignmentSweep);
+    initSweepEditor (lblControlPair, "Swept controls", txtControlPair, "Leave empty to sweep each control on its own (with the others at their defaults), "
+                     "enter one control index (from 0) to sweep just that control, or two indexes to sweep a pair of controls together", "ControlPair", String(),
+                     Mode::controlSweep);
+    cmbControlSteps.setEnabled (cmbMode.getSelectedId() == static_cast<int> (Mode::controlSweep));
+    initSweepEditor (lblStimuli, "Stimuli", txtStimuli, "Comma separated input signals to feed each processor in stimuli mode: "
+                     "silence, sine, white, pink, impulses, denormal, nan-inf & changing (a slowly changing sine, which the others are compared against)",
+                     "Stimuli", "silence, sine, white, pink, impulses, denormal, nan-inf, changing", Mode::stimuli);
+
     btnStart.setButtonText ("Start tests");
     btnStart.setColour (TextButton::buttonColourId, Colours::green);
     btnStart.onClick = [this]
     {
+        const auto mode = static_cast<Mode> (cmbMode.getSelectedId());
+        if (mode == Mode::sweep)
+        {
+            const auto blockSizes = BenchmarkSweep::parseIntList (txtSweepBlockSizes.getText());
+            const auto channelCounts = BenchmarkSweep::parseIntList (txtSweepChannels.getText());
+            const auto sampleRates = BenchmarkSweep::parseDoubleList (txtSweepSampleRates.getText());
+            if (blockSizes.isEmpty() || channelCounts.isEmpty() || sampleRates.isEmpty())
+            {
+                AlertWindow::showMessageBoxAsync (AlertWindow::AlertIconType::WarningIcon, "Invalid sweep", "Please enter at least one block size, channel count and sample rate to sweep over.");
+                return;
+            }
+            benchmarkThread.setSweepGrid (blockSizes, channelCounts, sampleRates);
+        }
+        else if (mode == Mode::alignmentSweep)
+        {
+            const auto byteOffsets = BenchmarkSweep::parseIntList (txtAlignmentOffsets.getText(), 0);
+            const auto channelPaddings = BenchmarkSweep::parseIntList (txtChannelPaddings.getText(), 0);
+            if (!benchmarkThread.setAlignmentSweep (byteOffsets, channelPaddings))
+            {
+                AlertWindow::showMessageBoxAsync (AlertWindow::AlertIconType::WarningIcon, "Invalid alignment sweep", "Please enter at least one buffer offset (a multiple of 4 below 64) and channel padding (a multiple of 4) to sweep over.");
+                return;
+            }
+        }
+        else if (mode == Mode::controlSweep)
+        {
+            const auto controls = BenchmarkSweep::parseIntList (txtControlPair.getText(), 0);
+            if (controls.size() > 2)
+            {
+                AlertWindow::showMessageBoxAsync (AlertWindow::AlertIconType::WarningIcon, "Invalid control sweep", "Please enter no more than two control indexes to sweep.");
+                return;
+            }
+            benchmarkThread.setControlSweep (cmbControlSteps.getSelectedId(), controls.isEmpty() ? -1 : controls[0], controls.size() < 2 ? -1 : controls[1]);
+        }
+        else if (mode == Mode::stimuli)
+        {
+            const auto stimuliToRun = BenchmarkStimuli::parseStimuli (txtStimuli.getText());
+            if (stimuliToRun.empty())
+            {
+                AlertWindow::showMessageBoxAsync (AlertWindow::AlertIconType::WarningIcon, "Invalid stimuli", "Please enter at least one of silence, sine, white, pink, impulses, denormal, nan-inf or changing.");
+                return;
+            }
+            benchmarkThread.setStimuli (stimuliToRun);
+        }
+        else if (mode == Mode::compare && (harnesses[0] == nullptr || harnesses[1] == nullptr))
+        {
+            AlertWindow::showMessageBoxAsync (AlertWindow::AlertIconType::WarningIcon, "Unable to compare", "Both processor A and processor B are needed for an A/B comparison.");
+            return;
+        }
+        benchmarkThread.setMode (mode);
+
         // Start running benchmarks on a different thread
         benchmarkThread.setProcessSpec (spec);
         benchmarkThread.startRealtimeThread (Thread::RealtimeOptions());
@@ -149,6 +466,7 @@ BenchmarkComponent::BenchmarkComponent (ProcessorHarness* processorHarnessA,
         for (auto h : harnesses)
             if (h) h->resetStatistics();
         lblBufferAlignmentStatus.setText (String(), sendNotificationSync);
+        performanceCountersStatus.clear();
     };
     addAndMakeVisible (btnReset);
 
@@ -156,7 +474,7 @@ BenchmarkComponent::BenchmarkComponent (ProcessorHarness* processorHarnessA,
     lblBufferAlignmentStatus.setColour (Label::textColourId, Colours::lightgrey);
     addAndMakeVisible (lblBufferAlignmentStatus);
 
-    setSize (690, 430);
+    setSize (930, 810);
     startTimerHz (5);
 }
 BenchmarkComponent::~BenchmarkComponent()
@@ -170,6 +488,26 @@ BenchmarkComponent::~BenchmarkComponent()
     config->setAttribute ("SampleRate", cmbSampleRate.getSelectedId());
     config->setAttribute ("TestCycles", cmbCycles.getSelectedId());
     config->setAttribute ("ProcessIterations", cmbIterations.getSelectedId());
+    config->setAttribute ("TimingSource", cmbTimer.getSelectedId());
+    config->setAttribute ("PerformanceCounters", btnCounters.getToggleState());
+    config->setAttribute ("Mode", cmbMode.getSelectedId());
+    config->setAttribute ("SweepBlockSizes", txtSweepBlockSizes.getText());
+    config->setAttribute ("SweepChannels", txtSweepChannels.getText());
+    config->setAttribute ("SweepSampleRates", txtSweepSampleRates.getText());
+    config->setAttribute ("ComparePrecision", cmbPrecision.getSelectedId());
+    config->setAttribute ("CacheState", cmbCache.getSelectedId());
+    config->setAttribute ("RealtimeGuard", cmbRealtimeGuard.getSelectedId());
+    config->setAttribute ("AlignmentOffsets", txtAlignmentOffsets.getText());
+    config->setAttribute ("ChannelPaddings", txtChannelPaddings.getText());
+    config->setAttribute ("ControlSteps", cmbControlSteps.getSelectedId());
+    config->setAttribute ("ControlPair", txtControlPair.getText());
+    config->setAttribute ("Stimuli", txtStimuli.getText());
+    config->setAttribute ("BenchmarkCpu", cmbCpu.getSelectedId());
+    config->setAttribute ("Scheduling", cmbScheduling.getSelectedId());
+    config->setAttribute ("LockMemory", btnLockMemory.getToggleState());
+    config->setAttribute ("ResourceUsage", btnResourceUsage.getToggleState());
+    config->setAttribute ("Warmup", cmbWarmup.getSelectedId());
+    config->setAttribute ("SectionProfiling", btnSections.getToggleState());
     
     // Save configuration to application properties
     auto* propertiesFile = DSPTestbenchApplication::getApp().appProperties.getUserSettings();
@@ -186,10 +524,13 @@ void BenchmarkComponent::resized()
 
     const auto titleRowHeight = Grid::Px (titleFont.getHeight() * 1.15f);
     const auto valueRowHeight = Grid::Px (normalFont.getHeight() * 1.25f);
-    const auto titleColumnWidth = GUI_SIZE_PX (5.0);
-    const auto valueColumnWidth = GUI_SIZE_PX (3.7);
+    const auto titleColumnWidth = GUI_SIZE_PX (4.0);
+    const auto valueColumnWidth = GUI_SIZE_PX (2.5);
     const auto gap = GUI_BASE_GAP_PX;
 
+    const auto numRoutines = static_cast<int> (routines.size());
+    const auto numValues = static_cast<int> (values.size());
+
     Grid resultsGrid;
     resultsGrid.rowGap = gap;
     resultsGrid.columnGap = gap;
@@ -199,65 +540,51 @@ void BenchmarkComponent::resized()
         Track (valueRowHeight),     // row  3 is for processor A prepare routine results
         Track (valueRowHeight),     // row  4 is for processor A processing routine results
         Track (valueRowHeight),     // row  5 is for processor A reset routine results
-        Track (GUI_GAP_PX (2)),     // row  6 is the blank row between processors
-        Track (titleRowHeight),     // row  7 is for processor B title and value column titles
-        Track (valueRowHeight),     // row  8 is for processor B prepare routine results
-        Track (valueRowHeight),     // row  9 is for processor B processing routine results
-        Track (valueRowHeight),     // row 10 is for processor B reset routine results
-        Track (1_fr)                // row 11 is for centering
+        Track (valueRowHeight),     // row  6 is for processor A real-time budget
+        Track (valueRowHeight),     // row  7 is for processor A performance counters
+        Track (GUI_GAP_PX (2)),     // row  8 is the blank row between processors
+        Track (titleRowHeight),     // row  9 is for processor B title and value column titles
+        Track (valueRowHeight),     // row 10 is for processor B prepare routine results
+        Track (valueRowHeight),     // row 11 is for processor B processing routine results
+        Track (valueRowHeight),     // row 12 is for processor B reset routine results
+        Track (valueRowHeight),     // row 13 is for processor B real-time budget
+        Track (valueRowHeight),     // row 14 is for processor B performance counters
+        Track (1_fr)                // row 15 is for centering
     };
-    resultsGrid.templateColumns = {
-        Track (1_fr),               // column 1 is for centering 
-        Track (titleColumnWidth),   // column 2 is for titles
-        Track (valueColumnWidth),   // column 3 is for min values
-        Track (valueColumnWidth),   // column 4 is for avg values
-        Track (valueColumnWidth),   // column 5 is for max values
-        Track (valueColumnWidth),   // column 6 is for sample counts
-        Track (1_fr)                // column 7 is for centering
-    };
-    resultsGrid.items.addArray({
 
-        GridItem().withArea (1, 1),
+    // Column 1 is for centering, column 2 is for titles, then one column per value, then a final column for centering
+    resultsGrid.templateColumns = { Track (1_fr), Track (titleColumnWidth) };
+    for (auto v = 0; v < numValues; ++v)
+        resultsGrid.templateColumns.add (Track (valueColumnWidth));
+    resultsGrid.templateColumns.add (Track (1_fr));
 
-        GridItem (processorLabels[0]).withArea (2, 2),
-        GridItem (valueTitleLabels[0]).withArea (2, 3),
-        GridItem (valueTitleLabels[1]).withArea (2, 4),
-        GridItem (valueTitleLabels[2]).withArea (2, 5),
-        GridItem (valueTitleLabels[3]).withArea (2, 6),
-        GridItem (routineLabels[0]).withArea (3, 2),
-        GridItem (routineLabels[1]).withArea (4, 2),
-        GridItem (routineLabels[2]).withArea (5, 2),
-
-        GridItem().withArea (6, 1),
-
-        GridItem (processorLabels[1]).withArea (7, 2),
-        GridItem (valueTitleLabels[4]).withArea (7, 3),
-        GridItem (valueTitleLabels[5]).withArea (7, 4),
-        GridItem (valueTitleLabels[6]).withArea (7, 5),
-        GridItem (valueTitleLabels[7]).withArea (7, 6),
-        GridItem (routineLabels[3]).withArea (8, 2),
-        GridItem (routineLabels[4]).withArea ( 9, 2),
-        GridItem (routineLabels[5]).withArea (10, 2),
-        
-        GridItem().withArea (11, 7)
+    resultsGrid.items.addArray ({
+        GridItem().withArea (1, 1),
+        GridItem().withArea (8, 1),
+        GridItem().withArea (15, numValues + 3)
     });
 
-    const auto numRoutines = static_cast<int> (routines.size());
-    const auto numValues = static_cast<int> (values.size());
-
     for (auto p = 0; p < static_cast<int> (processors.size()); ++p)
     {
-        const auto offsetP = p * (numRoutines + 2) + 3;
+        const auto titleRow = p * (numRoutines + 4) + 2;
+        resultsGrid.items.add (GridItem (processorLabels[p]).withArea (titleRow, 2));
+        for (auto v = 0; v < numValues; ++v)
+            resultsGrid.items.add (GridItem (valueTitleLabels[p * numValues + v]).withArea (titleRow, v + 3));
+
         for (auto r = 0; r < numRoutines; ++r)
         {
+            const auto row = titleRow + 1 + r;
+            resultsGrid.items.add (GridItem (routineLabels[p * numRoutines + r]).withArea (row, 2));
             for (auto v = 0; v < numValues; ++v)
             {
                 const auto idxLabel = getValueLabelIndex (p, r, v);
-                const auto row = offsetP + r;
                 const auto col = v + 3;
                 resultsGrid.items.add (GridItem (valueLabels[idxLabel]).withArea (row, col));
             }
         }
+        const auto budgetRow = titleRow + numRoutines + 1;
+        resultsGrid.items.add (GridItem (budgetLabels[p]).withArea (budgetRow, 2, budgetRow + 1, numValues + 3));
+        resultsGrid.items.add (GridItem (counterLabels[p]).withArea (budgetRow + 1, 2, budgetRow + 2, numValues + 3));
     }
     
     const auto controlColumnWidth = GUI_SIZE_PX (4.2);
@@ -267,6 +594,16 @@ void BenchmarkComponent::resized()
     controlsGrid.rowGap = gap;
     controlsGrid.columnGap = gap;
     controlsGrid.templateRows = {
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
+        Track (controlRowHeight),
         Track (controlRowHeight),
         Track (controlRowHeight),
         Track (controlRowHeight),
@@ -282,16 +619,26 @@ void BenchmarkComponent::resized()
         Track (1_fr)                // centering
     };
     controlsGrid.items.addArray({
-        GridItem().withArea (1, 1, 6, 1),
-        GridItem().withArea (1, 7, 6, 7),
+        GridItem().withArea (1, 1, 16, 1),
+        GridItem().withArea (1, 7, 16, 7),
         GridItem (lblBlockSize),    GridItem (cmbBlockSize),    GridItem(),     GridItem (lblCycles),       GridItem (cmbCycles),
         GridItem (lblChannels),     GridItem (cmbChannels),     GridItem(),     GridItem (lblIterations),   GridItem (cmbIterations),
-        GridItem (lblSampleRate),   GridItem (cmbSampleRate),   GridItem(),     GridItem(),                 GridItem(),
+        GridItem (lblSampleRate),   GridItem (cmbSampleRate),   GridItem(),     GridItem (lblTimer),        GridItem (cmbTimer),
+        GridItem (lblMode),         GridItem (cmbMode),         GridItem(),     GridItem (lblCounters),     GridItem (btnCounters),
+        GridItem (lblSweepBlockSizes),  GridItem (txtSweepBlockSizes),  GridItem(),     GridItem (lblSweepChannels),    GridItem (txtSweepChannels),
+        GridItem (lblSweepSampleRates), GridItem (txtSweepSampleRates), GridItem(),     GridItem (lblPrecision),        GridItem (cmbPrecision),
+        GridItem (lblAlignmentOffsets), GridItem (txtAlignmentOffsets), GridItem(),     GridItem (lblChannelPaddings),  GridItem (txtChannelPaddings),
+        GridItem (lblControlSteps),     GridItem (cmbControlSteps),     GridItem(),     GridItem (lblControlPair),      GridItem (txtControlPair),
+        GridItem (lblStimuli),          GridItem (txtStimuli),          GridItem(),     GridItem (lblLockMemory),       GridItem (btnLockMemory),
+        GridItem (lblCpu),              GridItem (cmbCpu),              GridItem(),     GridItem (lblScheduling),       GridItem (cmbScheduling),
+        GridItem (lblCache),        GridItem (cmbCache),        GridItem(),     GridItem (lblRealtimeGuard),    GridItem (cmbRealtimeGuard),
+        GridItem (lblResourceUsage),    GridItem (btnResourceUsage),    GridItem(),     GridItem (lblWarmup),           GridItem (cmbWarmup),
+        GridItem (lblSections),         GridItem (btnSections),         GridItem(),     GridItem(),                     GridItem(),
         GridItem (lblBufferAlignmentStatus).withArea ({}, GridItem::Span (2)),  GridItem(), GridItem (btnStart), GridItem (btnReset)
     });
 
-    resultsGrid.performLayout (getLocalBounds().withHeight (290));
-    controlsGrid.performLayout (getLocalBounds().withTrimmedTop (290));
+    resultsGrid.performLayout (getLocalBounds().withHeight (370));
+    controlsGrid.performLayout (getLocalBounds().withTrimmedTop (370));
 }
 void BenchmarkComponent::timerCallback()
 {
@@ -320,11 +667,33 @@ void BenchmarkComponent::timerCallback()
                         case 3: if (queryValue > 0.0)
                                     txt = String (static_cast<int> (queryValue));
                                 break;
-                        default: break;
+                        default: if (isfinite (queryValue))
+                                    txt = String (queryValue * 1000.0, 1);
+                                break;
                     }
                     valueLabels[idxLabel]->setText (txt, sendNotificationAsync);
                 }
             }
+
+            const auto budget = RealtimeBudget::forProcessing (*harness);
+            auto hasViolations = false;
+            for (const auto r : { 1, 2 })
+                if (const auto* violations = harness->getRealtimeViolations (r))
+                    hasViolations = hasViolations || violations->getTotal() > 0;
+            const auto classifierText = harness->getIterationClassifier().getSummaryText (harness->queryProcessingDurationPercentile (50.0));
+            budgetLabels[p]->setText ((budget.isValid() ? getRealtimeBudgetText (budget) : String ("-")) + getRealtimeViolationsText (*harness)
+                                      + (classifierText.isNotEmpty() ? "    " + classifierText : String()), sendNotificationAsync);
+            budgetLabels[p]->setColour (Label::textColourId, (budget.isValid() && budget.deadlineMisses > 0.0) || hasViolations ? Colours::orange : DspTestBenchLnF::ApplicationColours::normalFontColour());
+
+            // Any counters which couldn't be opened are listed in the tooltip
+            const auto& totals = harness->getPerformanceCounterTotals();
+            counterLabels[p]->setTooltip (totals.numSamples > 0.0 ? performanceCountersStatus : String());
+            if (totals.numSamples > 0.0)
+                counterLabels[p]->setText (getPerformanceCountersText (totals) + getResourceUsageText (*harness), sendNotificationAsync);
+            else if (performanceCountersStatus.isNotEmpty())
+                counterLabels[p]->setText (performanceCountersStatus + getResourceUsageText (*harness), sendNotificationAsync);
+            else
+                counterLabels[p]->setText ("-" + getResourceUsageText (*harness), sendNotificationAsync);
         }
     }
 }
@@ -332,11 +701,338 @@ void BenchmarkComponent::setBufferAlignmentStatus (const String& status)
 {
     lblBufferAlignmentStatus.setText (status, sendNotificationSync);
 }
+void BenchmarkComponent::setPerformanceCountersStatus (const String& status)
+{
+    performanceCountersStatus = status;
+}
+void BenchmarkComponent::setEnvironment (const BenchmarkEnvironment& runEnvironment)
+{
+    // The status shows the environment as a tooltip, highlighted if it was unstable
+    environment = runEnvironment;
+    lblBufferAlignmentStatus.setTooltip (environment.getSummaryText().trim());
+    lblBufferAlignmentStatus.setColour (Label::textColourId, environment.getWarnings().isEmpty() ? Colours::lightgrey : Colours::orange);
+}
+void BenchmarkComponent::showSweepReport (const BenchmarkSweep& sweep)
+{
+    // Plot the average cost against block size, with a line for each processor, channel count & sample rate
+    std::vector<BenchmarkPlot::Series> series;
+    const auto& processorNames = sweep.getProcessorNames();
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        for (const auto sampleRate : sweep.getSampleRates())
+        {
+            for (const auto numChannels : sweep.getChannelCounts())
+            {
+                BenchmarkPlot::Series s;
+                s.name << BenchmarkRunner::getSlotName (h) << " " << numChannels << "ch " << String (sampleRate / 1000.0, 1) << "k";
+                for (const auto& cell : sweep.getCells())
+                    if (cell.spec.sampleRate == sampleRate && static_cast<int> (cell.spec.numChannels) == numChannels)
+                        s.points.emplace_back (static_cast<double> (cell.spec.maximumBlockSize), cell.costs[static_cast<size_t> (h)].avg);
+                series.push_back (s);
+            }
+        }
+    }
+
+    auto* report = new BenchmarkReportComponent();
+    report->getPlot().setXAxis ("Block size", true);
+    report->getPlot().setYAxis ("Average ns per sample per channel");
+    report->setPlotSeries (series);
+    report->setReportText (sweep.getResultsAsText());
+    report->setExportData (sweep.getResultsAsCsv(), sweep.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Benchmark sweep results", report, this);
+}
+void BenchmarkComponent::showComparisonReport (const BenchmarkComparison& comparison)
+{
+    // Plot the average time per call of each round, which also shows any drift over the run
+    std::vector<BenchmarkPlot::Series> series (2);
+    series[0].name = "A";
+    series[1].name = "B";
+    for (size_t i = 0; i < comparison.getRoundsA().size(); ++i)
+    {
+        series[0].points.emplace_back (static_cast<double> (i + 1), comparison.getRoundsA()[i] * 1000.0);
+        series[1].points.emplace_back (static_cast<double> (i + 1), comparison.getRoundsB()[i] * 1000.0);
+    }
+
+    auto* report = new BenchmarkReportComponent();
+    report->getPlot().setXAxis ("Round", false);
+    report->getPlot().setYAxis ("Average time per call (us)");
+    report->setPlotSeries (series);
+    report->setReportText (comparison.getResultAsText());
+    report->setExportData (comparison.getRoundsAsCsv(), comparison.getResultAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("A/B comparison results", report, this);
+}
+void BenchmarkComponent::showMultiInstanceReport (const BenchmarkMultiInstance& multiInstance)
+{
+    // Plot the aggregate throughput against the number of instances, with a line for each processor
+    std::vector<BenchmarkPlot::Series> series;
+    const auto& slotResults = multiInstance.getSlotResults();
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        if (!slotResults[s].supported)
+            continue;
+
+        BenchmarkPlot::Series line;
+        line.name = BenchmarkRunner::getSlotName (static_cast<int> (s));
+        for (const auto& r : slotResults[s].results)
+            line.points.emplace_back (static_cast<double> (r.numInstances), r.throughput / 1.0E6);
+        series.push_back (line);
+    }
+
+    auto* report = new BenchmarkReportComponent();
+    report->getPlot().setXAxis ("Instances", true);
+    report->getPlot().setYAxis ("Throughput (Msamples/s)");
+    report->setPlotSeries (series);
+    report->setReportText (multiInstance.getResultsAsText());
+    report->setExportData (multiInstance.getResultsAsCsv(), multiInstance.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Multi-instance results", report, this);
+}
+void BenchmarkComponent::showColdWarmReport (const BenchmarkColdWarm& coldWarm)
+{
+    auto* report = new BenchmarkReportComponent();
+    report->setReportText (coldWarm.getResultsAsText());
+    report->setExportData (coldWarm.getResultsAsCsv(), coldWarm.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Cold vs warm cache results", report, this);
+}
+void BenchmarkComponent::showAlignmentSweepReport (const BenchmarkAlignmentSweep& alignmentSweep)
+{
+    // Plot the average cost against byte offset, with a line for each processor & channel padding
+    std::vector<BenchmarkPlot::Series> series;
+    const auto& processorNames = alignmentSweep.getProcessorNames();
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        for (const auto padding : alignmentSweep.getChannelPaddings())
+        {
+            BenchmarkPlot::Series s;
+            s.name << BenchmarkRunner::getSlotName (h) << " pad " << padding;
+            for (const auto& cell : alignmentSweep.getCells())
+                if (cell.channelPadding == padding)
+                    s.points.emplace_back (static_cast<double> (cell.byteOffset), cell.costs[static_cast<size_t> (h)].avg);
+            series.push_back (s);
+        }
+    }
+
+    auto* report = new BenchmarkReportComponent();
+    report->getPlot().setXAxis ("Byte offset from 64 byte boundary", false);
+    report->getPlot().setYAxis ("Average ns per sample per channel");
+    report->setPlotSeries (series);
+    report->setReportText (alignmentSweep.getResultsAsText());
+    report->setExportData (alignmentSweep.getResultsAsCsv(), alignmentSweep.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Alignment sweep results", report, this);
+}
+void BenchmarkComponent::showDenormalsReport (const BenchmarkDenormals& denormals)
+{
+    // Plot the time per call of each block of the stimulus, so the onset of any slowdown as the signal decays is visible
+    std::vector<BenchmarkPlot::Series> series;
+    const auto& slotResults = denormals.getSlotResults();
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        if (slotResults[s].name.isEmpty())
+            continue;
+
+        for (const auto ftzDaz : { false, true })
+        {
+            const auto& pass = ftzDaz ? slotResults[s].ftzDaz : slotResults[s].denormals;
+            BenchmarkPlot::Series line;
+            line.name << BenchmarkRunner::getSlotName (static_cast<int> (s)) << (ftzDaz ? " FTZ/DAZ" : " denormals");
+            for (size_t b = 0; b < pass.blockTimes.size(); ++b)
+                if (std::isfinite (pass.blockTimes[b]))
+                    line.points.emplace_back (static_cast<double> (b) * denormals.getBlockSeconds(), pass.blockTimes[b] * 1000.0);
+            series.push_back (line);
+        }
+    }
+
+    auto* report = new BenchmarkReportComponent();
+    report->getPlot().setXAxis ("Stimulus time (s), silent from " + String (denormals.getSilenceStartSeconds(), 2) + " s", false);
+    report->getPlot().setYAxis ("Time per call (us)");
+    report->setPlotSeries (series);
+    report->setReportText (denormals.getResultsAsText());
+    report->setExportData (denormals.getResultsAsCsv(), denormals.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Denormal results", report, this);
+}
+void BenchmarkComponent::showBlockPatternsReport (const BenchmarkBlockPatterns& blockPatterns)
+{
+    auto* report = new BenchmarkReportComponent();
+    report->setReportText (blockPatterns.getResultsAsText());
+    report->setExportData (blockPatterns.getResultsAsCsv(), blockPatterns.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Block size pattern results", report, this);
+}
+void BenchmarkComponent::showAutomationReport (const BenchmarkAutomation& automation)
+{
+    auto* report = new BenchmarkReportComponent();
+    report->setReportText (automation.getResultsAsText());
+    report->setExportData (automation.getResultsAsCsv(), automation.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Automation results", report, this);
+}
+void BenchmarkComponent::showControlSweepReport (const BenchmarkControlSweep& controlSweep)
+{
+    // Plot the average cost against the value of the swept control, with a line for each control (or each value of the second control of a pair)
+    std::vector<BenchmarkPlot::Series> series;
+    const auto& slotResults = controlSweep.getSlotResults();
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        const auto slotName = BenchmarkRunner::getSlotName (static_cast<int> (s));
+        for (const auto& p : slot.points)
+        {
+            String name;
+            name << slotName << " " << slot.controlNames[p.controlY >= 0 ? p.controlY : p.controlX];
+            if (p.controlY >= 0)
+                name << " " << String (p.valueY, 2);
+
+            auto it = std::find_if (series.begin(), series.end(), [&name] (const BenchmarkPlot::Series& existing) { return existing.name == name; });
+            if (it == series.end())
+            {
+                series.emplace_back();
+                series.back().name = name;
+                it = series.end() - 1;
+            }
+            it->points.emplace_back (p.valueX, p.cost.avg);
+        }
+    }
+
+    auto* report = new BenchmarkReportComponent();
+    report->getPlot().setXAxis (controlSweep.isPair() ? "Value of the first control" : "Control value", false);
+    report->getPlot().setYAxis ("Average ns per sample per channel");
+    report->setPlotSeries (series);
+    report->setReportText (controlSweep.getResultsAsText());
+    report->setExportData (controlSweep.getResultsAsCsv(), controlSweep.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Control sweep results", report, this);
+}
+void BenchmarkComponent::showStimuliReport (const BenchmarkStimuli& stimuli)
+{
+    auto* report = new BenchmarkReportComponent();
+    report->setReportText (stimuli.getResultsAsText());
+    report->setExportData (stimuli.getResultsAsCsv(), stimuli.getResultsAsJson());
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Stimuli results", report, this);
+}
+void BenchmarkComponent::showRealtimeViolationsReport()
+{
+    String txt;
+    for (auto p = 0; p < static_cast<int> (harnesses.size()); ++p)
+    {
+        auto* harness = harnesses[p];
+        if (!harness)
+            continue;
+
+        for (auto r = 0; r < static_cast<int> (routines.size()); ++r)
+        {
+            const auto* violations = harness->getRealtimeViolations (r);
+            if (violations == nullptr || violations->numStackTraces == 0)
+                continue;
+
+            txt << "Processor " << BenchmarkRunner::getSlotName (p) << " (" << harness->getProcessorName() << ") " << routines[static_cast<size_t> (r)]
+                << ": " << RealtimeGuard::getCountsText (*violations) << newLine;
+            for (const auto& trace : violations->getStackTraceDescriptions())
+                txt << trace;
+            txt << newLine;
+        }
+    }
+    if (txt.isEmpty())
+        return;
+
+    auto* report = new BenchmarkReportComponent();
+    report->setReportText (txt);
+    BenchmarkReportComponent::launch ("Real-time violations", report, this);
+}
+void BenchmarkComponent::showSectionsReport()
+{
+    String txt;
+    DynamicObject::Ptr processorsObj = new DynamicObject();
+    for (auto p = 0; p < static_cast<int> (harnesses.size()); ++p)
+    {
+        auto* harness = harnesses[p];
+        const auto* profiler = harness ? harness->getSectionProfiler() : nullptr;
+        if (profiler == nullptr || profiler->getNumSections() == 0)
+            continue;
+
+        const auto processAverage = harness->queryProcessingDurationAverage();
+        txt << "Processor " << BenchmarkRunner::getSlotName (p) << " (" << harness->getProcessorName() << "), process avg "
+            << String (processAverage * 1000.0, 2) << " us over " << static_cast<int64> (profiler->getNumCalls()) << " calls" << newLine
+            << profiler->getTreeText (processAverage) << newLine;
+        processorsObj->setProperty (Identifier (BenchmarkRunner::getSlotName (p)), profiler->getAsJson (processAverage));
+    }
+    if (txt.isEmpty())
+        return;
+
+    auto* report = new BenchmarkReportComponent();
+    report->setReportText (txt);
+    report->setExportData ({}, var (processorsObj.get()));
+    report->setEnvironment (environment);
+    BenchmarkReportComponent::launch ("Process section breakdown", report, this);
+}
 int BenchmarkComponent::getValueLabelIndex (const int processorIndex, const int routineIndex, const int valueIndex) const
 {
     const auto offset = (processorIndex == 0) ? 0 : static_cast<int> (routines.size() * values.size());
     return ProcessorHarness::getQueryIndex (routineIndex, valueIndex) + offset;
 }
+String BenchmarkComponent::getRealtimeBudgetText (const RealtimeBudget& budget)
+{
+    const auto percent = [] (const double fraction) { return std::isfinite (fraction) ? String (fraction * 100.0, 1) + "%" : String ("-"); };
+
+    String txt;
+    txt << "Budget " << String (budget.budgetMs * 1000.0, 1) << " us"
+        << "    Used avg " << percent (budget.meanFraction)
+        << ", p99 " << percent (budget.p99Fraction)
+        << ", p99.9 " << percent (budget.p99_9Fraction)
+        << ", max " << percent (budget.maxFraction)
+        << "    Deadline misses " << static_cast<int64> (budget.deadlineMisses)
+        << "    Max instances " << budget.maxInstancesAtP99 << " (p99), " << budget.maxInstancesAtMean << " (avg)";
+    return txt;
+}
+String BenchmarkComponent::getRealtimeViolationsText (const ProcessorHarness& harness)
+{
+    const auto* processViolations = harness.getRealtimeViolations (1);
+    const auto* resetViolations = harness.getRealtimeViolations (2);
+    if (processViolations == nullptr || resetViolations == nullptr)
+        return {};
+    return "    RT guard process " + RealtimeGuard::getCountsText (*processViolations) + ", reset " + String (resetViolations->getTotal());
+}
+String BenchmarkComponent::getResourceUsageText (const ProcessorHarness& harness)
+{
+    // Only the process routine is shown here, as that is what runs on the audio thread
+    const auto* usage = harness.getResourceUsage (1);
+    if (usage == nullptr || usage->numCalls == 0)
+        return {};
+
+    String txt;
+    txt << "    Process faults " << usage->counts[ResourceUsage::minorFaults] + usage->counts[ResourceUsage::majorFaults]
+        << " (in " << usage->callsWithFaults << " calls)"
+        << ", switches " << usage->counts[ResourceUsage::voluntarySwitches] << " / " << usage->counts[ResourceUsage::involuntarySwitches] << " (vol / invol)"
+        << ", peak RSS +" << usage->peakRssGrowthKb << " KB";
+    return txt;
+}
+String BenchmarkComponent::getPerformanceCountersText (const PerformanceCounters::Totals& totals)
+{
+    const auto format = [] (const double value, const int decimalPlaces)
+    {
+        return std::isfinite (value) ? String (value, decimalPlaces) : String ("-");
+    };
+
+    String txt;
+    txt << "IPC " << format (totals.getInstructionsPerCycle(), 2)
+        << "    Cycles/sample " << format (totals.getPerSample (PerformanceCounters::cycles), 1)
+        << "    Instructions/sample " << format (totals.getPerSample (PerformanceCounters::instructions), 1)
+        << "    L1D misses/sample " << format (totals.getPerSample (PerformanceCounters::l1dReadMisses), 3)
+        << "    LLC misses/sample " << format (totals.getPerSample (PerformanceCounters::llcMisses), 4)
+        << "    Branch misses/sample " << format (totals.getPerSample (PerformanceCounters::branchMisses), 3);
+    return txt;
+}
 
 BenchmarkComponent::BenchmarkThread::BenchmarkThread (std::vector<ProcessorHarness*>* harnesses, SourceComponent* sourceComponent, BenchmarkComponent* benchmarkComponent)
     : ThreadWithProgressWindow ("Benchmark is running", true, true),
@@ -350,85 +1046,214 @@ BenchmarkComponent::BenchmarkThread::BenchmarkThread (std::vector<ProcessorHarne
 }
 void BenchmarkComponent::BenchmarkThread::run()
 {
-    jassert (testCycles > 0 && processingIterations > 0);
-    jassert (testSpec.numChannels > 0 && testSpec.maximumBlockSize > 0 && testSpec.sampleRate > 0);
-
-    const dsp::ProcessContextReplacing<float> context (*audioBlock.get());
-    
-    // Only count non null harnesses
-    auto numHarnesses = 0;
-    if ((*processingHarnesses)[0]) numHarnesses++;
-    if ((*processingHarnesses)[1]) numHarnesses++;
+    const auto progressCallback = [this] (const double progress)
+    {
+        if (threadShouldExit()) return false;
+        setProgress (progress);
+        return true;
+    };
 
-    auto numerator = 0;
-    const auto denominator = static_cast<double> (numHarnesses * testCycles * (2 + processingIterations));
+    // Pin the thread, raise its priority & lock the memory (as selected) for the duration of the run
+    isolationApplied = isolation.apply();
+    environment.captureStart();
 
-    setProgress (0.0);
-    for (auto c = 0; c < testCycles; ++c)
+    if (mode == Mode::compare)
     {
-        for (auto p : *processingHarnesses)
-        {
-            if (p)
-            {
-                p->resetHarness();
-                numerator++;
-                if (threadShouldExit()) return;
-                
-                p->prepareHarness (testSpec);
-                numerator++;
-                if (threadShouldExit()) return;
-                
-                for (auto i = 0; i < processingIterations; ++i)
-                {
-                    p->processHarness (context);
-                    numerator++;
-                    if (threadShouldExit()) return;
-                    setProgress (static_cast<double> (numerator) / denominator);
-                    yield();
-                }
-            }
-        }
+        auto* harnessA = (*processingHarnesses)[0];
+        auto* harnessB = (*processingHarnesses)[1];
+        jassert (harnessA && harnessB);
+        for (auto* h : { harnessA, harnessB })
+            if (!h->setTimingSource (runner.getTimingSource()))
+                jassertfalse;
+        comparison.setBatchIterations (runner.getProcessingIterations());
+        comparison.run (*harnessA, *harnessB, runner.getProcessSpec(), runner.getAudioBlock(), progressCallback);
+    }
+    else if (mode == Mode::multiInstance)
+    {
+        multiInstance.setIterations (runner.getProcessingIterations());
+        multiInstance.setTimingSource (runner.getTimingSource());
+        multiInstance.run (*processingHarnesses, runner.getProcessSpec(), runner.getAudioBlock(), progressCallback);
+    }
+    else if (mode == Mode::coldWarm)
+    {
+        coldWarm.setColdState (cacheState == BenchmarkRunner::CacheState::warm ? BenchmarkRunner::CacheState::cold : cacheState);
+        coldWarm.run (runner, *processingHarnesses, progressCallback);
+    }
+    else if (mode == Mode::denormals)
+    {
+        denormals.setRuns (runner.getTestCycles());
+        denormals.setTimingSource (runner.getTimingSource());
+        denormals.run (*processingHarnesses, runner.getProcessSpec(), runner.getAudioBlock(), progressCallback);
+    }
+    else if (mode == Mode::blockPatterns)
+    {
+        blockPatterns.setHostBuffers (runner.getProcessingIterations());
+        blockPatterns.setRuns (runner.getTestCycles());
+        blockPatterns.setTimingSource (runner.getTimingSource());
+        blockPatterns.run (*processingHarnesses, runner.getProcessSpec(), runner.getAudioBlock(), progressCallback);
+    }
+    else if (mode == Mode::automation)
+    {
+        automation.setHostBuffers (runner.getProcessingIterations());
+        automation.setRuns (runner.getTestCycles());
+        automation.setTimingSource (runner.getTimingSource());
+        automation.run (*processingHarnesses, runner.getProcessSpec(), runner.getAudioBlock(), progressCallback);
+    }
+    else if (mode == Mode::stimuli)
+    {
+        stimuli.setHostBuffers (runner.getProcessingIterations());
+        stimuli.setRuns (runner.getTestCycles());
+        stimuli.setTimingSource (runner.getTimingSource());
+        stimuli.run (*processingHarnesses, runner.getProcessSpec(), runner.getAudioBlock(), progressCallback);
+    }
+    else if (mode == Mode::sweep)
+    {
+        sweep.run (runner, *processingHarnesses, [this] (dsp::AudioBlock<float>& block, const dsp::ProcessSpec&) { copySourceAudio (block); }, progressCallback);
+    }
+    else if (mode == Mode::alignmentSweep)
+    {
+        alignmentSweep.run (runner, *processingHarnesses, [this] (dsp::AudioBlock<float>& block, const dsp::ProcessSpec&) { copySourceAudio (block); }, progressCallback);
     }
+    else if (mode == Mode::controlSweep)
+    {
+        controlSweep.run (runner, *processingHarnesses, [this] (dsp::AudioBlock<float>& block, const dsp::ProcessSpec&) { copySourceAudio (block); }, progressCallback);
+    }
+    else
+    {
+        runner.run (*processingHarnesses, progressCallback);
+    }
+
+    environment.captureEnd();
+    isolation.restore();
 }
-void BenchmarkComponent::BenchmarkThread::threadComplete (bool /* userPressedCancel */)
+void BenchmarkComponent::BenchmarkThread::threadComplete (bool userPressedCancel)
 {
-    // Nothing to do here!
+    // This is called on the message thread once the benchmark thread has finished
+    parent->setPerformanceCountersStatus (runner.getPerformanceCountersError());
+    parent->setEnvironment (environment);
+    if (!isolationApplied)
+        AlertWindow::showMessageBoxAsync (AlertWindow::AlertIconType::WarningIcon, "Benchmark isolation", "The benchmark ran, but not all of the isolation settings could be applied: "
+                                          + isolation.getStatus());
+    if (mode == Mode::sweep && !userPressedCancel)
+        parent->showSweepReport (sweep);
+    else if (mode == Mode::compare && !userPressedCancel)
+        parent->showComparisonReport (comparison);
+    else if (mode == Mode::multiInstance && !userPressedCancel)
+        parent->showMultiInstanceReport (multiInstance);
+    else if (mode == Mode::coldWarm && !userPressedCancel)
+        parent->showColdWarmReport (coldWarm);
+    else if (mode == Mode::alignmentSweep && !userPressedCancel)
+        parent->showAlignmentSweepReport (alignmentSweep);
+    else if (mode == Mode::denormals && !userPressedCancel)
+        parent->showDenormalsReport (denormals);
+    else if (mode == Mode::blockPatterns && !userPressedCancel)
+        parent->showBlockPatternsReport (blockPatterns);
+    else if (mode == Mode::automation && !userPressedCancel)
+        parent->showAutomationReport (automation);
+    else if (mode == Mode::controlSweep && !userPressedCancel)
+        parent->showControlSweepReport (controlSweep);
+    else if (mode == Mode::stimuli && !userPressedCancel)
+        parent->showStimuliReport (stimuli);
+    else if (mode == Mode::singleSpec && !userPressedCancel)
+    {
+        parent->showRealtimeViolationsReport();
+        parent->showSectionsReport();
+    }
 }
 void BenchmarkComponent::BenchmarkThread::setTestCycles (const int cycles)
 {
-    testCycles = cycles;
+    runner.setTestCycles (cycles);
 }
 void BenchmarkComponent::BenchmarkThread::setProcessingIterations (const int iterations)
 {
-    processingIterations = iterations;
+    runner.setProcessingIterations (iterations);
+}
+void BenchmarkComponent::BenchmarkThread::setTimingSource (const BenchmarkTimer::Source source)
+{
+    runner.setTimingSource (source);
+}
+void BenchmarkComponent::BenchmarkThread::setPerformanceCountersEnabled (const bool shouldBeEnabled)
+{
+    runner.setPerformanceCountersEnabled (shouldBeEnabled);
+}
+void BenchmarkComponent::BenchmarkThread::setCacheState (const BenchmarkRunner::CacheState state)
+{
+    cacheState = state;
+    runner.setCacheState (state);
+}
+void BenchmarkComponent::BenchmarkThread::setMode (const Mode newMode)
+{
+    mode = newMode;
+}
+void BenchmarkComponent::BenchmarkThread::setSweepGrid (const Array<int>& blockSizes, const Array<int>& channelCounts, const Array<double>& sampleRates)
+{
+    sweep.setBlockSizes (blockSizes);
+    sweep.setChannelCounts (channelCounts);
+    sweep.setSampleRates (sampleRates);
+}
+bool BenchmarkComponent::BenchmarkThread::setAlignmentSweep (const Array<int>& byteOffsets, const Array<int>& channelPaddings)
+{
+    alignmentSweep.setByteOffsets (byteOffsets);
+    alignmentSweep.setChannelPaddings (channelPaddings);
+    return alignmentSweep.getNumCells() > 0;
+}
+void BenchmarkComponent::BenchmarkThread::setComparisonPrecision (const double relativeHalfWidth)
+{
+    comparison.setTargetPrecision (relativeHalfWidth);
+}
+void BenchmarkComponent::BenchmarkThread::setControlSweep (const int steps, const int controlX, const int controlY)
+{
+    controlSweep.setSteps (steps);
+    controlSweep.setControls (controlX, controlY);
+}
+void BenchmarkComponent::BenchmarkThread::setStimuli (const std::vector<BenchmarkStimuli::Stimulus>& stimuliToRun)
+{
+    stimuli.setStimuli (stimuliToRun);
+}
+void BenchmarkComponent::BenchmarkThread::setIsolation (const int cpu, const BenchmarkIsolation::Scheduling scheduling, const bool lockMemory)
+{
+    isolation.setCpu (cpu);
+    isolation.setScheduling (scheduling);
+    isolation.setMemoryLocked (lockMemory);
 }
 void BenchmarkComponent::BenchmarkThread::setProcessSpec (dsp::ProcessSpec & spec)
 {
     jassert (spec.numChannels > 0 && spec.maximumBlockSize > 0 && spec.sampleRate > 0);
-    testSpec = spec;
 
     // Initialise audio block
-    audioBlock = std::make_unique<dsp::AudioBlock<float>> (heapBlock, testSpec.numChannels, testSpec.maximumBlockSize);
-    parent->setBufferAlignmentStatus (getAudioBlockAlignmentStatus());
+    runner.setProcessSpec (spec);
+    parent->setBufferAlignmentStatus (runner.getAudioBlockAlignmentStatus());
 
     // Fill block with audio data from source component
     jassert (srcComponent);
     srcComponent->prepare (spec);
-    const dsp::ProcessContextReplacing<float> context (*audioBlock.get());
+    const dsp::ProcessContextReplacing<float> context (runner.getAudioBlock());
     srcComponent->process (context);
+
+    if (mode == Mode::sweep)
+    {
+        // Render enough source audio for the largest block in the sweep here on the message thread, as the source component
+        // isn't safe to use from the benchmark thread (the sample rate of the selected spec is used for every cell)
+        auto maxBlockSize = 0;
+        for (const auto b : sweep.getBlockSizes())
+            maxBlockSize = jmax (maxBlockSize, b);
+        const dsp::ProcessSpec sourceSpec { spec.sampleRate, static_cast<uint32> (maxBlockSize), spec.numChannels };
+        sweepSourceBuffer.setSize (static_cast<int> (spec.numChannels), maxBlockSize);
+        srcComponent->prepare (sourceSpec);
+        dsp::AudioBlock<float> sourceBlock (sweepSourceBuffer);
+        srcComponent->process (dsp::ProcessContextReplacing<float> (sourceBlock));
+    }
+    else if (mode == Mode::alignmentSweep || mode == Mode::controlSweep)
+    {
+        // Keep a copy of the source audio, as the runner's block is reallocated for each buffer layout (or processed in place for each control setting)
+        sweepSourceBuffer.setSize (static_cast<int> (spec.numChannels), static_cast<int> (spec.maximumBlockSize));
+        dsp::AudioBlock<float> (sweepSourceBuffer).copyFrom (runner.getAudioBlock());
+    }
 }
-bool BenchmarkComponent::BenchmarkThread::isSseAligned (const float* data)
+void BenchmarkComponent::BenchmarkThread::copySourceAudio (dsp::AudioBlock<float>& block) const
 {
-    return (reinterpret_cast<uintptr_t>(data) & 0xF) == 0;
+    const auto numSourceChannels = sweepSourceBuffer.getNumChannels();
+    const auto numSamples = jmin (static_cast<int> (block.getNumSamples()), sweepSourceBuffer.getNumSamples());
+    for (auto ch = 0; ch < static_cast<int> (block.getNumChannels()); ++ch)
+        FloatVectorOperations::copy (block.getChannelPointer (static_cast<size_t> (ch)), sweepSourceBuffer.getReadPointer (ch % numSourceChannels), numSamples);
 }
-String BenchmarkComponent::BenchmarkThread::getAudioBlockAlignmentStatus() const
-{
-    auto bufIsAligned = true;
-	for (auto ch = 0; ch < static_cast<int> (audioBlock->getNumChannels()); ++ch)
-		bufIsAligned = bufIsAligned && isSseAligned (audioBlock->getChannelPointer (ch));
-
-	if (bufIsAligned)
-		return "AudioBlock is SSE aligned";
-	else
-		return "AudioBlock is not SSE aligned";
-}
\ No newline at end of file
@@ -12,6 +12,19 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "../Processing/ProcessorHarness.h"
+#include "../Processing/BenchmarkRunner.h"
+#include "../Processing/BenchmarkSweep.h"
+#include "../Processing/BenchmarkComparison.h"
+#include "../Processing/BenchmarkMultiInstance.h"
+#include "../Processing/BenchmarkColdWarm.h"
+#include "../Processing/BenchmarkAlignmentSweep.h"
+#include "../Processing/BenchmarkDenormals.h"
+#include "../Processing/BenchmarkBlockPatterns.h"
+#include "../Processing/BenchmarkAutomation.h"
+#include "../Processing/BenchmarkControlSweep.h"
+#include "../Processing/BenchmarkStimuli.h"
+#include "../Processing/BenchmarkIsolation.h"
+#include "../Processing/BenchmarkEnvironment.h"
 #include "SourceComponent.h"
 
 class BenchmarkComponent : public Component, public Timer
@@ -25,9 +38,71 @@ public:
     void resized() override;
     void timerCallback() override;
     void setBufferAlignmentStatus (const String &status);
+    void setPerformanceCountersStatus (const String& status);
+
+    /** Set the environment of the last run, which is added to the reports (& highlights the status if it was unstable). */
+    void setEnvironment (const BenchmarkEnvironment& runEnvironment);
 
 private:
 
+    enum class Mode : int
+    {
+        singleSpec = 1,     /**< Runs the benchmark cycles against the selected ProcessSpec. */
+        sweep,              /**< Runs the benchmark cycles over a grid of block sizes, channel counts & sample rates. */
+        compare,            /**< Interleaves batches of processor A & B until the difference between them is known precisely enough. */
+        multiInstance,      /**< Runs increasing numbers of concurrent instances of each processor to show how throughput scales across cores. */
+        coldWarm,           /**< Runs the benchmark cycles with warm caches & then with the caches evicted before every process call. */
+        alignmentSweep,     /**< Runs the benchmark cycles with the channel buffers at a range of offsets from a cache line & channel paddings. */
+        denormals,          /**< Feeds each processor a signal decaying to silence with & without FTZ/DAZ to show any denormal slowdown. */
+        blockPatterns,      /**< Feeds each processor blocks of varying size (as hosts do) to show the fixed cost of each process call. */
+        automation,         /**< Changes the controls while processing to show the cost of automation against static controls. */
+        controlSweep,       /**< Runs the benchmark cycles with each control (or a pair of controls) stepped across its range to find the worst case setting. */
+        stimuli             /**< Feeds each processor a set of input signals (regenerated before every call) to show any signal dependent cost. */
+    };
+
+    enum class GuardSetting : int
+    {
+        off = 1,                /**< The harness routines run unguarded. */
+        count,                  /**< Allocations & locks made by the process & reset routines are counted. */
+        countWithStackTraces    /**< As per count, and the stack traces of the violations are captured & shown after a run. */
+    };
+
+    /** Shows the results of a sweep in a separate report window. */
+    void showSweepReport (const BenchmarkSweep& sweep);
+
+    /** Shows the results of an A/B comparison in a separate report window. */
+    void showComparisonReport (const BenchmarkComparison& comparison);
+
+    /** Shows the results of a multi-instance run in a separate report window. */
+    void showMultiInstanceReport (const BenchmarkMultiInstance& multiInstance);
+
+    /** Shows the warm & cold cache results side by side in a separate report window. */
+    void showColdWarmReport (const BenchmarkColdWarm& coldWarm);
+
+    /** Shows the results of an alignment sweep in a separate report window. */
+    void showAlignmentSweepReport (const BenchmarkAlignmentSweep& alignmentSweep);
+
+    /** Shows the results of the denormal benchmark (with & without FTZ/DAZ) in a separate report window. */
+    void showDenormalsReport (const BenchmarkDenormals& denormals);
+
+    /** Shows the cost per sample of each block size pattern in a separate report window. */
+    void showBlockPatternsReport (const BenchmarkBlockPatterns& blockPatterns);
+
+    /** Shows the cost of each automation scenario in a separate report window. */
+    void showAutomationReport (const BenchmarkAutomation& automation);
+
+    /** Shows the cost against control value (for each control, or each value of the second control of a pair) in a separate report window. */
+    void showControlSweepReport (const BenchmarkControlSweep& controlSweep);
+
+    /** Shows the cost of each stimulus in a separate report window. */
+    void showStimuliReport (const BenchmarkStimuli& stimuli);
+
+    /** Shows the stack traces of any real-time violations in a separate report window (if any were captured). */
+    void showRealtimeViolationsReport();
+
+    /** Shows the breakdown of the process time into the sections marked by the processors in a separate report window (if any were timed). */
+    void showSectionsReport();
+
     class BenchmarkThread : public ThreadWithProgressWindow
     {
     public:
@@ -46,40 +121,92 @@ private:
         /**< Set ProcessSpec to test against. */
         void setProcessSpec (dsp::ProcessSpec& spec);
 
-    private:
+        /** Set the clock used to time the routines. */
+        void setTimingSource (const BenchmarkTimer::Source source);
+
+        /** Enable hardware performance counters around the processing iterations. */
+        void setPerformanceCountersEnabled (const bool shouldBeEnabled);
+
+        /** Set the cache state to run the process routine in (for the cold vs warm mode, this selects the cold state). */
+        void setCacheState (const BenchmarkRunner::CacheState state);
 
-        /** Returns true if the specified pointer points to 16 byte aligned data. */
-        static inline bool isSseAligned (const float* data);
+        /** Set the benchmark mode (applied when the thread is next started). */
+        void setMode (const Mode newMode);
 
-        /** Returns a string describing the buffer alignment status. */
-        String getAudioBlockAlignmentStatus() const;
+        /** Set the grid of specs to run in sweep mode. */
+        void setSweepGrid (const Array<int>& blockSizes, const Array<int>& channelCounts, const Array<double>& sampleRates);
+
+        /** Set the buffer offsets & channel paddings to run in alignment sweep mode. Returns false if none of them are valid. */
+        bool setAlignmentSweep (const Array<int>& byteOffsets, const Array<int>& channelPaddings);
+
+        /** Set the target precision (relative half width of the confidence interval) for the A/B comparison. */
+        void setComparisonPrecision (const double relativeHalfWidth);
+
+        /** Set the number of values to step each control through & the controls to sweep in control sweep mode (see BenchmarkControlSweep::setControls). */
+        void setControlSweep (const int steps, const int controlX, const int controlY);
+
+        /** Set the input signals to run in stimuli mode. */
+        void setStimuli (const std::vector<BenchmarkStimuli::Stimulus>& stimuliToRun);
+
+        /** Set the CPU to pin the benchmark thread to (-1 for any), its scheduling policy & whether the memory is locked during a run. */
+        void setIsolation (const int cpu, const BenchmarkIsolation::Scheduling scheduling, const bool lockMemory);
+
+    private:
 
         std::vector<ProcessorHarness*>* processingHarnesses{};
         SourceComponent* srcComponent;
         BenchmarkComponent* parent;
-        int testCycles = 0;
-        int processingIterations = 0;
-        dsp::ProcessSpec testSpec {};
-        HeapBlock<char> heapBlock{};
-        std::unique_ptr<dsp::AudioBlock<float>> audioBlock{};
+        BenchmarkRunner runner;
+        BenchmarkSweep sweep;
+        BenchmarkComparison comparison;
+        BenchmarkMultiInstance multiInstance;
+        BenchmarkColdWarm coldWarm;
+        BenchmarkAlignmentSweep alignmentSweep;
+        BenchmarkDenormals denormals;
+        BenchmarkBlockPatterns blockPatterns;
+        BenchmarkAutomation automation;
+        BenchmarkControlSweep controlSweep;
+        BenchmarkStimuli stimuli;
+        BenchmarkIsolation isolation;
+        bool isolationApplied = true;
+        BenchmarkEnvironment environment;
+        BenchmarkRunner::CacheState cacheState = BenchmarkRunner::CacheState::warm;
+        Mode mode = Mode::singleSpec;
+        AudioBuffer<float> sweepSourceBuffer;   /**< Source audio rendered on the message thread, which is copied into each cell of a sweep. */
+
+        /** Copies the pre-rendered source audio into a block (repeating its channels if the block has more channels). */
+        void copySourceAudio (dsp::AudioBlock<float>& block) const;
     };
 
     int getValueLabelIndex (const int processorIndex, const int routineIndex, const int valueIndex) const;
+    static String getPerformanceCountersText (const PerformanceCounters::Totals& totals);
+    static String getRealtimeBudgetText (const RealtimeBudget& budget);
+    static String getRealtimeViolationsText (const ProcessorHarness& harness);
+    static String getResourceUsageText (const ProcessorHarness& harness);
 
     OwnedArray<Label> processorLabels{};
     OwnedArray<Label> routineLabels{};
     OwnedArray<Label> valueTitleLabels{};
     OwnedArray<Label> valueLabels{};
-    Label lblChannels, lblBlockSize, lblSampleRate, lblCycles, lblIterations, lblBufferAlignmentStatus;
-    ComboBox cmbChannels, cmbBlockSize, cmbSampleRate, cmbCycles, cmbIterations;
+    OwnedArray<Label> budgetLabels{};
+    OwnedArray<Label> counterLabels{};
+    Label lblChannels, lblBlockSize, lblSampleRate, lblCycles, lblIterations, lblTimer, lblCounters, lblMode, lblCache, lblRealtimeGuard, lblBufferAlignmentStatus;
+    Label lblSweepBlockSizes, lblSweepChannels, lblSweepSampleRates, lblPrecision, lblAlignmentOffsets, lblChannelPaddings, lblControlSteps, lblControlPair, lblStimuli, lblCpu, lblScheduling, lblLockMemory, lblResourceUsage, lblWarmup, lblSections;
+    ComboBox cmbChannels, cmbBlockSize, cmbSampleRate, cmbCycles, cmbIterations, cmbTimer, cmbMode, cmbPrecision, cmbCache, cmbRealtimeGuard, cmbControlSteps, cmbCpu, cmbScheduling, cmbWarmup;
+    TextEditor txtSweepBlockSizes, txtSweepChannels, txtSweepSampleRates, txtAlignmentOffsets, txtChannelPaddings, txtControlPair, txtStimuli;
+    ToggleButton btnCounters, btnLockMemory, btnResourceUsage, btnSections;
     TextButton btnStart, btnReset;
 
     dsp::ProcessSpec spec;
+    String performanceCountersStatus {};
+    BenchmarkEnvironment environment {};
 
     const std::vector<String> processors = { "Processor A", "Processor B" };
     const std::vector<String> routines = { "Prepare", "Process", "Reset" };
-    const std::vector<String> values = { "Min", "Avg", "Max", "#" };
-    const std::vector<String> valueTooltips = { "Minimum time for routine (microseconds)", "Average time for routine (microseconds)", "Maximum time for routine (microseconds)", "Number of times this routine was run" };
+    const std::vector<String> values = { "Min", "Avg", "Max", "#", "p50", "p90", "p99", "p99.9", "p99.99" };
+    const std::vector<String> valueTooltips = { "Minimum time for routine (microseconds)", "Average time for routine (microseconds)", "Maximum time for routine (microseconds)", "Number of times this routine was run",
+                                                "Median time for routine (microseconds)", "90th percentile time for routine (microseconds)", "99th percentile time for routine (microseconds)",
+                                                "99.9th percentile time for routine (microseconds)", "99.99th percentile time for routine (microseconds)" };
 
     std::vector<ProcessorHarness*> harnesses{};
     BenchmarkThread benchmarkThread;
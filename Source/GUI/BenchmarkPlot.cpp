@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    BenchmarkPlot.cpp
+    Created: 18 Oct 2026 4:58:16pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkPlot.h"
+#include "LookAndFeel.h"
+
+void BenchmarkPlot::paint (Graphics& g)
+{
+    using cols = DspTestBenchLnF::ApplicationColours;
+
+    g.fillAll (cols::benchmarkHeadingBackground());
+    g.setFont (font);
+
+    const auto textHeight = roundToInt (font.getHeight());
+    const auto plotArea = getLocalBounds().reduced (GUI_GAP_I (2))
+                                          .withTrimmedLeft (textHeight * 4)
+                                          .withTrimmedBottom (textHeight * 3)
+                                          .toFloat();
+
+    // Find the range of the data
+    auto xMin = std::numeric_limits<double>::max(), xMax = std::numeric_limits<double>::lowest();
+    auto yMax = 0.0;
+    for (const auto& s : series)
+    {
+        for (const auto& p : s.points)
+        {
+            if (!std::isfinite (p.y) || !std::isfinite (p.x) || (xAxisIsLog2 && p.x <= 0.0))
+                continue;
+            xMin = jmin (xMin, toPlotX (p.x));
+            xMax = jmax (xMax, toPlotX (p.x));
+            yMax = jmax (yMax, p.y);
+        }
+    }
+
+    g.setColour (cols::normalFontColour());
+    g.drawText (xAxisLabel, plotArea.withY (plotArea.getBottom() + static_cast<float> (textHeight) * 1.5f).withHeight (static_cast<float> (textHeight)), Justification::centred);
+    {
+        // Y axis label is drawn vertically
+        Graphics::ScopedSaveState state (g);
+        const Point<float> labelCentre (plotArea.getX() - static_cast<float> (textHeight) * 3.5f, plotArea.getCentreY());
+        g.addTransform (AffineTransform::rotation (-MathConstants<float>::halfPi, labelCentre.x, labelCentre.y));
+        g.drawText (yAxisLabel, Rectangle<float> (plotArea.getHeight(), static_cast<float> (textHeight)).withCentre (labelCentre), Justification::centred);
+    }
+
+    g.setColour (cols::normalFontColour().withAlpha (0.5f));
+    g.drawRect (plotArea);
+
+    if (xMax < xMin || yMax <= 0.0)
+    {
+        g.setColour (cols::normalFontColour());
+        g.drawText ("No results", plotArea, Justification::centred);
+        return;
+    }
+    if (xMax == xMin)
+    {
+        xMin -= 1.0;
+        xMax += 1.0;
+    }
+    yMax *= 1.1;
+
+    const auto mapX = [&] (const double x) { return plotArea.getX() + static_cast<float> ((toPlotX (x) - xMin) / (xMax - xMin)) * plotArea.getWidth(); };
+    const auto mapY = [&] (const double y) { return plotArea.getBottom() - static_cast<float> (y / yMax) * plotArea.getHeight(); };
+
+    // Grid lines & tick labels
+    const auto gridColour = cols::normalFontColour().withAlpha (0.2f);
+    constexpr auto numYTicks = 5;
+    for (auto i = 0; i <= numYTicks; ++i)
+    {
+        const auto y = yMax * static_cast<double> (i) / numYTicks;
+        const auto py = mapY (y);
+        g.setColour (gridColour);
+        g.drawHorizontalLine (roundToInt (py), plotArea.getX(), plotArea.getRight());
+        g.setColour (cols::normalFontColour());
+        g.drawText (String (y, y < 10.0 ? 2 : 1), Rectangle<float> (plotArea.getX() - static_cast<float> (textHeight) * 3.0f, py - static_cast<float> (textHeight) * 0.5f,
+                                                                  static_cast<float> (textHeight) * 2.8f, static_cast<float> (textHeight)), Justification::centredRight);
+    }
+    const auto drawXTick = [&] (const double x)
+    {
+        const auto px = mapX (x);
+        g.setColour (gridColour);
+        g.drawVerticalLine (roundToInt (px), plotArea.getY(), plotArea.getBottom());
+        g.setColour (cols::normalFontColour());
+        g.drawText (String (x, 0), Rectangle<float> (px - static_cast<float> (textHeight) * 2.0f, plotArea.getBottom() + 2.0f,
+                                                     static_cast<float> (textHeight) * 4.0f, static_cast<float> (textHeight)), Justification::centred);
+    };
+    if (xAxisIsLog2)
+    {
+        for (auto e = std::ceil (xMin); e <= xMax; e += 1.0)
+            drawXTick (std::exp2 (e));
+    }
+    else
+    {
+        for (auto i = 0; i <= 5; ++i)
+            drawXTick (xMin + (xMax - xMin) * i / 5.0);
+    }
+
+    // Data lines
+    const auto numSeries = static_cast<int> (series.size());
+    for (auto s = 0; s < numSeries; ++s)
+    {
+        Path path;
+        auto started = false;
+        for (const auto& p : series[static_cast<size_t> (s)].points)
+        {
+            if (!std::isfinite (p.y) || (xAxisIsLog2 && p.x <= 0.0))
+                continue;
+            const Point<float> pt (mapX (p.x), mapY (p.y));
+            if (started)
+                path.lineTo (pt);
+            else
+                path.startNewSubPath (pt);
+            started = true;
+            g.setColour (getSeriesColour (s, numSeries));
+            g.fillEllipse (Rectangle<float> (4.0f, 4.0f).withCentre (pt));
+        }
+        g.setColour (getSeriesColour (s, numSeries));
+        g.strokePath (path, PathStrokeType (1.5f));
+    }
+
+    // Legend
+    auto legendArea = plotArea.reduced (static_cast<float> (textHeight) * 0.5f).removeFromRight (static_cast<float> (textHeight) * 10.0f);
+    for (auto s = 0; s < numSeries; ++s)
+    {
+        auto row = legendArea.removeFromTop (static_cast<float> (textHeight) * 1.1f);
+        g.setColour (getSeriesColour (s, numSeries));
+        g.fillRect (row.removeFromLeft (static_cast<float> (textHeight)).reduced (2.0f));
+        g.drawText (series[static_cast<size_t> (s)].name, row.withTrimmedLeft (4.0f), Justification::centredLeft);
+    }
+}
+void BenchmarkPlot::setSeries (const std::vector<Series>& newSeries)
+{
+    series = newSeries;
+    repaint();
+}
+void BenchmarkPlot::setXAxis (const String& label, const bool isLog2)
+{
+    xAxisLabel = label;
+    xAxisIsLog2 = isLog2;
+    repaint();
+}
+void BenchmarkPlot::setYAxis (const String& label)
+{
+    yAxisLabel = label;
+    repaint();
+}
+Colour BenchmarkPlot::getSeriesColour (const int seriesIndex, const int numSeries)
+{
+    return Colour::fromHSV (static_cast<float> (seriesIndex) / static_cast<float> (jmax (1, numSeries)), 0.65f, 0.95f, 1.0f);
+}
+double BenchmarkPlot::toPlotX (const double x) const
+{
+    return xAxisIsLog2 ? std::log2 (x) : x;
+}
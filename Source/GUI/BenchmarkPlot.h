@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    BenchmarkPlot.h
+    Created: 18 Oct 2026 4:58:16pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/**
+ * Simple line plot for benchmark results (e.g. cost against block size), with an optional log2 x axis and a legend.
+ */
+class BenchmarkPlot : public Component
+{
+public:
+
+    struct Series
+    {
+        String name;
+        std::vector<Point<double>> points;
+    };
+
+    BenchmarkPlot() = default;
+    ~BenchmarkPlot() override = default;
+
+    void paint (Graphics& g) override;
+
+    void setSeries (const std::vector<Series>& newSeries);
+    void setXAxis (const String& label, const bool isLog2);
+    void setYAxis (const String& label);
+
+    /** Returns the colour used for a series. */
+    static Colour getSeriesColour (const int seriesIndex, const int numSeries);
+
+private:
+
+    [[nodiscard]] double toPlotX (const double x) const;
+
+    std::vector<Series> series {};
+    String xAxisLabel {}, yAxisLabel {};
+    bool xAxisIsLog2 = false;
+
+    const Font font = Font (FontOptions (GUI_SIZE_F (0.5f)));
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkPlot)
+};
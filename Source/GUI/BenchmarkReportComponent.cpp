@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    BenchmarkReportComponent.cpp
+    Created: 18 Oct 2026 5:14:39pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkReportComponent.h"
+#include "LookAndFeel.h"
+
+BenchmarkReportComponent::BenchmarkReportComponent()
+{
+    using cols = DspTestBenchLnF::ApplicationColours;
+
+    txtReport.setMultiLine (true);
+    txtReport.setReadOnly (true);
+    txtReport.setCaretVisible (false);
+    txtReport.setScrollbarsShown (true);
+    txtReport.setFont (reportFont);
+    txtReport.setColour (TextEditor::ColourIds::outlineColourId, Colours::transparentBlack);
+    txtReport.setColour (TextEditor::ColourIds::backgroundColourId, cols::benchmarkHeadingBackground());
+    txtReport.setColour (TextEditor::ColourIds::textColourId, cols::normalFontColour());
+    addAndMakeVisible (txtReport);
+
+    addChildComponent (plot);
+
+    btnSaveCsv.setButtonText ("Save CSV...");
+    btnSaveCsv.onClick = [this] { saveResults (".csv"); };
+    addChildComponent (btnSaveCsv);
+
+    btnSaveJson.setButtonText ("Save JSON...");
+    btnSaveJson.onClick = [this] { saveResults (".json"); };
+    addChildComponent (btnSaveJson);
+
+    setSize (900, 700);
+}
+void BenchmarkReportComponent::paint (Graphics& g)
+{
+    g.fillAll (DspTestBenchLnF::ApplicationColours::componentBackground());
+}
+void BenchmarkReportComponent::resized()
+{
+    auto area = getLocalBounds().reduced (GUI_GAP_I (1));
+
+    auto buttonRow = area.removeFromBottom (GUI_SIZE_I (0.8));
+    btnSaveJson.setBounds (buttonRow.removeFromRight (GUI_SIZE_I (4.0)));
+    buttonRow.removeFromRight (GUI_GAP_I (1));
+    btnSaveCsv.setBounds (buttonRow.removeFromRight (GUI_SIZE_I (4.0)));
+    area.removeFromBottom (GUI_GAP_I (1));
+
+    if (plot.isVisible())
+    {
+        plot.setBounds (area.removeFromTop (area.getHeight() / 2));
+        area.removeFromTop (GUI_GAP_I (1));
+    }
+    txtReport.setBounds (area);
+}
+void BenchmarkReportComponent::setReportText (const String& text)
+{
+    txtReport.setText (text, false);
+}
+BenchmarkPlot& BenchmarkReportComponent::getPlot()
+{
+    return plot;
+}
+void BenchmarkReportComponent::setPlotSeries (const std::vector<BenchmarkPlot::Series>& series)
+{
+    plot.setSeries (series);
+    plot.setVisible (!series.empty());
+    resized();
+}
+void BenchmarkReportComponent::setExportData (const String& csv, const var& json)
+{
+    csvResults = csv;
+    jsonResults = json;
+    btnSaveCsv.setVisible (csvResults.isNotEmpty());
+    btnSaveJson.setVisible (!jsonResults.isVoid());
+}
+void BenchmarkReportComponent::setEnvironment (const BenchmarkEnvironment& environment)
+{
+    txtReport.setText (txtReport.getText() + newLine + "Environment" + newLine + environment.getSummaryText(), false);
+    jsonResults = environment.addToResults (jsonResults);
+}
+void BenchmarkReportComponent::launch (const String& title, BenchmarkReportComponent* report, Component* componentToCentreAround)
+{
+    DialogWindow::LaunchOptions launchOptions;
+    launchOptions.dialogTitle = title;
+    launchOptions.useNativeTitleBar = false;
+    launchOptions.dialogBackgroundColour = DspTestBenchLnF::ApplicationColours::componentBackground();
+    launchOptions.componentToCentreAround = componentToCentreAround;
+    launchOptions.content.setOwned (report);
+    launchOptions.resizable = true;
+    launchOptions.launchAsync();
+}
+void BenchmarkReportComponent::saveResults (const String& extension)
+{
+    fileChooser = std::make_unique<FileChooser> ("Save benchmark results...", File::getSpecialLocation (File::userHomeDirectory).getChildFile ("benchmark" + extension), "*" + extension);
+
+    fileChooser->launchAsync (FileBrowserComponent::saveMode | FileBrowserComponent::warnAboutOverwriting, [this, extension] (const FileChooser& chooser)
+    {
+        const auto file (chooser.getResult());
+        if (file == File())
+            return;
+
+        const auto text = extension == ".csv" ? csvResults : JSON::toString (jsonResults);
+        if (!file.replaceWithText (text))
+            NativeMessageBox::showOkCancelBox (AlertWindow::WarningIcon, "Error saving file", "Unable to save benchmark results", nullptr, nullptr);
+    });
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    BenchmarkReportComponent.h
+    Created: 18 Oct 2026 5:14:39pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkPlot.h"
+#include "../Processing/BenchmarkEnvironment.h"
+
+/**
+ * Shows the results of a benchmark mode which doesn't fit the results grid of the BenchmarkComponent (e.g. a sweep),
+ * as a text report with an optional plot, and allows the results to be saved as CSV or JSON.
+ */
+class BenchmarkReportComponent : public Component
+{
+public:
+
+    BenchmarkReportComponent();
+    ~BenchmarkReportComponent() override = default;
+    void paint (Graphics& g) override;
+    void resized() override;
+
+    void setReportText (const String& text);
+
+    /** Returns the plot (it is hidden unless it has been given some series). */
+    BenchmarkPlot& getPlot();
+    void setPlotSeries (const std::vector<BenchmarkPlot::Series>& series);
+
+    /** Sets the results which can be saved (the buttons are hidden for empty results). */
+    void setExportData (const String& csv, const var& json);
+
+    /** Appends the environment the benchmark ran in to the report & adds it to the JSON results (call this after setReportText() & setExportData()). */
+    void setEnvironment (const BenchmarkEnvironment& environment);
+
+    /** Launches the report in a dialog window (the dialog takes ownership of the report). */
+    static void launch (const String& title, BenchmarkReportComponent* report, Component* componentToCentreAround);
+
+private:
+
+    void saveResults (const String& extension);
+
+    TextEditor txtReport;
+    BenchmarkPlot plot;
+    TextButton btnSaveCsv, btnSaveJson;
+    String csvResults {};
+    var jsonResults {};
+    std::unique_ptr<FileChooser> fileChooser {};
+
+    const Font reportFont = Font (FontOptions (Font::getDefaultMonospacedFontName(), GUI_SIZE_F (0.5f), Font::plain));
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkReportComponent)
+};
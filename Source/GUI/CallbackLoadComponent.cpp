@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    CallbackLoadComponent.cpp
+    Created: 19 Oct 2026 2:07:15am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "CallbackLoadComponent.h"
+#include "../Main.h"
+#include "CallbackTimelineComponent.h"
+
+namespace
+{
+    String toPercent (const float load)
+    {
+        return String (roundToInt (load * 100.0f)) + "%";
+    }
+}
+
+CallbackLoadComponent::CallbackLoadComponent (CallbackLoadMeter* callbackLoadMeter)
+    : meter (callbackLoadMeter)
+{
+    jassert (meter != nullptr);
+    setOpaque (true);
+    updateTooltip();
+    startTimerHz (refreshRateHz);
+}
+void CallbackLoadComponent::paint (Graphics& g)
+{
+    g.fillAll (Colours::black);
+
+    const auto& frame = meter->getLatestFrame();
+    const auto bounds = getLocalBounds().toFloat();
+    const auto w = bounds.getWidth();
+    const auto h = bounds.getHeight();
+
+    // Stack the average load of each stage (clipped to the full width, which is 100% of the period)
+    auto x = 0.0f;
+    for (auto s = 0; s < CallbackLoadMeter::numStages; ++s)
+    {
+        const auto segment = jmin (w - x, frame.averageLoad[static_cast<size_t> (s)] * w);
+        if (segment > 0.0f)
+        {
+            g.setColour (getStageColour (static_cast<CallbackLoadMeter::Stage> (s)));
+            g.fillRect (x, 0.0f, segment, h);
+            x += segment;
+        }
+    }
+
+    // Peak hold marker
+    if (peakHoldLoad > 0.0f)
+    {
+        g.setColour (peakHoldLoad >= 1.0f ? Colours::red : peakHoldLoad >= 0.75f ? Colours::yellow : Colours::white);
+        const auto peakX = jmin (w - 2.0f, peakHoldLoad * w);
+        g.fillRect (peakX, 0.0f, 2.0f, h);
+    }
+
+    g.setColour (Colours::white);
+    g.setFont (Font (FontOptions (h * 0.7f)));
+    g.drawText (toPercent (frame.averageTotalLoad) + " (" + toPercent (peakHoldLoad) + ")", getLocalBounds().reduced (GUI_GAP_I(1), 0), Justification::centredRight, false);
+}
+void CallbackLoadComponent::mouseDown (const MouseEvent& /* event */)
+{
+    CallbackTimelineComponent::launch (meter, getTopLevelComponent());
+}
+Colour CallbackLoadComponent::getStageColour (const CallbackLoadMeter::Stage stage)
+{
+    switch (stage)
+    {
+        case CallbackLoadMeter::sources: return Colours::cornflowerblue;
+        case CallbackLoadMeter::processorA: return Colours::limegreen;
+        case CallbackLoadMeter::processorB: return Colours::darkorange;
+        case CallbackLoadMeter::analyser: return Colours::mediumpurple;
+        case CallbackLoadMeter::monitoring: return Colours::grey;
+        default: return Colours::transparentBlack;
+    }
+}
+void CallbackLoadComponent::timerCallback()
+{
+    // Only update when a new frame was published (e.g. not while the audio device is stopped)
+    if (!meter->update())
+        return;
+
+    const auto& frame = meter->getLatestFrame();
+    const auto now = Time::getMillisecondCounterHiRes() * 0.001;
+    if (frame.peakTotalLoad >= peakHoldLoad)
+    {
+        peakHoldLoad = frame.peakTotalLoad;
+        peakHoldTime = now;
+    }
+    else if (now - peakHoldTime > peakHoldSeconds)
+    {
+        peakHoldLoad = jmax (frame.peakTotalLoad, peakHoldLoad - peakDecayPerSecond / static_cast<float> (refreshRateHz));
+    }
+
+    updateTooltip();
+    repaint();
+}
+void CallbackLoadComponent::updateTooltip()
+{
+    const auto& frame = meter->getLatestFrame();
+
+    String txt;
+    txt << TRANS("Audio callback load as a percentage of the callback period") << " (" << String (frame.callbackPeriodMs, 2) << " ms)"
+        << ", " << TRANS("with the peak of a single callback in brackets") << " (" << TRANS("click for the callback timeline") << ")" << newLine;
+    for (auto s = 0; s < CallbackLoadMeter::numStages; ++s)
+    {
+        const auto stage = static_cast<CallbackLoadMeter::Stage> (s);
+        txt << newLine << CallbackLoadMeter::getStageName (stage) << ": " << toPercent (frame.averageLoad[static_cast<size_t> (s)])
+            << " (" << TRANS("peak") << " " << toPercent (frame.peakLoad[static_cast<size_t> (s)]) << ")";
+    }
+    setTooltip (txt);
+}
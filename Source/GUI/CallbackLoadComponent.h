@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    CallbackLoadComponent.h
+    Created: 19 Oct 2026 2:07:15am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "../Processing/CallbackLoadMeter.h"
+
+/**
+ *  Horizontal bar showing the load of the live audio callback as a percentage of the callback period, stacked by stage (see
+ *  CallbackLoadMeter), with a marker holding the peak load of a single callback for a while before it decays. It also keeps the
+ *  history of the meter up to date, and clicking it shows the callback timeline.
+ */
+class CallbackLoadComponent final : public Component, public SettableTooltipClient, private Timer
+{
+public:
+
+    explicit CallbackLoadComponent (CallbackLoadMeter* callbackLoadMeter);
+    ~CallbackLoadComponent() override = default;
+
+    void paint (Graphics& g) override;
+    void mouseDown (const MouseEvent& event) override;
+
+    static Colour getStageColour (const CallbackLoadMeter::Stage stage);
+
+private:
+
+    void timerCallback() override;
+    void updateTooltip();
+
+    CallbackLoadMeter* meter;
+    float peakHoldLoad = 0.0f;
+    double peakHoldTime = 0.0;
+
+    const double peakHoldSeconds = 1.5;
+    const float peakDecayPerSecond = 0.5f;  // Fraction of the period the peak marker falls per second after the hold
+    const int refreshRateHz = 20;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackLoadComponent)
+};
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    CallbackTimelineComponent.cpp
+    Created: 19 Oct 2026 2:34:08am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "CallbackTimelineComponent.h"
+#include "../Main.h"
+#include "LookAndFeel.h"
+
+CallbackTimelineComponent::CallbackTimelineComponent (CallbackLoadMeter* callbackLoadMeter)
+    : meter (callbackLoadMeter)
+{
+    jassert (meter != nullptr);
+    setSize (900, 400);
+    startTimerHz (10);
+}
+void CallbackTimelineComponent::paint (Graphics& g)
+{
+    using cols = DspTestBenchLnF::ApplicationColours;
+    g.fillAll (cols::componentBackground());
+
+    auto area = getLocalBounds().toFloat().reduced (GUI_GAP_F (2));
+
+    g.setFont (textFont);
+    g.setColour (cols::normalFontColour());
+    const auto lineHeight = textFont.getHeight() * 1.4f;
+    g.drawText (meter->getSummaryText(), area.removeFromTop (lineHeight), Justification::centredLeft, true);
+    g.drawText (meter->getDiagnosisText(), area.removeFromTop (lineHeight), Justification::centredLeft, true);
+    area.removeFromTop (GUI_GAP_F (2));
+
+    // Markers for windows with late callbacks, deadline misses or xruns
+    const auto markerHeight = lineHeight;
+    const auto markerArea = area.removeFromBottom (markerHeight * 3.0f);
+    area.removeFromBottom (GUI_GAP_F (2));
+    const auto laneHeight = (area.getHeight() - GUI_GAP_F (2)) * 0.5f;
+
+    drawLane (g, area.removeFromTop (laneHeight), TRANS("Interval error (max, % of period)"), 1.0f, 0.5f, Colours::cornflowerblue,
+              [] (const CallbackLoadMeter::Frame& f) { return f.callbackPeriodMs > 0.0f ? f.maxIntervalErrorMs / f.callbackPeriodMs : 0.0f; });
+    area.removeFromTop (GUI_GAP_F (2));
+    drawLane (g, area, TRANS("Processing load (max, % of period)"), 1.5f, 1.0f, Colours::limegreen,
+              [] (const CallbackLoadMeter::Frame& f) { return f.peakTotalLoad; });
+
+    const auto& history = meter->getHistory();
+    const auto columnWidth = markerArea.getWidth() / static_cast<float> (CallbackLoadMeter::historyLength);
+    const auto firstColumn = CallbackLoadMeter::historyLength - history.size();
+
+    const auto drawMarkers = [&] (const int row, const String& label, const Colour colour, const std::function<int (const CallbackLoadMeter::Frame&)>& getCount)
+    {
+        const auto rowArea = markerArea.withTrimmedTop (markerHeight * static_cast<float> (row)).withHeight (markerHeight);
+        g.setColour (cols::meterBackground());
+        g.fillRect (rowArea);
+        g.setColour (colour);
+        for (auto i = 0; i < history.size(); ++i)
+            if (getCount (history.getReference (i)) > 0)
+                g.fillRect (rowArea.getX() + static_cast<float> (firstColumn + i) * columnWidth, rowArea.getY() + 1.0f, jmax (2.0f, columnWidth), rowArea.getHeight() - 2.0f);
+        g.setColour (cols::normalFontColour());
+        g.drawText (label, rowArea.reduced (GUI_GAP_F (1), 0.0f), Justification::centredLeft, false);
+    };
+    drawMarkers (0, TRANS("Late callbacks"), Colours::yellow, [] (const CallbackLoadMeter::Frame& f) { return f.windowLateCallbacks; });
+    drawMarkers (1, TRANS("Deadline misses"), Colours::red, [] (const CallbackLoadMeter::Frame& f) { return f.windowDeadlineMisses; });
+    drawMarkers (2, TRANS("Device xruns"), Colours::magenta, [] (const CallbackLoadMeter::Frame& f) { return f.windowXruns; });
+}
+void CallbackTimelineComponent::launch (CallbackLoadMeter* callbackLoadMeter, Component* componentToCentreAround)
+{
+    DialogWindow::LaunchOptions launchOptions;
+    launchOptions.dialogTitle = "Audio callback timeline (last " + String (roundToInt (CallbackLoadMeter::historyLength * CallbackLoadMeter::windowSeconds)) + " seconds)";
+    launchOptions.useNativeTitleBar = false;
+    launchOptions.dialogBackgroundColour = DspTestBenchLnF::ApplicationColours::componentBackground();
+    launchOptions.componentToCentreAround = componentToCentreAround;
+    launchOptions.content.setOwned (new CallbackTimelineComponent (callbackLoadMeter));
+    launchOptions.resizable = true;
+    launchOptions.launchAsync();
+}
+void CallbackTimelineComponent::timerCallback()
+{
+    // The history is updated by the CallbackLoadComponent, so this only needs to repaint
+    repaint();
+}
+void CallbackTimelineComponent::drawLane (Graphics& g, Rectangle<float> area, const String& label, const float maxValue, const float lineValue, Colour colour,
+                                          const std::function<float (const CallbackLoadMeter::Frame&)>& getValue) const
+{
+    using cols = DspTestBenchLnF::ApplicationColours;
+    g.setColour (cols::meterBackground());
+    g.fillRect (area);
+
+    const auto& history = meter->getHistory();
+    const auto columnWidth = area.getWidth() / static_cast<float> (CallbackLoadMeter::historyLength);
+    const auto firstColumn = CallbackLoadMeter::historyLength - history.size();
+    for (auto i = 0; i < history.size(); ++i)
+    {
+        const auto value = getValue (history.getReference (i));
+        const auto h = jmin (1.0f, value / maxValue) * area.getHeight();
+        g.setColour (value > lineValue ? Colours::red : colour);
+        g.fillRect (area.getX() + static_cast<float> (firstColumn + i) * columnWidth, area.getBottom() - h, jmax (1.0f, columnWidth), h);
+    }
+
+    const auto lineY = area.getBottom() - (lineValue / maxValue) * area.getHeight();
+    g.setColour (Colours::white.withAlpha (0.5f));
+    g.drawHorizontalLine (roundToInt (lineY), area.getX(), area.getRight());
+
+    g.setColour (cols::normalFontColour());
+    g.drawText (label + " - " + String (roundToInt (lineValue * 100.0f)) + "% line", area.reduced (GUI_GAP_F (1)), Justification::topLeft, false);
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    CallbackTimelineComponent.h
+    Created: 19 Oct 2026 2:34:08am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "../Processing/CallbackLoadMeter.h"
+
+/**
+ *  Timeline of the rolling history of a CallbackLoadMeter (newest on the right): the largest error in the interval between callbacks
+ *  and the highest processing load in each window, both relative to the block period, with markers for windows containing late
+ *  callbacks, deadline misses and device xruns.
+ */
+class CallbackTimelineComponent final : public Component, private Timer
+{
+public:
+
+    explicit CallbackTimelineComponent (CallbackLoadMeter* callbackLoadMeter);
+    ~CallbackTimelineComponent() override = default;
+
+    void paint (Graphics& g) override;
+
+    /** Launches the timeline in a dialog window. */
+    static void launch (CallbackLoadMeter* callbackLoadMeter, Component* componentToCentreAround);
+
+private:
+
+    void timerCallback() override;
+
+    /** Draws a lane of bars (one per frame, values relative to the block period) with a line at the given level & a label. */
+    void drawLane (Graphics& g, Rectangle<float> area, const String& label, const float maxValue, const float lineValue, Colour colour,
+                   const std::function<float (const CallbackLoadMeter::Frame&)>& getValue) const;
+
+    CallbackLoadMeter* meter;
+
+    const Font textFont = Font (FontOptions (Font::getDefaultMonospacedFontName(), 13.0f, Font::plain));
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackTimelineComponent)
+};
@@ -28,7 +28,7 @@ MainContentComponent::MainContentComponent (AudioDeviceManager& deviceManager)
 // =================================================================================================================================
 
     analyserComponent = std::make_unique<AnalyserComponent>();
-    monitoringComponent = std::make_unique<MonitoringComponent> (&deviceManager, procComponentA.get(), procComponentB.get());
+    monitoringComponent = std::make_unique<MonitoringComponent> (&deviceManager, procComponentA.get(), procComponentB.get(), &callbackLoadMeter);
 
     addAndMakeVisible (srcComponentA.get());
     addAndMakeVisible (srcComponentB.get());
@@ -81,6 +81,7 @@ void MainContentComponent::prepareToPlay (int samplesPerBlockExpected, double sa
     procComponentB->prepare (spec);
     analyserComponent->prepare (spec);
     monitoringComponent->prepare (spec);
+    callbackLoadMeter.prepare (sampleRate);
 }
 void MainContentComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
 {
@@ -89,6 +90,9 @@ void MainContentComponent::getNextAudioBlock (const AudioSourceChannelInfo& buff
     jassert (bufferToFill.numSamples <= srcBufferB.getNumSamples());
     jassert (bufferToFill.numSamples <= tempBuffer.getNumSamples());
 
+    const auto* currentDevice = deviceManager.getCurrentAudioDevice();
+    callbackLoadMeter.beginCallback (bufferToFill.numSamples, currentDevice != nullptr ? currentDevice->getXRunCount() : -1);
+
     dsp::AudioBlock<float> outputBlock (*bufferToFill.buffer, static_cast<size_t>(bufferToFill.startSample));
     
     // Copy current block into source buffers if needed
@@ -100,12 +104,14 @@ void MainContentComponent::getNextAudioBlock (const AudioSourceChannelInfo& buff
     // Generate audio from sources
     srcComponentA->process(dsp::ProcessContextReplacing<float> (srcBufferA));
     srcComponentB->process(dsp::ProcessContextReplacing<float> (srcBufferB));
+    callbackLoadMeter.endStage (CallbackLoadMeter::sources);
 
     // Run audio through processors
     if (procComponentA->isProcessorEnabled())
     {
         routeSourcesAndProcess (procComponentA.get(), tempBuffer);
         outputBlock.copyFrom (tempBuffer);
+        callbackLoadMeter.endStage (CallbackLoadMeter::processorA);
         if (procComponentB->isProcessorEnabled()) // both active
         {
             routeSourcesAndProcess (procComponentB.get(), tempBuffer);
@@ -119,16 +125,20 @@ void MainContentComponent::getNextAudioBlock (const AudioSourceChannelInfo& buff
     }
     else // neither is active
         outputBlock.clear();
+    callbackLoadMeter.endStage (CallbackLoadMeter::processorB);
 
     // Run audio through analyser (note that the analyser isn't expected to alter the outputBlock)
     if (analyserComponent->isProcessing())
         analyserComponent->process (dsp::ProcessContextReplacing<float> (outputBlock));
+    callbackLoadMeter.endStage (CallbackLoadMeter::analyser);
 
     // Run audio through monitoring section
     if (monitoringComponent->isMuted())
         outputBlock.clear();
     else
         monitoringComponent->process (dsp::ProcessContextReplacing<float> (outputBlock));
+    callbackLoadMeter.endStage (CallbackLoadMeter::monitoring);
+    callbackLoadMeter.endCallback();
 
     if (holdAudio.get())
     {
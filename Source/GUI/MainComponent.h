@@ -15,6 +15,7 @@
 #include "ProcessorComponent.h"
 #include "MonitoringComponent.h"
 #include "AnalyserComponent.h"
+#include "../Processing/CallbackLoadMeter.h"
 
 class MainContentComponent final : public AudioAppComponent, public ChangeListener
 {
@@ -43,6 +44,7 @@ private:
 
     ThreadPool threadPool;
     OpenGLContext oglContext;
+    CallbackLoadMeter callbackLoadMeter;
 
     std::unique_ptr<SourceComponent> srcComponentA{};
     std::unique_ptr<SourceComponent> srcComponentB{};
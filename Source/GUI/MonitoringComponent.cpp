@@ -11,11 +11,12 @@
 #include "MonitoringComponent.h"
 #include "../Main.h"
 
-MonitoringComponent::MonitoringComponent (AudioDeviceManager* audioDeviceManager, ProcessorComponent* processorA, ProcessorComponent* processorB)
+MonitoringComponent::MonitoringComponent (AudioDeviceManager* audioDeviceManager, ProcessorComponent* processorA, ProcessorComponent* processorB, CallbackLoadMeter* callbackLoadMeter)
     : deviceManager (audioDeviceManager),
       keyName ("Monitoring"),
       processorComponentA (processorA),
-      processorComponentB (processorB)
+      processorComponentB (processorB),
+      callbackLoad (callbackLoadMeter)
 {
     // Read configuration from application properties
     auto* propertiesFile = DSPTestbenchApplication::getApp().appProperties.getUserSettings();
@@ -48,6 +49,8 @@ MonitoringComponent::MonitoringComponent (AudioDeviceManager* audioDeviceManager
     sldGain.setValue (config->getDoubleAttribute ("OutputGain"));
     sldGain.onValueChange = [this] { monitoringGain.setGainDecibels (static_cast<float> (sldGain.getValue())); };
 
+    addAndMakeVisible (callbackLoad);
+
     addAndMakeVisible (btnCompare);
     btnCompare.setTooltip (TRANS("Toggles muting of processors A & B in turn"));
     btnCompare.setButtonText ("A/B");
@@ -122,12 +125,13 @@ void MonitoringComponent::resized()
     grid.templateRows = {   Track (GUI_BASE_SIZE_PX)
                         };
 
-    grid.templateColumns = { Track (GUI_SIZE_PX(4)), Track (1_fr), Track (GUI_SIZE_PX(1.3)), Track (GUI_SIZE_PX(2.0)), Track (GUI_SIZE_PX(1.7)) };
+    grid.templateColumns = { Track (GUI_SIZE_PX(4)), Track (1_fr), Track (GUI_SIZE_PX(4)), Track (GUI_SIZE_PX(1.3)), Track (GUI_SIZE_PX(2.0)), Track (GUI_SIZE_PX(1.7)) };
 
     grid.autoFlow = Grid::AutoFlow::row;
 
     grid.items.addArray({   GridItem (lblTitle),
                             GridItem (sldGain).withMargin (GridItem::Margin (0.0f, GUI_GAP_F(3), 0.0f, 0.0f)),
+                            GridItem (callbackLoad),
                             GridItem (btnCompare),
                             GridItem (btnLimiter),
                             GridItem (btnMute)
@@ -12,12 +12,13 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "ProcessorComponent.h"
+#include "CallbackLoadComponent.h"
 
 class MonitoringComponent final : public Component, public dsp::ProcessorBase
 {
 public:
 
-    explicit MonitoringComponent (AudioDeviceManager* audioDeviceManager, ProcessorComponent* processorA, ProcessorComponent* processorB);
+    explicit MonitoringComponent (AudioDeviceManager* audioDeviceManager, ProcessorComponent* processorA, ProcessorComponent* processorB, CallbackLoadMeter* callbackLoadMeter);
     ~MonitoringComponent() override;
 
     void paint (Graphics& g) override;
@@ -41,6 +42,7 @@ private:
 
     Label lblTitle;
     Slider sldGain;
+    CallbackLoadComponent callbackLoad;
     TextButton btnCompare;
     TextButton btnLimiter;
     TextButton btnMute;
@@ -29,6 +29,7 @@ ProcessorComponent::ProcessorComponent (const String& processorId, ProcessorHarn
         config->setAttribute ("Disable", false);
         config->setAttribute ("Invert", false);
         config->setAttribute ("Mute", true);
+        config->setAttribute ("NoDenormals", false);
     }
 
     addAndMakeVisible (lblTitle);
@@ -58,6 +59,21 @@ ProcessorComponent::ProcessorComponent (const String& processorId, ProcessorHarn
     btnSourceB.setToggleState (statusSourceB.get(), dontSendNotification);
     btnSourceB.onClick = [this] { statusSourceB = btnSourceB.getToggleState(); };
 
+    addAndMakeVisible (lblSubnormals);
+    lblSubnormals.setTooltip ("Number of subnormal (denormal) output samples per second");
+    lblSubnormals.setJustificationType (Justification::centredRight);
+    lblSubnormals.setColour (Label::textColourId, Colours::darkorange);
+
+    addAndMakeVisible (btnNoDenormals);
+    btnNoDenormals.setTooltip (TRANS("Process with flush-to-zero & denormals-are-zero enabled (as ScopedNoDenormals would), "
+                                     "to check whether the processor needs denormal protection"));
+    btnNoDenormals.setButtonText (TRANS("FTZ"));
+    btnNoDenormals.setClickingTogglesState (true);
+    btnNoDenormals.setColour (TextButton::buttonOnColourId, Colours::darkorange);
+    statusNoDenormals.set (config->getBoolAttribute ("NoDenormals"));
+    btnNoDenormals.setToggleState (statusNoDenormals.get(), dontSendNotification);
+    btnNoDenormals.onClick = [this] { statusNoDenormals = btnNoDenormals.getToggleState(); };
+
     addAndMakeVisible (btnDisable);
     btnDisable.setButtonText (TRANS("Disable"));
     btnDisable.setClickingTogglesState (true);
@@ -98,6 +114,8 @@ ProcessorComponent::ProcessorComponent (const String& processorId, ProcessorHarn
     viewport.setScrollBarsShown (true, false);
     viewport.setViewedComponent (&controlArrayComponent);
     addAndMakeVisible (viewport);
+
+    startTimer (1000);
 }
 ProcessorComponent::~ProcessorComponent()
 {
@@ -107,6 +125,7 @@ ProcessorComponent::~ProcessorComponent()
     config->setAttribute ("Disable", statusDisable.get());
     config->setAttribute ("Invert", statusInvert.get());
     config->setAttribute ("Mute", statusMute.get());
+    config->setAttribute ("NoDenormals", statusNoDenormals.get());
 
     // Save configuration to application properties
     auto* propertiesFile = DSPTestbenchApplication::getApp().appProperties.getUserSettings();
@@ -129,19 +148,20 @@ void ProcessorComponent::resized()
         Track (GUI_SIZE_PX(0.2)),   // Blank row
         Track (1_fr)                // Remainder used for viewport
     };
-    grid.templateColumns = { Track (GUI_SIZE_PX(3)), Track (GUI_SIZE_PX(1.5)), Track (1_fr), Track (GUI_SIZE_PX(1.8)), Track (GUI_SIZE_PX(1.8)), Track(GUI_BASE_GAP_PX), Track (GUI_SIZE_PX(2.2)), Track (GUI_SIZE_PX(2)), Track (GUI_SIZE_PX(1.7)) };
+    grid.templateColumns = { Track (GUI_SIZE_PX(3)), Track (GUI_SIZE_PX(1.5)), Track (1_fr), Track (GUI_SIZE_PX(1.8)), Track (GUI_SIZE_PX(1.8)), Track(GUI_BASE_GAP_PX), Track (GUI_SIZE_PX(1.7)), Track (GUI_SIZE_PX(2.2)), Track (GUI_SIZE_PX(2)), Track (GUI_SIZE_PX(1.7)) };
     grid.autoFlow = Grid::AutoFlow::row;
     grid.items.addArray({  
         GridItem (lblTitle).withArea ({}, GridItem::Span (2)),
-        GridItem(),
+        GridItem (lblSubnormals),
         GridItem (btnSourceA),
         GridItem (btnSourceB),
         GridItem(),
+        GridItem (btnNoDenormals),
         GridItem (btnDisable),
         GridItem (btnInvert),
         GridItem (btnMute),
-        GridItem().withArea ({}, GridItem::Span (9)), // Blank row
-        GridItem (viewport).withArea ({}, GridItem::Span (9))
+        GridItem().withArea ({}, GridItem::Span (10)), // Blank row
+        GridItem (viewport).withArea ({}, GridItem::Span (10))
     });
 
     grid.performLayout (getLocalBounds().reduced (GUI_GAP_I(2), GUI_GAP_I(2)));
@@ -162,6 +182,11 @@ float ProcessorComponent::getPreferredHeight() const
 
     return  jmin (height, maxHeight);
 }
+void ProcessorComponent::timerCallback()
+{
+    const auto count = subnormalOutputs.exchange (0);
+    lblSubnormals.setText (count > 0 ? String (count) + " subnormals/s" : String(), dontSendNotification);
+}
 void ProcessorComponent::prepare (const dsp::ProcessSpec& spec)
 {
     if (processor)
@@ -170,7 +195,14 @@ void ProcessorComponent::prepare (const dsp::ProcessSpec& spec)
 void ProcessorComponent::process (const dsp::ProcessContextReplacing<float>& context)
 {
     if (processor)
+    {
+        // Set the floating point mode explicitly, as the audio thread may have been left with FTZ/DAZ on or off by the driver
+        const auto denormalsWereDisabled = FloatVectorOperations::areDenormalsDisabled();
+        FloatVectorOperations::disableDenormalisedNumberSupport (statusNoDenormals.get());
         processor->processHarness (context);
+        FloatVectorOperations::disableDenormalisedNumberSupport (denormalsWereDisabled);
+        subnormalOutputs += ProcessorHarness::countSubnormals (context.getOutputBlock());
+    }
     if (statusMute.get())
         context.getOutputBlock().clear();
 }
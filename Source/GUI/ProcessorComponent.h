@@ -13,7 +13,7 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "../Processing/ProcessorHarness.h"
 
-class ProcessorComponent final : public Component, dsp::ProcessorBase
+class ProcessorComponent final : public Component, dsp::ProcessorBase, private Timer
 {
 public:
     
@@ -23,6 +23,7 @@ public:
     void paint (Graphics& g) override;
     void resized() override;
     float getPreferredHeight() const;
+    void timerCallback() override;
 
     void prepare (const dsp::ProcessSpec& spec) override;
     void process (const dsp::ProcessContextReplacing<float>& context) override;
@@ -78,6 +79,7 @@ private:
     Label lblTitle;
     TextButton btnSourceA;
     TextButton btnSourceB;
+    TextButton btnNoDenormals;
     TextButton btnDisable;
     TextButton btnInvert;
     TextButton btnMute;
@@ -89,6 +91,10 @@ private:
     Atomic<bool> statusDisable = false;
     Atomic<bool> statusInvert = false;
     Atomic<bool> statusMute = false;
+    Atomic<bool> statusNoDenormals = false;
+
+    Label lblSubnormals;
+    Atomic<int64> subnormalOutputs = 0;     /**< Subnormal output samples since the last timer callback. */
 
     Viewport viewport;
     OwnedArray<ControlComponent> controlArray {};
@@ -0,0 +1,746 @@
+/*
+  ==============================================================================
+
+    HeadlessMain.cpp
+    Created: 18 Oct 2026 10:03:18am
+    Author:  Andrew
+
+    Command line benchmark runner which doesn't need a display or an audio
+    device. See the README for the available options.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "../Processing/BenchmarkRunner.h"
+#include "../Processing/BenchmarkBaseline.h"
+#include "../Processing/BenchmarkSweep.h"
+#include "../Processing/BenchmarkComparison.h"
+#include "../Processing/BenchmarkMultiInstance.h"
+#include "../Processing/BenchmarkColdWarm.h"
+#include "../Processing/BenchmarkAlignmentSweep.h"
+#include "../Processing/BenchmarkDenormals.h"
+#include "../Processing/BenchmarkBlockPatterns.h"
+#include "../Processing/BenchmarkAutomation.h"
+#include "../Processing/BenchmarkControlSweep.h"
+#include "../Processing/BenchmarkStimuli.h"
+#include "../Processing/BenchmarkIsolation.h"
+#include "../Processing/BenchmarkEnvironment.h"
+#include "../Processing/ProcessorExamples.h"
+#include "../Processing/PolyBLEP.h"
+#include "../Processing/NoiseGenerators.h"
+#include "../Processing/PulseFunctions.h"
+#include <sstream>
+
+namespace
+{
+    /** Returns a new processor harness for the given name, or nullptr if the name is "none" or not recognised. */
+    ProcessorHarness* createProcessor (const String& name)
+    {
+// =================================================================================================================================
+// +++      Here is where to add the processors being tested so they can be selected from the command line                   +++
+// =================================================================================================================================
+        if (name.equalsIgnoreCase ("LPF"))  return new LpfExample();
+        if (name.equalsIgnoreCase ("Thru")) return new ThruExample();
+// =================================================================================================================================
+        return nullptr;
+    }
+
+    const StringArray processorNames = { "LPF", "Thru" };
+    const StringArray signalNames = { "sine", "white", "pink", "impulse", "silence" };
+
+    /** Fills the block with the test signal (the same block is repeated for every iteration, as per the BenchmarkComponent). */
+    bool fillWithSignal (dsp::AudioBlock<float>& block, const dsp::ProcessSpec& spec, const String& signal, const double frequency)
+    {
+        const dsp::ProcessContextReplacing<float> context (block);
+        if (signal == "sine")
+        {
+            dsp::PolyBlepOscillator<float> oscillator (dsp::PolyBlepOscillator<float>::sine);
+            oscillator.prepare (spec);
+            oscillator.setFrequency (static_cast<float> (frequency), true);
+            oscillator.process (context);
+        }
+        else if (signal == "white")
+        {
+            dsp::WhiteNoiseGenerator whiteNoise;
+            whiteNoise.reset();
+            whiteNoise.process (context);
+        }
+        else if (signal == "pink")
+        {
+            dsp::PinkNoiseGenerator pinkNoise;
+            pinkNoise.process (context);
+        }
+        else if (signal == "impulse")
+        {
+            dsp::ImpulseFunction<float> impulse;
+            impulse.setPreDelay (0);
+            impulse.prepare (spec);
+            impulse.process (context);
+        }
+        else if (signal == "silence")
+            block.clear();
+        else
+            return false;
+        return true;
+    }
+
+    /** Writes text to the given file, or to stdout if the file name is "-". */
+    bool writeOutput (const String& fileName, const String& text)
+    {
+        if (fileName == "-")
+        {
+            std::cout << text << std::endl;
+            return true;
+        }
+        const auto file = File::getCurrentWorkingDirectory().getChildFile (fileName);
+        return file.replaceWithText (text);
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: DSPTestbenchHeadless [options]" << std::endl
+                  << "  --a=<name>            Processor for slot A (default LPF, or none)" << std::endl
+                  << "  --b=<name>            Processor for slot B (default Thru, or none)" << std::endl
+                  << "  --sample-rate=<hz>    Sample rate (default 44100)" << std::endl
+                  << "  --block-size=<n>      Maximum block size (default 1024)" << std::endl
+                  << "  --channels=<n>        Number of channels (default 2)" << std::endl
+                  << "  --cycles=<n>          Full test cycles - reset, prepare, processing (default 10)" << std::endl
+                  << "  --iterations=<n>      Process iterations within each cycle (default 1000)" << std::endl
+                  << "  --timer=<name>        juce | tsc | monotonic-raw (default juce)" << std::endl
+                  << "  --signal=<name>       " << signalNames.joinIntoString (" | ") << " (default sine)" << std::endl
+                  << "  --frequency=<hz>      Frequency of sine signal (default 1000)" << std::endl
+                  << "  --buffer-offset=<n>   Byte offset of the channel buffers from a 64 byte boundary (multiple of 4, default 0)" << std::endl
+                  << "  --channel-padding=<n> Extra bytes between channel buffers (multiple of 4, default 0)" << std::endl
+                  << "  --perf-counters       Count cycles, instructions, cache & branch misses (Linux perf_event_open)" << std::endl
+                  << "  --rt-guard            Count allocations & locks made by process & reset (exits with 3 if there are any, needs DSP_TESTBENCH_RT_GUARD)" << std::endl
+                  << "  --rt-guard-stacks     As --rt-guard, and capture the stack traces of the violations" << std::endl
+                  << "  --warmup=<n|auto>     Process calls after each prepare left out of the statistics & reported on their own (default 0)" << std::endl
+                  << "  --outlier-factor=<x>  Report process calls slower than x times the median as outliers (default 10)" << std::endl
+                  << "  --rusage              Count page faults, context switches & peak RSS growth of each routine (getrusage, Linux & macOS)" << std::endl
+                  << "  --sections            Time the sections marked with DSP_TESTBENCH_SECTION in the processors' process methods" << std::endl
+                  << "  --cpu=<n>             Pin the benchmark thread to CPU n (Linux & Windows)" << std::endl
+                  << "  --sched=<policy>      normal | fifo | rr - real-time scheduling policy for the benchmark thread (default normal)" << std::endl
+                  << "  --priority=<n>        Real-time priority for --sched=fifo or rr (1 to 99, default 80)" << std::endl
+                  << "  --mlock               Lock the process memory into RAM so the benchmark can't page fault (Linux)" << std::endl
+                  << "  --cache=<state>       warm | cold | cold-code - evict data (& code) caches before each process call (default warm)" << std::endl
+                  << "  --cache-compare       Run warm & then cold (as per --cache, default cold) and report them side by side" << std::endl
+                  << "  --sweep               Sweep over a grid of block sizes, channels & sample rates (ignores the single spec options)" << std::endl
+                  << "  --sweep-block-sizes=<list>   Block sizes to sweep (default 16,32,...,8192)" << std::endl
+                  << "  --sweep-channels=<list>      Channel counts to sweep (default 1,2,8,64)" << std::endl
+                  << "  --sweep-sample-rates=<list>  Sample rates to sweep (default 44100,96000,384000)" << std::endl
+                  << "  --compare             Interleaved A/B comparison in rounds of --iterations calls (ignores --cycles)" << std::endl
+                  << "  --target-precision=<x>       Stop comparing once the ratio's 95% CI is within +/- x (default 0.01)" << std::endl
+                  << "  --max-rounds=<n>             Maximum number of comparison rounds (default 500)" << std::endl
+                  << "  --multi-instance      Run 1, 2, 4 ... concurrent instances in lock-step for --iterations calls (ignores --cycles)" << std::endl
+                  << "  --max-instances=<n>          Maximum number of instances (default & limit is the number of CPUs)" << std::endl
+                  << "  --denormals           Feed noise decaying to silence with & without FTZ/DAZ, --cycles times (ignores --iterations)" << std::endl
+                  << "  --decay-seconds=<s>          Length of the decay (default 1)" << std::endl
+                  << "  --silence-seconds=<s>        Length of the silence after the decay (default 4)" << std::endl
+                  << "  --block-patterns      Feed fixed, random, DAW split & single sample block sizes, --iterations buffers --cycles times" << std::endl
+                  << "  --max-splits=<n>             Maximum split points per host buffer in the DAW split pattern (default 3)" << std::endl
+                  << "  --automation          Change one or all controls every block, every N samples or on a ramp, vs static controls" << std::endl
+                  << "  --automation-interval=<n>    Samples between control changes (default 32)" << std::endl
+                  << "  --automation-control=<i>     Index of the control automated on its own (default 0)" << std::endl
+                  << "  --control-sweep       Run with each control (or a pair of controls) stepped from 0 to 1, others at their defaults" << std::endl
+                  << "  --control-steps=<n>          Number of values each control is stepped through (default 11)" << std::endl
+                  << "  --control-pair=<x[,y]>       Sweep control x on its own, or controls x & y together (default each control)" << std::endl
+                  << "  --stimuli             Feed each input signal, regenerated before every call, --iterations blocks --cycles times (ignores --signal)" << std::endl
+                  << "  --stimulus-set=<list>        silence, sine, white, pink, impulses, denormal, nan-inf, changing (default all)" << std::endl
+                  << "  --alignment-sweep     Run at a range of buffer offsets & channel paddings (ignores --buffer-offset & --channel-padding)" << std::endl
+                  << "  --alignment-offsets=<list>   Buffer offsets to sweep (default 0,4,...,60)" << std::endl
+                  << "  --channel-paddings=<list>    Channel paddings to sweep (default 0,4,64)" << std::endl
+                  << "  --save-baseline=<name>       Save the results as a named baseline (single spec runs only)" << std::endl
+                  << "  --baseline=<name>            Compare the results against a named baseline (single spec runs only, exits with 4 if there are regressions)" << std::endl
+                  << "  --baseline-dir=<dir>         Directory of the baselines (default baselines)" << std::endl
+                  << "  --tolerances=<list>          [routine.]metric:fraction list (default process avg:0.1, min:0.1, p50:0.1, p99:0.25)" << std::endl
+                  << "  --revision=<rev>             Revision recorded in a saved baseline (default from git)" << std::endl
+                  << "  --baseline-json=<file>       Write the baseline comparison as JSON (use - for stdout)" << std::endl
+                  << "  --json=<file>         Write results as JSON (use - for stdout)" << std::endl
+                  << "  --csv=<file>          Write results as CSV (use - for stdout)" << std::endl
+                  << "  --list                List available processors" << std::endl;
+    }
+
+    void printSummary (std::ostream& out, const std::vector<ProcessorHarness*>& harnesses)
+    {
+        const StringArray routines = { "Prepare", "Process", "Reset" };
+
+        // A routine which hasn't run still has the harness's min/max sentinels, so its statistics are shown as missing
+        const auto us = [] (const ProcessorHarness& harness, const int routine, const int valueIndex)
+        {
+            if (harness.queryByIndex (routine, 3) <= 0.0)
+                return String ("-");
+            return String (harness.queryByIndex (routine, valueIndex) * 1000.0, 1);
+        };
+
+        for (auto h = 0; h < static_cast<int> (harnesses.size()); ++h)
+        {
+            if (auto* harness = harnesses[h])
+            {
+                out << "Processor " << BenchmarkRunner::getSlotName (h) << " (" << harness->getProcessorName() << ")" << std::endl;
+                for (auto r = 0; r < routines.size(); ++r)
+                {
+                    out << "  " << routines[r].paddedRight (' ', 8)
+                        << " min " << us (*harness, r, 0).paddedLeft (' ', 10)
+                        << " us, avg " << us (*harness, r, 1).paddedLeft (' ', 10)
+                        << " us, max " << us (*harness, r, 2).paddedLeft (' ', 10)
+                        << " us, # " << static_cast<int64> (harness->queryByIndex (r, 3)) << std::endl;
+                    if (harness->queryByIndex (r, 3) > 1.0)
+                    {
+                        out << "          ";
+                        for (auto v = 4; v < ProcessorHarness::numQueryValues; ++v)
+                            out << " " << ProcessorHarness::getQueryValueName (v) << " "
+                                << us (*harness, r, v) << " us";
+                        out << std::endl;
+                    }
+                }
+
+                // The minimum is the most repeatable figure (and the baseline gates on it), so a zero is called out rather than
+                // passed on silently: it means the calls were quicker than the timer resolution after the overhead compensation
+                if (harness->queryProcessingDurationNumSamples() > 0.0 && harness->queryProcessingDurationMin() <= 0.0)
+                    out << "  Process  minimum is 0 us (below the timer resolution), so it can't be compared" << std::endl;
+
+                const auto classifierText = harness->getIterationClassifier().getSummaryText (harness->queryProcessingDurationPercentile (50.0));
+                if (classifierText.isNotEmpty())
+                    out << "  Process  " << classifierText << std::endl;
+
+                const auto budget = RealtimeBudget::forProcessing (*harness);
+                if (budget.isValid())
+                {
+                    out << "  Budget   " << String (budget.budgetMs * 1000.0, 1) << " us, used avg " << String (budget.meanFraction * 100.0, 1)
+                        << "%, p99 " << String (budget.p99Fraction * 100.0, 1) << "%, p99.9 " << String (budget.p99_9Fraction * 100.0, 1)
+                        << "%, max " << String (budget.maxFraction * 100.0, 1) << "%, deadline misses " << static_cast<int64> (budget.deadlineMisses)
+                        << ", max instances " << budget.maxInstancesAtP99 << " (p99) / " << budget.maxInstancesAtMean << " (avg)" << std::endl;
+                }
+
+                const auto& totals = harness->getPerformanceCounterTotals();
+                if (totals.numSamples > 0.0)
+                {
+                    out << "  Counters IPC " << String (totals.getInstructionsPerCycle(), 2) << ", per sample:";
+                    for (auto c = 0; c < PerformanceCounters::numCounters; ++c)
+                    {
+                        const auto counter = static_cast<PerformanceCounters::Counter> (c);
+                        const auto perSample = totals.getPerSample (counter);
+                        out << " " << PerformanceCounters::getCounterName (counter).toLowerCase() << " "
+                            << (std::isfinite (perSample) ? String (perSample, 3) : String ("n/a"))
+                            << (c < PerformanceCounters::numCounters - 1 ? "," : "");
+                    }
+                    out << std::endl;
+                }
+
+                for (auto r = 0; r < routines.size(); ++r)
+                {
+                    if (const auto* violations = harness->getRealtimeViolations (r))
+                    {
+                        out << "  RT guard " << routines[r] << ": " << RealtimeGuard::getCountsText (*violations) << std::endl;
+                        for (const auto& trace : violations->getStackTraceDescriptions())
+                            out << trace;
+                    }
+                }
+
+                for (auto r = 0; r < routines.size(); ++r)
+                    if (const auto* usage = harness->getResourceUsage (r))
+                        out << "  Resources " << routines[r] << ": " << ResourceUsage::getTotalsText (*usage) << std::endl;
+
+                if (const auto* profiler = harness->getSectionProfiler())
+                {
+                    if (profiler->getNumSections() > 0)
+                    {
+                        out << "  Sections (per process call)" << std::endl;
+                        for (const auto& line : StringArray::fromLines (profiler->getTreeText (harness->queryProcessingDurationAverage()).trimEnd()))
+                            out << "    " << line << std::endl;
+                    }
+                    else
+                    {
+                        out << "  Sections none (mark them with DSP_TESTBENCH_SECTION in process)" << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    /** Returns true if any of the guarded routines of the harnesses made a real-time violation at any point of the run. */
+    bool hasRealtimeViolations (const std::vector<ProcessorHarness*>& harnesses)
+    {
+        for (auto* harness : harnesses)
+            if (harness && harness->getRealtimeViolationsSinceEnabled() > 0)
+                return true;
+        return false;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    const ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+    if (args.containsOption ("--list"))
+    {
+        std::cout << processorNames.joinIntoString ("\n") << std::endl;
+        return 0;
+    }
+
+    // Each mode runs a different benchmark, so a second mode would otherwise be silently ignored
+    StringArray modes;
+    for (const auto* mode : { "--compare", "--multi-instance", "--cache-compare", "--denormals", "--block-patterns",
+                              "--automation", "--control-sweep", "--stimuli", "--alignment-sweep", "--sweep" })
+        if (args.containsOption (mode))
+            modes.add (mode);
+    if (modes.size() > 1)
+    {
+        std::cerr << "Only one mode can be run at a time (" << modes.joinIntoString (", ") << " were given)" << std::endl;
+        return 1;
+    }
+
+    // Baselines are only recorded & checked for single spec runs, so don't let a mode skip the gate without saying so
+    if (modes.size() > 0 && args.containsOption ("--baseline|--save-baseline|--tolerances|--baseline-json"))
+    {
+        std::cerr << "The baseline options can only be used with a single spec run (not with " << modes[0] << ")" << std::endl;
+        return 1;
+    }
+
+    const auto getOption = [&args] (const String& option, const String& defaultValue)
+    {
+        const auto value = args.getValueForOption (option);
+        return value.isEmpty() ? defaultValue : value;
+    };
+
+    const dsp::ProcessSpec spec {
+        getOption ("--sample-rate", "44100").getDoubleValue(),
+        static_cast<uint32> (getOption ("--block-size", "1024").getIntValue()),
+        static_cast<uint32> (getOption ("--channels", "2").getIntValue())
+    };
+    const auto testCycles = getOption ("--cycles", "10").getIntValue();
+    const auto processingIterations = getOption ("--iterations", "1000").getIntValue();
+    if (spec.sampleRate <= 0.0 || spec.maximumBlockSize == 0 || spec.numChannels == 0 || testCycles <= 0 || processingIterations <= 0)
+    {
+        std::cerr << "Invalid benchmark settings" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    const auto nameA = getOption ("--a", "LPF");
+    const auto nameB = getOption ("--b", "Thru");
+    std::unique_ptr<ProcessorHarness> processorA (createProcessor (nameA));
+    std::unique_ptr<ProcessorHarness> processorB (createProcessor (nameB));
+    if ((!processorA && !nameA.equalsIgnoreCase ("none")) || (!processorB && !nameB.equalsIgnoreCase ("none")) || (!processorA && !processorB))
+    {
+        std::cerr << "No valid processors selected (use --list to see the available processors)" << std::endl;
+        return 1;
+    }
+    const std::vector<ProcessorHarness*> harnesses = { processorA.get(), processorB.get() };
+    for (auto* h : harnesses)
+    {
+        if (h)
+        {
+            for (auto i = 0; i < h->getNumControls(); ++i)
+                h->setControlValue (i, h->getDefaultControlValue (i));
+            h->resetStatistics();
+        }
+    }
+
+    const auto timerName = getOption ("--timer", "juce");
+    auto timingSource = BenchmarkTimer::Source::juceHighResolution;
+    if (timerName == "tsc")
+        timingSource = BenchmarkTimer::Source::tsc;
+    else if (timerName == "monotonic-raw")
+        timingSource = BenchmarkTimer::Source::monotonicRaw;
+    else if (timerName != "juce")
+    {
+        std::cerr << "Unknown timer (use one of juce, tsc, monotonic-raw)" << std::endl;
+        return 1;
+    }
+    if (!BenchmarkTimer::isSourceAvailable (timingSource))
+    {
+        std::cerr << "Timer " << BenchmarkTimer::getSourceName (timingSource) << " is not available on this machine" << std::endl;
+        return 1;
+    }
+
+    const auto cacheName = getOption ("--cache", "warm");
+    auto cacheState = BenchmarkRunner::CacheState::warm;
+    if (cacheName == "cold")
+        cacheState = BenchmarkRunner::CacheState::cold;
+    else if (cacheName == "cold-code")
+        cacheState = BenchmarkRunner::CacheState::coldWithInstructionCache;
+    else if (cacheName != "warm")
+    {
+        std::cerr << "Unknown cache state (use one of warm, cold, cold-code)" << std::endl;
+        return 1;
+    }
+
+    BenchmarkIsolation isolation;
+    const auto scheduling = BenchmarkIsolation::parseScheduling (getOption ("--sched", "normal"));
+    const auto priority = getOption ("--priority", String (BenchmarkIsolation::defaultPriority)).getIntValue();
+    const auto cpu = getOption ("--cpu", "-1").getIntValue();
+    if (scheduling == 0 || priority < 1 || priority > 99 || cpu >= SystemStats::getNumCpus())
+    {
+        std::cerr << "Invalid isolation settings (--sched is one of normal, fifo, rr, --priority is 1 to 99 & --cpu below "
+                  << SystemStats::getNumCpus() << ")" << std::endl;
+        return 1;
+    }
+    isolation.setCpu (cpu);
+    isolation.setScheduling (static_cast<BenchmarkIsolation::Scheduling> (scheduling), priority);
+    isolation.setMemoryLocked (args.containsOption ("--mlock"));
+
+    BenchmarkRunner runner;
+    runner.setTimingSource (timingSource);
+    runner.setCacheState (cacheState);
+    const auto bufferOffset = getOption ("--buffer-offset", "0").getIntValue();
+    const auto channelPadding = getOption ("--channel-padding", "0").getIntValue();
+    if (bufferOffset < 0 || bufferOffset >= 64 || bufferOffset % 4 != 0 || channelPadding < 0 || channelPadding % 4 != 0)
+    {
+        std::cerr << "The buffer offset must be a multiple of 4 below 64, and the channel padding a non-negative multiple of 4" << std::endl;
+        return 1;
+    }
+    runner.setBufferLayout (bufferOffset, channelPadding);
+    runner.setTestCycles (testCycles);
+    runner.setProcessingIterations (processingIterations);
+    runner.setProcessSpec (spec);
+    runner.setPerformanceCountersEnabled (args.containsOption ("--perf-counters"));
+    const auto captureStackTraces = args.containsOption ("--rt-guard-stacks");
+    if (args.containsOption ("--rt-guard") || captureStackTraces)
+    {
+        if (!RealtimeGuard::isCompiledIn())
+        {
+            std::cerr << "The real-time guard isn't built in (configure with -DDSP_TESTBENCH_RT_GUARD=ON)" << std::endl;
+            return 1;
+        }
+        if (!RealtimeGuard::canDetectMalloc())
+            std::cerr << "Only operator new & delete can be intercepted on this platform (malloc, free & locks are not detected)" << std::endl;
+        for (auto* h : harnesses)
+            if (h) h->setRealtimeGuardEnabled (true, captureStackTraces);
+    }
+    const auto warmupName = getOption ("--warmup", "0");
+    const auto warmup = warmupName == "auto" ? IterationClassifier::autoWarmup : warmupName.getIntValue();
+    const auto outlierFactor = getOption ("--outlier-factor", String (IterationClassifier::defaultOutlierFactor)).getDoubleValue();
+    if ((warmupName != "auto" && (!warmupName.containsOnly ("0123456789") || warmup < 0)) || outlierFactor <= 1.0)
+    {
+        std::cerr << "Invalid warm-up settings (--warmup is a number of calls or auto & --outlier-factor is above 1)" << std::endl;
+        return 1;
+    }
+    for (auto* h : harnesses)
+    {
+        if (h)
+        {
+            h->setWarmup (warmup);
+            h->setOutlierFactor (outlierFactor);
+        }
+    }
+    if (args.containsOption ("--rusage"))
+    {
+        if (!ResourceUsage::isSupported())
+            std::cerr << "Resource usage isn't available on this platform" << std::endl;
+        for (auto* h : harnesses)
+            if (h) h->setResourceUsageEnabled (ResourceUsage::isSupported());
+    }
+    if (args.containsOption ("--sections"))
+    {
+        if (!SectionProfiler::isCompiledIn())
+            std::cerr << "Section profiling was compiled out (DSP_TESTBENCH_SECTION_PROFILING is 0)" << std::endl;
+        for (auto* h : harnesses)
+            if (h) h->setSectionProfilingEnabled (SectionProfiler::isCompiledIn());
+    }
+    const auto signal = getOption ("--signal", "sine");
+    const auto frequency = getOption ("--frequency", "1000").getDoubleValue();
+    if (!fillWithSignal (runner.getAudioBlock(), spec, signal, frequency))
+    {
+        std::cerr << "Unknown signal (use one of " << signalNames.joinIntoString (", ") << ")" << std::endl;
+        return 1;
+    }
+
+    // Keep stdout clean for machine readable output if it has been requested there
+    const auto resultsToStdout = args.getValueForOption ("--json") == "-" || args.getValueForOption ("--csv") == "-"
+                              || args.getValueForOption ("--baseline-json") == "-";
+    auto& summaryStream = resultsToStdout ? std::cerr : std::cout;
+
+    // The isolation is applied to the main thread, which runs every mode (other than the multi-instance threads), for the rest of the process
+    if (isolation.isEnabled())
+    {
+        if (isolation.apply())
+            summaryStream << "Isolation: " << isolation.getStatus() << std::endl << std::endl;
+        else
+            std::cerr << "Warning: not all of the isolation settings could be applied: " << isolation.getStatus() << std::endl << std::endl;
+    }
+
+    // Warnings found at the start are printed with the environment, so only those which appear during the run are printed after it
+    BenchmarkEnvironment environment;
+    environment.captureStart();
+    summaryStream << environment.getSummaryText() << std::endl;
+    const auto startWarnings = environment.getWarnings();
+    const auto reportEnvironment = [&environment, &startWarnings, &summaryStream]
+    {
+        environment.captureEnd();
+        for (const auto& warning : environment.getWarnings())
+            if (!startWarnings.contains (warning))
+                summaryStream << "Warning: " << warning << std::endl;
+    };
+
+    // Every mode finishes by printing its results & the environment, then writing the results (the environment is added to the JSON)
+    const auto writeResults = [&args, &environment, &summaryStream, &reportEnvironment] (const String& resultsText, const var& resultsJson, const String& resultsCsv)
+    {
+        summaryStream << resultsText;
+        reportEnvironment();
+
+        auto ok = true;
+        if (args.containsOption ("--json"))
+            ok = writeOutput (args.getValueForOption ("--json"), JSON::toString (environment.addToResults (resultsJson))) && ok;
+        if (args.containsOption ("--csv"))
+            ok = writeOutput (args.getValueForOption ("--csv"), resultsCsv) && ok;
+        return ok;
+    };
+    // Failing to write the results takes precedence over a regression, which takes precedence over real-time violations (in any mode)
+    const auto getExitCode = [&harnesses] (const bool ok, const bool regressed = false)
+    {
+        if (!ok)
+            return 2;
+        if (regressed)
+            return 4;
+        return hasRealtimeViolations (harnesses) ? 3 : 0;
+    };
+
+    if (args.containsOption ("--compare"))
+    {
+        const auto targetPrecision = getOption ("--target-precision", "0.01").getDoubleValue();
+        const auto maxRounds = getOption ("--max-rounds", "500").getIntValue();
+        if (!processorA || !processorB || targetPrecision <= 0.0 || maxRounds < 20)
+        {
+            std::cerr << "A comparison needs processors in both slots, a positive target precision and at least 20 rounds" << std::endl;
+            return 1;
+        }
+
+        BenchmarkComparison comparison;
+        comparison.setBatchIterations (processingIterations);
+        comparison.setTargetPrecision (targetPrecision);
+        comparison.setRoundLimits (20, maxRounds);
+        for (auto* h : harnesses)
+            h->setTimingSource (timingSource);
+        comparison.run (*processorA, *processorB, spec, runner.getAudioBlock());
+        return getExitCode (writeResults (comparison.getResultAsText(), comparison.getResultAsJson(), comparison.getRoundsAsCsv()));
+    }
+
+    if (args.containsOption ("--multi-instance"))
+    {
+        BenchmarkMultiInstance multiInstance;
+        if (args.containsOption ("--max-instances"))
+            multiInstance.setMaxInstances (args.getValueForOption ("--max-instances").getIntValue());
+        multiInstance.setIterations (processingIterations);
+        multiInstance.setTimingSource (timingSource);
+        multiInstance.run (harnesses, spec, runner.getAudioBlock());
+        return getExitCode (writeResults (multiInstance.getResultsAsText(), multiInstance.getResultsAsJson(), multiInstance.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--cache-compare"))
+    {
+        BenchmarkColdWarm coldWarm;
+        coldWarm.setColdState (cacheState == BenchmarkRunner::CacheState::warm ? BenchmarkRunner::CacheState::cold : cacheState);
+        coldWarm.run (runner, harnesses);
+        if (runner.getPerformanceCountersError().isNotEmpty())
+            std::cerr << "Performance counters unavailable: " << runner.getPerformanceCountersError() << std::endl;
+        return getExitCode (writeResults (coldWarm.getResultsAsText(), coldWarm.getResultsAsJson(), coldWarm.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--denormals"))
+    {
+        const auto decaySeconds = getOption ("--decay-seconds", "1").getDoubleValue();
+        const auto silenceSeconds = getOption ("--silence-seconds", "4").getDoubleValue();
+        if (decaySeconds <= 0.0 || silenceSeconds <= 0.0)
+        {
+            std::cerr << "The decay & silence lengths must be positive" << std::endl;
+            return 1;
+        }
+
+        BenchmarkDenormals denormals;
+        denormals.setDecaySeconds (decaySeconds);
+        denormals.setSilenceSeconds (silenceSeconds);
+        denormals.setRuns (testCycles);
+        denormals.setTimingSource (timingSource);
+        denormals.run (harnesses, spec, runner.getAudioBlock());
+        return getExitCode (writeResults (denormals.getResultsAsText(), denormals.getResultsAsJson(), denormals.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--block-patterns"))
+    {
+        const auto maxSplits = getOption ("--max-splits", "3").getIntValue();
+        if (maxSplits < 0)
+        {
+            std::cerr << "The maximum number of splits can't be negative" << std::endl;
+            return 1;
+        }
+
+        BenchmarkBlockPatterns blockPatterns;
+        blockPatterns.setHostBuffers (processingIterations);
+        blockPatterns.setRuns (testCycles);
+        blockPatterns.setMaxSplits (maxSplits);
+        blockPatterns.setTimingSource (timingSource);
+        blockPatterns.run (harnesses, spec, runner.getAudioBlock());
+        return getExitCode (writeResults (blockPatterns.getResultsAsText(), blockPatterns.getResultsAsJson(), blockPatterns.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--automation"))
+    {
+        const auto interval = getOption ("--automation-interval", "32").getIntValue();
+        const auto controlIndex = getOption ("--automation-control", "0").getIntValue();
+        if (interval <= 0 || controlIndex < 0)
+        {
+            std::cerr << "The automation interval must be positive and the control index non-negative" << std::endl;
+            return 1;
+        }
+
+        BenchmarkAutomation automation;
+        automation.setHostBuffers (processingIterations);
+        automation.setRuns (testCycles);
+        automation.setIntervalSamples (interval);
+        automation.setControlIndex (controlIndex);
+        automation.setTimingSource (timingSource);
+        automation.run (harnesses, spec, runner.getAudioBlock());
+        return getExitCode (writeResults (automation.getResultsAsText(), automation.getResultsAsJson(), automation.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--control-sweep"))
+    {
+        const auto steps = getOption ("--control-steps", "11").getIntValue();
+        const auto controls = BenchmarkSweep::parseIntList (getOption ("--control-pair", String()), 0);
+        if (steps < 2 || controls.size() > 2)
+        {
+            std::cerr << "The control steps must be at least 2 and no more than two controls can be swept together" << std::endl;
+            return 1;
+        }
+
+        BenchmarkControlSweep controlSweep;
+        controlSweep.setSteps (steps);
+        controlSweep.setControls (controls.isEmpty() ? -1 : controls[0], controls.size() < 2 ? -1 : controls[1]);
+        controlSweep.run (runner, harnesses, [&] (dsp::AudioBlock<float>& block, const dsp::ProcessSpec& sweepSpec)
+        {
+            fillWithSignal (block, sweepSpec, signal, frequency);
+        });
+        return getExitCode (writeResults (controlSweep.getResultsAsText(), controlSweep.getResultsAsJson(), controlSweep.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--stimuli"))
+    {
+        BenchmarkStimuli stimuli;
+        if (args.containsOption ("--stimulus-set"))
+        {
+            const auto stimuliToRun = BenchmarkStimuli::parseStimuli (args.getValueForOption ("--stimulus-set"));
+            if (stimuliToRun.empty())
+            {
+                std::cerr << "Invalid stimulus set (use silence, sine, white, pink, impulses, denormal, nan-inf or changing)" << std::endl;
+                return 1;
+            }
+            stimuli.setStimuli (stimuliToRun);
+        }
+
+        stimuli.setHostBuffers (processingIterations);
+        stimuli.setRuns (testCycles);
+        stimuli.setTimingSource (timingSource);
+        stimuli.run (harnesses, spec, runner.getAudioBlock());
+        return getExitCode (writeResults (stimuli.getResultsAsText(), stimuli.getResultsAsJson(), stimuli.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--alignment-sweep"))
+    {
+        BenchmarkAlignmentSweep alignmentSweep;
+        if (args.containsOption ("--alignment-offsets"))
+            alignmentSweep.setByteOffsets (BenchmarkSweep::parseIntList (args.getValueForOption ("--alignment-offsets"), 0));
+        if (args.containsOption ("--channel-paddings"))
+            alignmentSweep.setChannelPaddings (BenchmarkSweep::parseIntList (args.getValueForOption ("--channel-paddings"), 0));
+        if (alignmentSweep.getNumCells() == 0)
+        {
+            std::cerr << "Invalid alignment sweep (offsets must be multiples of 4 below 64, paddings multiples of 4)" << std::endl;
+            return 1;
+        }
+
+        alignmentSweep.run (runner, harnesses, [&] (dsp::AudioBlock<float>& block, const dsp::ProcessSpec& cellSpec)
+        {
+            fillWithSignal (block, cellSpec, signal, frequency);
+        });
+        return getExitCode (writeResults (alignmentSweep.getResultsAsText(), alignmentSweep.getResultsAsJson(), alignmentSweep.getResultsAsCsv()));
+    }
+
+    if (args.containsOption ("--sweep"))
+    {
+        BenchmarkSweep sweep;
+        if (args.containsOption ("--sweep-block-sizes"))
+            sweep.setBlockSizes (BenchmarkSweep::parseIntList (args.getValueForOption ("--sweep-block-sizes")));
+        if (args.containsOption ("--sweep-channels"))
+            sweep.setChannelCounts (BenchmarkSweep::parseIntList (args.getValueForOption ("--sweep-channels")));
+        if (args.containsOption ("--sweep-sample-rates"))
+            sweep.setSampleRates (BenchmarkSweep::parseDoubleList (args.getValueForOption ("--sweep-sample-rates")));
+        if (sweep.getNumCells() == 0)
+        {
+            std::cerr << "Invalid sweep (each list needs at least one positive value)" << std::endl;
+            return 1;
+        }
+
+        sweep.run (runner, harnesses, [&] (dsp::AudioBlock<float>& block, const dsp::ProcessSpec& cellSpec)
+        {
+            fillWithSignal (block, cellSpec, signal, frequency);
+        });
+        return getExitCode (writeResults (sweep.getResultsAsText(), sweep.getResultsAsJson(), sweep.getResultsAsCsv()));
+    }
+
+    // Load the baseline before running, so that a missing baseline or bad tolerances fail straight away
+    const auto baselineDirectory = File::getCurrentWorkingDirectory().getChildFile (getOption ("--baseline-dir", "baselines"));
+    BenchmarkBaseline baselineComparison;
+    var baseline;
+    if (args.containsOption ("--baseline"))
+    {
+        String loadError;
+        baseline = BenchmarkBaseline::load (BenchmarkBaseline::getBaselineFile (baselineDirectory, args.getValueForOption ("--baseline")), loadError);
+        if (baseline.isVoid())
+        {
+            std::cerr << loadError << std::endl;
+            return 1;
+        }
+        if (args.containsOption ("--tolerances") && !baselineComparison.parseTolerances (args.getValueForOption ("--tolerances")))
+        {
+            std::cerr << "Invalid tolerances (use a list of [routine.]metric:fraction, e.g. avg:0.05,p99:0.2,reset.avg:0.5)" << std::endl;
+            return 1;
+        }
+    }
+    if (args.containsOption ("--save-baseline") && args.getValueForOption ("--save-baseline").isEmpty())
+    {
+        std::cerr << "The baseline needs a name" << std::endl;
+        return 1;
+    }
+
+    summaryStream << runner.getAudioBlockAlignmentStatus() << std::endl;
+    runner.run (harnesses);
+    if (runner.getPerformanceCountersError().isNotEmpty())
+        std::cerr << "Performance counters unavailable: " << runner.getPerformanceCountersError() << std::endl;
+    std::ostringstream summary;
+    printSummary (summary, harnesses);
+    const auto results = runner.getResultsAsJson (harnesses);
+    auto ok = writeResults (String (summary.str()), results, runner.getResultsAsCsv (harnesses));
+
+    if (args.containsOption ("--save-baseline"))
+    {
+        const auto name = args.getValueForOption ("--save-baseline");
+        const auto revision = args.containsOption ("--revision") ? args.getValueForOption ("--revision")
+                                                                   : BenchmarkBaseline::getGitRevision (File::getCurrentWorkingDirectory());
+        const auto file = BenchmarkBaseline::getBaselineFile (baselineDirectory, name);
+        if (BenchmarkBaseline::save (BenchmarkBaseline::create (name, results, revision), file))
+            summaryStream << "Saved baseline " << file.getFullPathName() << std::endl;
+        else
+        {
+            std::cerr << "Couldn't write baseline " << file.getFullPathName() << std::endl;
+            ok = false;
+        }
+    }
+
+    auto regressed = false;
+    if (baseline.isObject())
+    {
+        // Results which can't be compared at all (e.g. a different spec) fail the gate, as nothing has been checked
+        regressed = !baselineComparison.compare (baseline, results) || baselineComparison.hasRegressions();
+        summaryStream << std::endl << baselineComparison.getResultsAsText();
+        if (args.containsOption ("--baseline-json"))
+            ok = writeOutput (args.getValueForOption ("--baseline-json"), JSON::toString (environment.addToResults (baselineComparison.getResultsAsJson()))) && ok;
+    }
+
+    return getExitCode (ok, regressed);
+}
@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    BenchmarkAlignmentSweep.cpp
+    Created: 18 Oct 2026 9:40:18pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkAlignmentSweep.h"
+
+namespace
+{
+    var toCostValue (const double nanoseconds)
+    {
+        if (!std::isfinite (nanoseconds))
+            return {};
+        return nanoseconds;
+    }
+
+    String formatValue (const double value, const int decimalPlaces, const int width)
+    {
+        return (std::isfinite (value) ? String (value, decimalPlaces) : String ("-")).paddedLeft (' ', width);
+    }
+}
+
+BenchmarkAlignmentSweep::BenchmarkAlignmentSweep()
+{
+    for (auto offset = 0; offset < 64; offset += 4)
+        byteOffsets.add (offset);
+
+    // 0 keeps the channels a whole number of cache lines apart (which for power of 2 block sizes also aliases in the cache),
+    // 4 misaligns each channel differently & 64 keeps the alignment but breaks the aliasing
+    channelPaddings = { 0, 4, 64 };
+}
+void BenchmarkAlignmentSweep::setByteOffsets (const Array<int>& offsets)
+{
+    // Offsets beyond a cache line would just repeat the alignments of smaller ones
+    byteOffsets.clear();
+    for (const auto offset : offsets)
+        if (offset >= 0 && offset < 64 && offset % static_cast<int> (sizeof (float)) == 0)
+            byteOffsets.add (offset);
+}
+void BenchmarkAlignmentSweep::setChannelPaddings (const Array<int>& paddings)
+{
+    channelPaddings.clear();
+    for (const auto padding : paddings)
+        if (padding >= 0 && padding % static_cast<int> (sizeof (float)) == 0)
+            channelPaddings.add (padding);
+}
+const Array<int>& BenchmarkAlignmentSweep::getByteOffsets() const
+{
+    return byteOffsets;
+}
+const Array<int>& BenchmarkAlignmentSweep::getChannelPaddings() const
+{
+    return channelPaddings;
+}
+int BenchmarkAlignmentSweep::getNumCells() const
+{
+    return byteOffsets.size() * channelPaddings.size();
+}
+bool BenchmarkAlignmentSweep::run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const BenchmarkSweep::FillCallback& fillCallback,
+                                   const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    cells.clear();
+    processorNames.clear();
+    for (auto* h : harnesses)
+        processorNames.add (h ? h->getProcessorName() : String());
+
+    spec = runner.getProcessSpec();
+    const auto previousOffset = runner.getBufferByteOffset();
+    const auto previousPadding = runner.getBufferChannelPadding();
+    const auto applyLayout = [&] (const int byteOffset, const int channelPadding)
+    {
+        runner.setBufferLayout (byteOffset, channelPadding);
+        runner.setProcessSpec (spec);
+        if (fillCallback)
+            fillCallback (runner.getAudioBlock(), spec);
+    };
+
+    const auto numCells = getNumCells();
+    auto cellIndex = 0;
+    auto completed = true;
+    for (auto p = 0; p < channelPaddings.size() && completed; ++p)
+    {
+        for (auto o = 0; o < byteOffsets.size(); ++o)
+        {
+            applyLayout (byteOffsets[o], channelPaddings[p]);
+            for (auto* h : harnesses)
+                if (h) h->resetStatistics();
+
+            completed = runner.run (harnesses, [&] (const double progress)
+            {
+                return progressCallback == nullptr || progressCallback ((static_cast<double> (cellIndex) + progress) / static_cast<double> (numCells));
+            });
+            if (!completed)
+                break;
+
+            Cell cell;
+            cell.byteOffset = runner.getBufferByteOffset();
+            cell.channelPadding = runner.getBufferChannelPadding();
+            cell.channelStride = runner.getBufferChannelStride();
+            cell.alignment = runner.getAudioBlockAlignment();
+            for (auto* h : harnesses)
+                cell.costs.push_back (BenchmarkSweep::getCost (h, spec));
+            cells.push_back (cell);
+            cellIndex++;
+        }
+    }
+
+    applyLayout (previousOffset, previousPadding);
+    return completed;
+}
+const std::vector<BenchmarkAlignmentSweep::Cell>& BenchmarkAlignmentSweep::getCells() const
+{
+    return cells;
+}
+const StringArray& BenchmarkAlignmentSweep::getProcessorNames() const
+{
+    return processorNames;
+}
+String BenchmarkAlignmentSweep::getResultsAsText() const
+{
+    constexpr auto columnWidth = 12;
+    String txt;
+    txt << "Spec: " << static_cast<int> (spec.maximumBlockSize) << " samples, " << static_cast<int> (spec.numChannels) << " channels, " << spec.sampleRate << " Hz" << newLine
+        << "Offsets are from a 64 byte boundary, padding is added to the (64 byte rounded) channel length" << newLine << newLine;
+    if (cells.empty())
+        return txt << "No results" << newLine;
+
+    const auto& reference = cells[getReferenceCellIndex()];
+    const auto findCell = [this] (const int byteOffset, const int channelPadding) -> const Cell*
+    {
+        for (const auto& cell : cells)
+            if (cell.byteOffset == byteOffset && cell.channelPadding == channelPadding)
+                return &cell;
+        return nullptr;
+    };
+
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        const auto referenceCost = reference.costs[static_cast<size_t> (h)].avg;
+        for (const auto relative : { false, true })
+        {
+            txt << "Processor " << BenchmarkRunner::getSlotName (h) << " (" << processorNames[h] << ") - "
+                << (relative ? "average cost relative to offset " + String (reference.byteOffset) + ", padding " + String (reference.channelPadding)
+                             : String ("average ns per sample per channel")) << newLine;
+
+            txt << String ("Offset").paddedRight (' ', 8);
+            for (const auto padding : channelPaddings)
+                txt << ("pad " + String (padding)).paddedLeft (' ', columnWidth);
+            txt << newLine;
+
+            for (const auto offset : byteOffsets)
+            {
+                txt << String (offset).paddedRight (' ', 8);
+                for (const auto padding : channelPaddings)
+                {
+                    auto value = std::numeric_limits<double>::quiet_NaN();
+                    if (const auto* cell = findCell (offset, padding))
+                        value = cell->costs[static_cast<size_t> (h)].avg;
+                    if (relative)
+                        value = referenceCost > 0.0 ? value / referenceCost : std::numeric_limits<double>::quiet_NaN();
+                    txt << formatValue (value, relative ? 3 : 2, columnWidth);
+                }
+                txt << newLine;
+            }
+            txt << newLine;
+        }
+    }
+    return txt;
+}
+var BenchmarkAlignmentSweep::getResultsAsJson() const
+{
+    Array<var> processors;
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        Array<var> cellResults;
+        for (const auto& cell : cells)
+        {
+            const auto& cost = cell.costs[static_cast<size_t> (h)];
+            auto* cellObj = new DynamicObject();
+            cellObj->setProperty ("byteOffset", cell.byteOffset);
+            cellObj->setProperty ("channelPadding", cell.channelPadding);
+            cellObj->setProperty ("channelStride", static_cast<int64> (cell.channelStride));
+            cellObj->setProperty ("alignment", cell.alignment);
+            cellObj->setProperty ("min_ns_per_sample", toCostValue (cost.min));
+            cellObj->setProperty ("avg_ns_per_sample", toCostValue (cost.avg));
+            cellObj->setProperty ("p50_ns_per_sample", toCostValue (cost.p50));
+            cellObj->setProperty ("p99_ns_per_sample", toCostValue (cost.p99));
+            cellResults.add (var (cellObj));
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (h));
+        procObj->setProperty ("name", processorNames[h]);
+        procObj->setProperty ("cells", cellResults);
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", static_cast<int> (spec.numChannels));
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkAlignmentSweep::getResultsAsCsv() const
+{
+    String csv ("slot,processor,byte_offset,channel_padding,channel_stride,alignment,min_ns_per_sample,avg_ns_per_sample,p50_ns_per_sample,p99_ns_per_sample\n");
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        for (const auto& cell : cells)
+        {
+            const auto& cost = cell.costs[static_cast<size_t> (h)];
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (h));
+            fields.add (processorNames[h].quoted());
+            fields.add (String (cell.byteOffset));
+            fields.add (String (cell.channelPadding));
+            fields.add (String (static_cast<int64> (cell.channelStride)));
+            fields.add (String (cell.alignment));
+            fields.add (toCostValue (cost.min).toString());
+            fields.add (toCostValue (cost.avg).toString());
+            fields.add (toCostValue (cost.p50).toString());
+            fields.add (toCostValue (cost.p99).toString());
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+size_t BenchmarkAlignmentSweep::getReferenceCellIndex() const
+{
+    for (size_t i = 0; i < cells.size(); ++i)
+        if (cells[i].byteOffset == 0 && cells[i].channelPadding == 0)
+            return i;
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    BenchmarkAlignmentSweep.h
+    Created: 18 Oct 2026 9:40:18pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkSweep.h"
+
+/**
+ * Runs the benchmark cycles with the channel buffers placed at a range of byte offsets from a cache line boundary and with a
+ * range of channel paddings (see BenchmarkRunner::setBufferLayout). Hosts don't always hand us aligned pointers, so this shows
+ * how much aligned SIMD code degrades when they don't, and whether channel strides which alias in the cache cost anything.
+ */
+class BenchmarkAlignmentSweep
+{
+public:
+
+    /** Processing cost (in nanoseconds per sample per channel) of each harness for one buffer layout. */
+    struct Cell
+    {
+        int byteOffset = 0;
+        int channelPadding = 0;
+        size_t channelStride = 0;                       /**< Bytes between the start of consecutive channels. */
+        int alignment = 0;                              /**< Smallest alignment of the channels (bytes). */
+        std::vector<BenchmarkSweep::Cost> costs {};     /**< One per harness (in the same order as the harnesses passed to run()). */
+    };
+
+    BenchmarkAlignmentSweep();
+    ~BenchmarkAlignmentSweep() = default;
+
+    /** Set the offsets from a cache line boundary to sweep (bytes). Offsets which aren't a multiple of sizeof (float) or are
+     *  64 or more are ignored.
+     */
+    void setByteOffsets (const Array<int>& offsets);
+
+    /** Set the extra bytes between channels to sweep (paddings which aren't a multiple of sizeof (float) are ignored). */
+    void setChannelPaddings (const Array<int>& paddings);
+
+    [[nodiscard]] const Array<int>& getByteOffsets() const;
+    [[nodiscard]] const Array<int>& getChannelPaddings() const;
+    [[nodiscard]] int getNumCells() const;
+
+    /** Runs the runner's test cycles for each buffer layout at the runner's current spec (the harness statistics are reset for
+     *  each layout). The runner's layout is restored afterwards, and its audio block is then refilled. Returns false if aborted.
+     */
+    bool run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const BenchmarkSweep::FillCallback& fillCallback,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    /** Returns the results of the last run (ordered by channel padding, then byte offset). */
+    [[nodiscard]] const std::vector<Cell>& getCells() const;
+
+    [[nodiscard]] const StringArray& getProcessorNames() const;
+
+    /** Returns text tables of the average cost (byte offsets down, channel paddings across) and the cost relative to the
+     *  aligned layout for each processor.
+     */
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+private:
+
+    /** Returns the index of the cell for offset 0 & padding 0 (or the first cell if that wasn't swept). */
+    [[nodiscard]] size_t getReferenceCellIndex() const;
+
+    Array<int> byteOffsets;
+    Array<int> channelPaddings;
+    dsp::ProcessSpec spec {};
+    std::vector<Cell> cells {};
+    StringArray processorNames {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkAlignmentSweep)
+};
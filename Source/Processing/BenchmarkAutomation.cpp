@@ -0,0 +1,387 @@
+/*
+  ==============================================================================
+
+    BenchmarkAutomation.cpp
+    Created: 18 Oct 2026 11:14:05pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkAutomation.h"
+
+namespace
+{
+    String formatValue (const double value, const int decimalPlaces)
+    {
+        return std::isfinite (value) ? String (value, decimalPlaces) : String ("-");
+    }
+
+    var toValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+}
+
+double BenchmarkAutomation::ScenarioResults::getNsPerSample (const int numChannels) const
+{
+    if (samples <= 0 || numChannels <= 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return totalMs * 1.0E6 / (static_cast<double> (samples) * static_cast<double> (numChannels));
+}
+bool BenchmarkAutomation::ScenarioResults::isSplit() const
+{
+    return scenario == Scenario::staticSplit || scenario == Scenario::jumpEveryInterval || scenario == Scenario::rampEveryInterval;
+}
+double BenchmarkAutomation::SlotResults::getRelativeCost (const ScenarioResults& results) const
+{
+    // The reference for the whole buffer scenarios is static controls, & for the split scenarios it is static controls split
+    // the same way (the static split itself is compared against whole buffers, which shows the cost of splitting)
+    const auto reference = results.isSplit() && results.scenario != Scenario::staticSplit ? Scenario::staticSplit : Scenario::staticControls;
+    for (const auto& s : scenarios)
+        if (s.scenario == reference && s.totalMs > 0.0 && results.samples > 0)
+            return results.getNsPerSample (1) / s.getNsPerSample (1);
+    return std::numeric_limits<double>::quiet_NaN();
+}
+void BenchmarkAutomation::setHostBuffers (const int numberOfHostBuffers)
+{
+    jassert (numberOfHostBuffers > 0);
+    hostBuffers = jmax (1, numberOfHostBuffers);
+}
+void BenchmarkAutomation::setRuns (const int numberOfRuns)
+{
+    jassert (numberOfRuns > 0);
+    runs = jmax (1, numberOfRuns);
+}
+void BenchmarkAutomation::setIntervalSamples (const int numberOfSamples)
+{
+    jassert (numberOfSamples > 0);
+    intervalSamples = jmax (1, numberOfSamples);
+}
+void BenchmarkAutomation::setControlIndex (const int index)
+{
+    jassert (index >= 0);
+    controlIndex = jmax (0, index);
+}
+void BenchmarkAutomation::setRampSeconds (const double seconds)
+{
+    jassert (seconds > 0.0);
+    rampSeconds = jmax (0.001, seconds);
+}
+void BenchmarkAutomation::setTimingSource (const BenchmarkTimer::Source source)
+{
+    timingSource = source;
+}
+int BenchmarkAutomation::getHostBuffers() const
+{
+    return hostBuffers;
+}
+int BenchmarkAutomation::getRuns() const
+{
+    return runs;
+}
+int BenchmarkAutomation::getIntervalSamples() const
+{
+    return intervalSamples;
+}
+int BenchmarkAutomation::getControlIndex() const
+{
+    return controlIndex;
+}
+double BenchmarkAutomation::getRampSeconds() const
+{
+    return rampSeconds;
+}
+bool BenchmarkAutomation::run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& processSpec, dsp::AudioBlock<float>& block,
+                               const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    jassert (processSpec.sampleRate > 0.0 && processSpec.maximumBlockSize > 0);
+    jassert (block.getNumSamples() >= processSpec.maximumBlockSize && block.getNumChannels() >= processSpec.numChannels);
+
+    spec = processSpec;
+    slotResults.clear();
+    slotResults.resize (harnesses.size());
+
+    const auto maxBlockSize = static_cast<int> (spec.maximumBlockSize);
+    auto hostBlock = block.getSubBlock (0, spec.maximumBlockSize).getSubsetChannelBlock (0, spec.numChannels);
+
+    // Work out the scenarios for each processor up front, so the progress can be reported (there is nothing to automate without
+    // controls, & automating all of them is the same as automating one if there is only one)
+    std::vector<std::vector<ScenarioResults>> scenarios (harnesses.size());
+    auto numScenarioRuns = 0;
+    for (size_t h = 0; h < harnesses.size(); ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        slotResults[h].name = harness->getProcessorName();
+        slotResults[h].numControls = harness->getNumControls();
+        if (!harness->setTimingSource (timingSource))
+            jassertfalse;
+
+        for (const auto scenario : { Scenario::staticControls, Scenario::staticSplit, Scenario::jumpEveryBlock, Scenario::jumpEveryInterval, Scenario::rampEveryInterval })
+        {
+            for (const auto allControls : { false, true })
+            {
+                const auto isStatic = scenario == Scenario::staticControls || scenario == Scenario::staticSplit;
+                if ((isStatic && allControls) || (!isStatic && harness->getNumControls() == 0) || (allControls && harness->getNumControls() == 1))
+                    continue;
+
+                ScenarioResults results;
+                results.scenario = scenario;
+                results.allControls = allControls;
+                scenarios[h].push_back (results);
+                numScenarioRuns++;
+            }
+        }
+    }
+
+    auto numerator = 0.0;
+    const auto denominator = static_cast<double> (numScenarioRuns) * static_cast<double> (runs) * static_cast<double> (hostBuffers);
+    const auto reportProgress = [&]
+    {
+        return progressCallback == nullptr || progressCallback (numerator / denominator);
+    };
+
+    auto completed = true;
+    for (size_t h = 0; h < harnesses.size() && completed; ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        // The benchmark leaves the controls as it found them (e.g. as set by the sliders in the GUI)
+        std::vector<double> savedValues;
+        for (auto c = 0; c < harness->getNumControls(); ++c)
+            savedValues.push_back (harness->getControlValue (c));
+
+        for (auto& results : scenarios[h])
+        {
+            const auto callSize = results.isSplit() ? jmin (intervalSamples, maxBlockSize) : maxBlockSize;
+            harness->resetStatistics();
+
+            for (auto r = 0; r < runs && completed; ++r)
+            {
+                for (auto c = 0; c < harness->getNumControls(); ++c)
+                    harness->setControlValue (c, harness->getDefaultControlValue (c));
+                harness->resetHarness();
+                harness->prepareHarness (spec);
+
+                Random random (0xa070);
+                int64 position = 0;
+                for (auto b = 0; b < hostBuffers; ++b)
+                {
+                    for (auto offset = 0; offset < maxBlockSize; offset += callSize)
+                    {
+                        const auto numSamples = jmin (callSize, maxBlockSize - offset);
+                        applyAutomation (*harness, results, position, random);
+
+                        auto subBlock = hostBlock.getSubBlock (static_cast<size_t> (offset), static_cast<size_t> (numSamples));
+                        const dsp::ProcessContextReplacing<float> context (subBlock);
+                        const auto steadyCallsBefore = harness->queryProcessingDurationNumSamples();
+                        harness->processHarness (context);
+
+                        // Only the steady state calls are totalled, so the totals cover the same calls as the average, p99 & max
+                        if (harness->queryProcessingDurationNumSamples() > steadyCallsBefore)
+                        {
+                            results.totalMs += harness->queryProcessingDurationLast();
+                            results.calls++;
+                            results.samples += numSamples;
+                        }
+                        position += numSamples;
+                    }
+
+                    numerator++;
+                    if (!reportProgress())
+                    {
+                        completed = false;
+                        break;
+                    }
+                }
+            }
+
+            // There are no steady state calls if the warm-up was as long as the runs
+            if (harness->queryProcessingDurationNumSamples() > 0.0)
+            {
+                results.avgCall = harness->queryProcessingDurationAverage();
+                results.p99Call = harness->queryProcessingDurationPercentile (99.0);
+                results.maxCall = harness->queryProcessingDurationMax();
+            }
+            if (!completed)
+                break;
+            slotResults[h].scenarios.push_back (results);
+        }
+
+        for (auto c = 0; c < static_cast<int> (savedValues.size()); ++c)
+            harness->setControlValue (c, savedValues[static_cast<size_t> (c)]);
+    }
+    return completed;
+}
+const std::vector<BenchmarkAutomation::SlotResults>& BenchmarkAutomation::getSlotResults() const
+{
+    return slotResults;
+}
+String BenchmarkAutomation::getResultsAsText() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    String txt;
+    txt << "Spec: " << static_cast<int> (spec.maximumBlockSize) << " samples, " << numChannels << " channels, " << spec.sampleRate << " Hz" << newLine
+        << hostBuffers << " host buffers, " << runs << " run(s), ramp period " << String (rampSeconds, 2) << " s" << newLine
+        << "Split scenarios are compared against static controls split the same way" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ") - " << slot.numControls << " control(s)" << newLine
+            << "  Scenario                                  Calls   ns/sample/ch   vs static   Avg call (us)   p99 call (us)" << newLine;
+        for (const auto& results : slot.scenarios)
+        {
+            txt << "  " << getScenarioName (results).paddedRight (' ', 38)
+                << String (results.calls).paddedLeft (' ', 9)
+                << formatValue (results.getNsPerSample (numChannels), 3).paddedLeft (' ', 15)
+                << (formatValue (slot.getRelativeCost (results), 2) + "x").paddedLeft (' ', 12)
+                << String (results.avgCall * 1000.0, 2).paddedLeft (' ', 16)
+                << String (results.p99Call * 1000.0, 2).paddedLeft (' ', 16) << newLine;
+        }
+        if (slot.numControls == 0)
+            txt << "  No controls to automate" << newLine;
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkAutomation::getResultsAsJson() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        Array<var> scenarioArray;
+        for (const auto& results : slot.scenarios)
+        {
+            auto* scenarioObj = new DynamicObject();
+            scenarioObj->setProperty ("scenario", getScenarioKey (results.scenario));
+            scenarioObj->setProperty ("controls", results.allControls ? "all" : "one");
+            scenarioObj->setProperty ("calls", results.calls);
+            scenarioObj->setProperty ("samples", results.samples);
+            scenarioObj->setProperty ("ns_per_sample", toValue (results.getNsPerSample (numChannels)));
+            scenarioObj->setProperty ("relative_to_static", toValue (slot.getRelativeCost (results)));
+            scenarioObj->setProperty ("avg_call_us", results.avgCall * 1000.0);
+            scenarioObj->setProperty ("p99_call_us", results.p99Call * 1000.0);
+            scenarioObj->setProperty ("max_call_us", results.maxCall * 1000.0);
+            scenarioArray.add (var (scenarioObj));
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("numControls", slot.numControls);
+        procObj->setProperty ("scenarios", scenarioArray);
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", numChannels);
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("hostBuffers", hostBuffers);
+    root->setProperty ("runs", runs);
+    root->setProperty ("intervalSamples", intervalSamples);
+    root->setProperty ("controlIndex", controlIndex);
+    root->setProperty ("rampSeconds", rampSeconds);
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkAutomation::getResultsAsCsv() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    String csv ("slot,processor,scenario,controls,calls,samples,ns_per_sample,relative_to_static,avg_call_us,p99_call_us,max_call_us\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        for (const auto& results : slot.scenarios)
+        {
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+            fields.add (slot.name.quoted());
+            fields.add (getScenarioKey (results.scenario));
+            fields.add (results.allControls ? "all" : "one");
+            fields.add (String (results.calls));
+            fields.add (String (results.samples));
+            fields.add (String (results.getNsPerSample (numChannels)));
+            fields.add (String (slot.getRelativeCost (results)));
+            fields.add (String (results.avgCall * 1000.0));
+            fields.add (String (results.p99Call * 1000.0));
+            fields.add (String (results.maxCall * 1000.0));
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+String BenchmarkAutomation::getScenarioName (const ScenarioResults& results) const
+{
+    const auto interval = String (jmin (intervalSamples, static_cast<int> (spec.maximumBlockSize)));
+    const auto controls = results.allControls ? String ("All controls") : "Control " + String (controlIndex);
+    switch (results.scenario)
+    {
+        case Scenario::staticControls: return "Static";
+        case Scenario::staticSplit: return "Static, split every " + interval + " samples";
+        case Scenario::jumpEveryBlock: return controls + " jump every block";
+        case Scenario::jumpEveryInterval: return controls + " jump every " + interval + " samples";
+        case Scenario::rampEveryInterval: return controls + " ramp every " + interval + " samples";
+        default: return {};
+    }
+}
+String BenchmarkAutomation::getScenarioKey (const Scenario scenario)
+{
+    switch (scenario)
+    {
+        case Scenario::staticControls: return "static";
+        case Scenario::staticSplit: return "static-split";
+        case Scenario::jumpEveryBlock: return "jump-block";
+        case Scenario::jumpEveryInterval: return "jump-interval";
+        case Scenario::rampEveryInterval: return "ramp";
+        default: return {};
+    }
+}
+void BenchmarkAutomation::applyAutomation (ProcessorHarness& harness, const ScenarioResults& results, const int64 position, Random& random) const
+{
+    if (results.scenario == Scenario::staticControls || results.scenario == Scenario::staticSplit)
+        return;
+
+    const auto numControls = harness.getNumControls();
+    const auto singleControl = jmin (controlIndex, numControls - 1);
+    for (auto c = 0; c < numControls; ++c)
+    {
+        if (!results.allControls && c != singleControl)
+            continue;
+
+        auto value = 0.0;
+        if (results.scenario == Scenario::rampEveryInterval)
+        {
+            // Triangle from 0 to 1 & back over the ramp period, with each control offset in phase so they don't move in lock-step
+            const auto phase = std::fmod (static_cast<double> (position) / (rampSeconds * spec.sampleRate) + static_cast<double> (c) / static_cast<double> (numControls), 1.0);
+            value = phase < 0.5 ? 2.0 * phase : 2.0 - 2.0 * phase;
+        }
+        else
+        {
+            value = random.nextDouble();
+        }
+        harness.setControlValue (c, value);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    BenchmarkAutomation.h
+    Created: 18 Oct 2026 11:14:05pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Measures the cost of parameter automation by changing one or all of each processor's controls while it is processing, &
+ * comparing the cost per sample against static controls. The other benchmarks never change the controls, so the cost of
+ * reacting to them (e.g. recalculating filter coefficients or smoothing) isn't measured.
+ *
+ * Controls are changed between process calls (outside of the timed region), as a host would. Automation every N samples splits
+ * each host buffer into calls of N samples, so it is compared against static controls with the same split, which separates the
+ * cost of reacting to the controls from the fixed cost of the extra calls.
+ */
+class BenchmarkAutomation
+{
+public:
+
+    /** Automation scenarios (values start at 1 so they can be used as ComboBox IDs). */
+    enum class Scenario : int
+    {
+        staticControls = 1,     /**< Controls stay at their default values (the reference for whole host buffers). */
+        staticSplit,            /**< As per staticControls, but each host buffer is split every N samples (the reference for the split scenarios). */
+        jumpEveryBlock,         /**< Controls jump to a random value before every host buffer. */
+        jumpEveryInterval,      /**< Controls jump to a random value every N samples. */
+        rampEveryInterval       /**< Controls follow a slow triangle ramp, updated every N samples. */
+    };
+
+    /** Results for one scenario (times are in milliseconds, as per ProcessorHarness). */
+    struct ScenarioResults
+    {
+        Scenario scenario = Scenario::staticControls;
+        bool allControls = false;       /**< True if all of the controls were automated (rather than just one). */
+        int64 calls = 0;                /**< Number of steady state calls (the harness's warm-up calls are left out, as per its statistics). */
+        int64 samples = 0;              /**< Number of samples processed by the steady state calls (per channel). */
+        double totalMs = 0.0;           /**< Total time of the steady state calls. */
+        double avgCall = 0.0;
+        double p99Call = 0.0;
+        double maxCall = 0.0;
+
+        /** Returns the cost in nanoseconds per sample per channel. */
+        [[nodiscard]] double getNsPerSample (const int numChannels) const;
+
+        /** Returns true if the scenario splits each host buffer every N samples. */
+        [[nodiscard]] bool isSplit() const;
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        int numControls = 0;
+        std::vector<ScenarioResults> scenarios {};
+
+        /** Returns the cost per sample of a scenario relative to static controls with the same block splitting (NaN if not measured). */
+        [[nodiscard]] double getRelativeCost (const ScenarioResults& results) const;
+    };
+
+    BenchmarkAutomation() = default;
+    ~BenchmarkAutomation() = default;
+
+    /** Set the number of host buffers (of the maximum block size) fed to the processor in each run. */
+    void setHostBuffers (const int numberOfHostBuffers);
+
+    /** Set the number of times each scenario is run through each processor (the processor is reset & prepared before each run). */
+    void setRuns (const int numberOfRuns);
+
+    /** Set the number of samples between control changes in the split scenarios. */
+    void setIntervalSamples (const int numberOfSamples);
+
+    /** Set the index of the control which is automated in the single control scenarios. */
+    void setControlIndex (const int index);
+
+    /** Set the period of the triangle ramp (from 0 to 1 & back). */
+    void setRampSeconds (const double seconds);
+
+    /** Set the clock used to time the process calls. */
+    void setTimingSource (const BenchmarkTimer::Source source);
+
+    [[nodiscard]] int getHostBuffers() const;
+    [[nodiscard]] int getRuns() const;
+    [[nodiscard]] int getIntervalSamples() const;
+    [[nodiscard]] int getControlIndex() const;
+    [[nodiscard]] double getRampSeconds() const;
+
+    /** Runs each scenario against each non null harness using (sub blocks of) the given block, which should hold the test signal.
+     *  The harness statistics are reset for each scenario, & the control values are restored afterwards. Returns false if the run
+     *  was aborted by the progress callback.
+     */
+    bool run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& spec, dsp::AudioBlock<float>& block,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+    /** Returns a description of a scenario (e.g. "All controls jump every 32 samples"). */
+    [[nodiscard]] String getScenarioName (const ScenarioResults& results) const;
+
+    /** Returns a short name for a scenario, as used in the results (e.g. "ramp"). */
+    static String getScenarioKey (const Scenario scenario);
+
+private:
+
+    /** Sets the automated controls for the given sample position within a run. */
+    void applyAutomation (ProcessorHarness& harness, const ScenarioResults& results, const int64 position, Random& random) const;
+
+    int hostBuffers = 1000;
+    int runs = 1;
+    int intervalSamples = 32;
+    int controlIndex = 0;
+    double rampSeconds = 1.0;
+    BenchmarkTimer::Source timingSource = BenchmarkTimer::Source::juceHighResolution;
+
+    dsp::ProcessSpec spec {};
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkAutomation)
+};
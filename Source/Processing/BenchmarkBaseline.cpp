@@ -0,0 +1,385 @@
+/*
+  ==============================================================================
+
+    BenchmarkBaseline.cpp
+    Created: 18 Oct 2026 10:31:09pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkBaseline.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    const StringArray routineKeys = { "prepare", "process", "reset" };
+
+    /** Returns the results keys of the time statistics (e.g. avg_us & p99_9_us), as per BenchmarkRunner::getResultsAsJson(). */
+    StringArray getMetricKeys()
+    {
+        StringArray keys;
+        for (auto v = 0; v < ProcessorHarness::numQueryValues; ++v)
+            if (v != 3) // The count isn't a time
+                keys.add (ProcessorHarness::getQueryValueName (v).toLowerCase().replaceCharacter ('.', '_') + "_us");
+        return keys;
+    }
+
+    String formatPercent (const double fraction)
+    {
+        return (fraction >= 0.0 ? "+" : "") + String (fraction * 100.0, 1) + "%";
+    }
+
+    /** Finds the processor in a results array with the same slot & name, or failing that the same name. */
+    var findProcessor (const var& processors, const String& slot, const String& name)
+    {
+        if (const auto* array = processors.getArray())
+        {
+            for (const auto& p : *array)
+                if (p["slot"].toString() == slot && p["name"].toString() == name)
+                    return p;
+            for (const auto& p : *array)
+                if (p["name"].toString() == name)
+                    return p;
+        }
+        return {};
+    }
+}
+
+double BenchmarkBaseline::Comparison::getChange() const
+{
+    return baseline > 0.0 ? (current - baseline) / baseline : 0.0;
+}
+bool BenchmarkBaseline::Comparison::isComparable() const
+{
+    return baseline > 0.0;
+}
+bool BenchmarkBaseline::Comparison::isRegression() const
+{
+    return isComparable() && getChange() > tolerance;
+}
+BenchmarkBaseline::BenchmarkBaseline()
+{
+    // The minimum & median are the most repeatable, whereas the tail is noisier so it is given more room
+    tolerances = {
+        { "process", "min_us", 0.1 },
+        { "process", "avg_us", 0.1 },
+        { "process", "p50_us", 0.1 },
+        { "process", "p99_us", 0.25 }
+    };
+}
+bool BenchmarkBaseline::parseTolerances (const String& text)
+{
+    const auto metricKeys = getMetricKeys();
+    std::vector<Tolerance> parsed;
+    for (const auto& token : StringArray::fromTokens (text, ",", ""))
+    {
+        const auto entry = token.trim();
+        if (entry.isEmpty())
+            continue;
+
+        const auto key = entry.upToFirstOccurrenceOf (":", false, false).trim().toLowerCase();
+        const auto value = entry.fromFirstOccurrenceOf (":", false, false).trim();
+        if (!entry.containsChar (':') || value.isEmpty() || !value.containsOnly ("0123456789."))
+            return false;
+
+        // The routine is optional, and a metric such as p99.9 also contains a dot
+        Tolerance tolerance;
+        tolerance.routine = "process";
+        auto metric = key;
+        if (routineKeys.contains (key.upToFirstOccurrenceOf (".", false, false)))
+        {
+            tolerance.routine = key.upToFirstOccurrenceOf (".", false, false);
+            metric = key.fromFirstOccurrenceOf (".", false, false);
+        }
+        metric = metric.replaceCharacter ('.', '_');
+        if (!metric.endsWith ("_us"))
+            metric << "_us";
+        if (!metricKeys.contains (metric))
+            return false;
+
+        tolerance.metric = metric;
+        tolerance.fraction = value.getDoubleValue();
+        parsed.push_back (tolerance);
+    }
+    if (parsed.empty())
+        return false;
+
+    tolerances = parsed;
+    return true;
+}
+const std::vector<BenchmarkBaseline::Tolerance>& BenchmarkBaseline::getTolerances() const
+{
+    return tolerances;
+}
+bool BenchmarkBaseline::compare (const var& baseline, const var& results)
+{
+    comparisons.clear();
+    warnings.clear();
+    error.clear();
+    baselineDescription = describeRun (baseline);
+
+    const auto& baselineResults = baseline["results"];
+    if (!baselineResults.isObject() || !results.isObject())
+    {
+        error = "There are no results to compare";
+        return false;
+    }
+
+    // Results from a different spec, cache state or buffer layout aren't comparable at all
+    for (const auto& key : { "sampleRate", "blockSize", "numChannels" })
+    {
+        if (baselineResults["spec"][key] != results["spec"][key])
+        {
+            error << "The " << key << " (" << results["spec"][key].toString() << ") differs from the baseline (" << baselineResults["spec"][key].toString() << ")";
+            return false;
+        }
+    }
+    for (const auto& key : { "byteOffset", "channelPadding" })
+    {
+        if (baselineResults["buffer"][key] != results["buffer"][key])
+        {
+            error << "The buffer " << key << " (" << results["buffer"][key].toString() << ") differs from the baseline (" << baselineResults["buffer"][key].toString() << ")";
+            return false;
+        }
+    }
+    if (baselineResults["cache"].toString() != results["cache"].toString())
+    {
+        error << "The cache state (" << results["cache"].toString() << ") differs from the baseline (" << baselineResults["cache"].toString() << ")";
+        return false;
+    }
+
+    for (const auto& key : { "testCycles", "processingIterations" })
+        if (baselineResults[key] != results[key])
+            warnings.add (String (key) + " (" + results[key].toString() + ") differs from the baseline (" + baselineResults[key].toString() + ")");
+    if (baseline["machine"]["cpu"].toString() != SystemStats::getCpuModel())
+        warnings.add ("The baseline was measured on a different CPU (" + baseline["machine"]["cpu"].toString() + ")");
+
+    // The environment (as per BenchmarkEnvironment) is only in results which recorded it, so older baselines don't warn
+    const auto& baselineEnvironment = baselineResults["environment"];
+    const auto& environment = results["environment"];
+    if (baselineEnvironment.isObject() && environment.isObject())
+    {
+        for (const auto& key : { "governor", "turbo", "smt" })
+            if (baselineEnvironment["cpu"][key] != environment["cpu"][key])
+                warnings.add ("The " + String (key) + " (" + environment["cpu"][key].toString() + ") differs from the baseline ("
+                              + baselineEnvironment["cpu"][key].toString() + ")");
+        for (const auto& key : { "compiler", "type", "flags" })
+            if (baselineEnvironment["build"][key] != environment["build"][key])
+                warnings.add ("The build " + String (key) + " (" + environment["build"][key].toString() + ") differs from the baseline ("
+                              + baselineEnvironment["build"][key].toString() + ")");
+    }
+
+    if (const auto* processors = results["processors"].getArray())
+    {
+        for (const auto& current : *processors)
+        {
+            const auto slot = current["slot"].toString();
+            const auto name = current["name"].toString();
+            const auto match = findProcessor (baselineResults["processors"], slot, name);
+            if (!match.isObject())
+            {
+                warnings.add ("Processor " + slot + " (" + name + ") isn't in the baseline");
+                continue;
+            }
+            if (match["timer"]["source"].toString() != current["timer"]["source"].toString())
+                warnings.add ("Processor " + slot + " (" + name + ") was timed with a different clock (" + match["timer"]["source"].toString() + ")");
+
+            for (const auto& tolerance : tolerances)
+            {
+                const auto& baselineValue = match[Identifier (tolerance.routine)][Identifier (tolerance.metric)];
+                const auto& currentValue = current[Identifier (tolerance.routine)][Identifier (tolerance.metric)];
+                const auto description = "Processor " + slot + " (" + name + ") " + tolerance.routine + " " + tolerance.metric;
+                if (baselineValue.isVoid() || currentValue.isVoid())
+                {
+                    warnings.add (description + " is missing from the " + (baselineValue.isVoid() ? "baseline" : "results") + ", so it wasn't compared");
+                    continue;
+                }
+
+                Comparison comparison;
+                comparison.slot = slot;
+                comparison.processor = name;
+                comparison.routine = tolerance.routine;
+                comparison.metric = tolerance.metric;
+                comparison.baseline = static_cast<double> (baselineValue);
+                comparison.current = static_cast<double> (currentValue);
+                comparison.tolerance = tolerance.fraction;
+                comparisons.push_back (comparison);
+                if (!comparison.isComparable())
+                    warnings.add (description + " is 0 in the baseline, so it wasn't compared (save the baseline again)");
+            }
+        }
+    }
+    // Nothing in common has nothing checked, so it mustn't pass as if it had no regressions
+    if (getNumNotCompared() == static_cast<int> (comparisons.size()))
+    {
+        error = "None of the processors & metrics could be compared";
+        return false;
+    }
+    return true;
+}
+const std::vector<BenchmarkBaseline::Comparison>& BenchmarkBaseline::getComparisons() const
+{
+    return comparisons;
+}
+const StringArray& BenchmarkBaseline::getWarnings() const
+{
+    return warnings;
+}
+const String& BenchmarkBaseline::getError() const
+{
+    return error;
+}
+bool BenchmarkBaseline::hasRegressions() const
+{
+    for (const auto& comparison : comparisons)
+        if (comparison.isRegression())
+            return true;
+    return false;
+}
+int BenchmarkBaseline::getNumNotCompared() const
+{
+    auto count = 0;
+    for (const auto& comparison : comparisons)
+        if (!comparison.isComparable())
+            count++;
+    return count;
+}
+String BenchmarkBaseline::getResultsAsText() const
+{
+    String txt;
+    txt << "Baseline: " << baselineDescription << newLine;
+    if (error.isNotEmpty())
+        return txt << "Can't compare: " << error << newLine;
+
+    for (const auto& warning : warnings)
+        txt << "Warning: " << warning << newLine;
+    txt << newLine;
+
+    String lastProcessor;
+    auto numRegressions = 0;
+    for (const auto& comparison : comparisons)
+    {
+        const auto processor = "Processor " + comparison.slot + " (" + comparison.processor + ")";
+        if (processor != lastProcessor)
+        {
+            txt << processor << newLine
+                << "  Metric                 Baseline     Current    Change   Tolerance" << newLine;
+            lastProcessor = processor;
+        }
+
+        const auto isRegression = comparison.isRegression();
+        numRegressions += isRegression ? 1 : 0;
+        txt << "  " << (comparison.routine + " " + comparison.metric).paddedRight (' ', 18)
+            << String (comparison.baseline, 2).paddedLeft (' ', 12)
+            << String (comparison.current, 2).paddedLeft (' ', 12)
+            << (comparison.isComparable() ? formatPercent (comparison.getChange()) : String ("n/a")).paddedLeft (' ', 10)
+            << formatPercent (comparison.tolerance).paddedLeft (' ', 12)
+            << (isRegression ? "  REGRESSION" : comparison.isComparable() ? "" : "  NOT COMPARED") << newLine;
+    }
+
+    txt << newLine << (numRegressions > 0 ? String (numRegressions) + " regression(s) beyond tolerance" : String ("No regressions"));
+    if (const auto numNotCompared = getNumNotCompared())
+        txt << " (" << numNotCompared << " metric(s) not compared)";
+    txt << newLine;
+    return txt;
+}
+var BenchmarkBaseline::getResultsAsJson() const
+{
+    Array<var> comparisonArray;
+    for (const auto& comparison : comparisons)
+    {
+        auto* obj = new DynamicObject();
+        obj->setProperty ("slot", comparison.slot);
+        obj->setProperty ("processor", comparison.processor);
+        obj->setProperty ("routine", comparison.routine);
+        obj->setProperty ("metric", comparison.metric);
+        obj->setProperty ("baseline", comparison.baseline);
+        obj->setProperty ("current", comparison.current);
+        obj->setProperty ("change", comparison.isComparable() ? var (comparison.getChange()) : var());
+        obj->setProperty ("compared", comparison.isComparable());
+        obj->setProperty ("tolerance", comparison.tolerance);
+        obj->setProperty ("regression", comparison.isRegression());
+        comparisonArray.add (var (obj));
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty ("baseline", baselineDescription);
+    if (error.isNotEmpty())
+        root->setProperty ("error", error);
+    root->setProperty ("warnings", warnings);
+    root->setProperty ("regressions", hasRegressions());
+    root->setProperty ("not_compared", getNumNotCompared());
+    root->setProperty ("comparisons", comparisonArray);
+    return var (root);
+}
+var BenchmarkBaseline::create (const String& name, const var& results, const String& revision)
+{
+    auto* machineObj = new DynamicObject();
+    machineObj->setProperty ("cpu", SystemStats::getCpuModel());
+    machineObj->setProperty ("numCpus", SystemStats::getNumCpus());
+    machineObj->setProperty ("os", SystemStats::getOperatingSystemName());
+
+    auto* root = new DynamicObject();
+    root->setProperty ("name", name);
+    root->setProperty ("revision", revision);
+    root->setProperty ("created", Time::getCurrentTime().toISO8601 (true));
+    root->setProperty ("machine", var (machineObj));
+    root->setProperty ("results", results);
+    return var (root);
+}
+File BenchmarkBaseline::getBaselineFile (const File& directory, const String& name)
+{
+    return directory.getChildFile (File::createLegalFileName (name)).withFileExtension ("json");
+}
+bool BenchmarkBaseline::save (const var& baseline, const File& file)
+{
+    if (!file.getParentDirectory().createDirectory())
+        return false;
+    return file.replaceWithText (JSON::toString (baseline));
+}
+var BenchmarkBaseline::load (const File& file, String& loadError)
+{
+    if (!file.existsAsFile())
+    {
+        loadError = "Baseline not found: " + file.getFullPathName();
+        return {};
+    }
+
+    const auto baseline = JSON::parse (file);
+    if (!baseline["results"].isObject())
+    {
+        loadError = "Not a baseline: " + file.getFullPathName();
+        return {};
+    }
+    return baseline;
+}
+String BenchmarkBaseline::getGitRevision (const File& directory)
+{
+    const auto runGit = [&directory] (const StringArray& gitArguments, String& output)
+    {
+        ChildProcess git;
+        StringArray arguments { "git", "-C", directory.getFullPathName() };
+        arguments.addArray (gitArguments);
+        if (!git.start (arguments, ChildProcess::wantStdOut))
+            return false;
+        output = git.readAllProcessOutput().trim();
+        return git.getExitCode() == 0;
+    };
+
+    String revision, status;
+    if (!runGit ({ "rev-parse", "--short=12", "HEAD" }, revision) || revision.isEmpty())
+        return {};
+    if (runGit ({ "status", "--porcelain", "--untracked-files=no" }, status) && status.isNotEmpty())
+        revision << "-dirty";
+    return revision;
+}
+String BenchmarkBaseline::describeRun (const var& baseline)
+{
+    String description;
+    description << baseline["name"].toString()
+                << " (revision " << (baseline["revision"].toString().isNotEmpty() ? baseline["revision"].toString() : String ("unknown"))
+                << ", " << baseline["created"].toString()
+                << ", " << baseline["machine"]["cpu"].toString() << ")";
+    return description;
+}
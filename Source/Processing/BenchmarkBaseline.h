@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    BenchmarkBaseline.h
+    Created: 18 Oct 2026 10:31:09pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/**
+ * Saves benchmark results (as per BenchmarkRunner::getResultsAsJson()) as a named baseline, along with the revision of the code &
+ * the machine they were measured on, and compares later results against a baseline using a tolerance for each metric. This lets
+ * a build fail when a change makes a processor slower, rather than somebody noticing once it has shipped.
+ */
+class BenchmarkBaseline
+{
+public:
+
+    /** Maximum allowed increase of a metric, as a fraction of the baseline value (e.g. 0.1 allows it to be 10% slower). */
+    struct Tolerance
+    {
+        String routine {};      /**< Routine key in the results (e.g. "process"). */
+        String metric {};       /**< Metric key in the results (e.g. "avg_us"). */
+        double fraction = 0.0;
+    };
+
+    /** Comparison of one metric of one processor against the baseline. */
+    struct Comparison
+    {
+        String slot {};
+        String processor {};
+        String routine {};
+        String metric {};
+        double baseline = 0.0;
+        double current = 0.0;
+        double tolerance = 0.0;
+
+        /** Returns the change relative to the baseline (e.g. 0.15 if the current value is 15% higher). */
+        [[nodiscard]] double getChange() const;
+
+        /** Returns false if the baseline value is 0 (e.g. from a build which didn't record it), in which case the metric can't be
+         *  checked & is reported as not compared rather than passing.
+         */
+        [[nodiscard]] bool isComparable() const;
+
+        [[nodiscard]] bool isRegression() const;
+    };
+
+    /** Starts with the default tolerances (10% for the min, average & median process time, & 25% for p99). */
+    BenchmarkBaseline();
+    ~BenchmarkBaseline() = default;
+
+    /** Replaces the tolerances with a comma separated list of [routine.]metric:fraction (e.g. "avg:0.05, p99:0.2, reset.avg:0.5"),
+     *  where the routine defaults to process & the metric is a results key with or without the _us suffix. Returns false (leaving
+     *  the tolerances unchanged) if any of the entries aren't valid.
+     */
+    bool parseTolerances (const String& text);
+
+    [[nodiscard]] const std::vector<Tolerance>& getTolerances() const;
+
+    /** Compares results against a baseline (as returned by create() or load()), returning false if they can't be compared (e.g.
+     *  because the specs differ, or none of the processors & metrics are in both with a non-zero baseline), in which case getError()
+     *  returns the reason. Metrics which are missing from either, or whose baseline is 0, are listed in the warnings.
+     */
+    bool compare (const var& baseline, const var& results);
+
+    [[nodiscard]] const std::vector<Comparison>& getComparisons() const;
+
+    /** Returns any differences between the runs which make the comparison less reliable (e.g. a different CPU). */
+    [[nodiscard]] const StringArray& getWarnings() const;
+
+    [[nodiscard]] const String& getError() const;
+    [[nodiscard]] bool hasRegressions() const;
+
+    /** Returns the number of comparisons which couldn't be checked because their baseline value is 0. */
+    [[nodiscard]] int getNumNotCompared() const;
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+
+    /** Creates a baseline from results, recording the name, revision, time & machine. */
+    static var create (const String& name, const var& results, const String& revision);
+
+    /** Returns the file for a named baseline within a directory. */
+    static File getBaselineFile (const File& directory, const String& name);
+
+    /** Saves a baseline as JSON (creating the directory if necessary). Returns false if the file couldn't be written. */
+    static bool save (const var& baseline, const File& file);
+
+    /** Loads a baseline, returning a void var (& setting the error) if the file is missing or isn't a baseline. */
+    static var load (const File& file, String& error);
+
+    /** Returns the git revision of the working tree containing the directory (with a -dirty suffix if it has local changes),
+     *  or an empty string if git isn't available or the directory isn't in a repository.
+     */
+    static String getGitRevision (const File& directory);
+
+private:
+
+    static String describeRun (const var& baseline);
+
+    std::vector<Tolerance> tolerances {};
+    std::vector<Comparison> comparisons {};
+    StringArray warnings {};
+    String error {};
+    String baselineDescription {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkBaseline)
+};
@@ -0,0 +1,394 @@
+/*
+  ==============================================================================
+
+    BenchmarkBlockPatterns.cpp
+    Created: 18 Oct 2026 10:52:37pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkBlockPatterns.h"
+
+namespace
+{
+    constexpr std::array<BenchmarkBlockPatterns::Pattern, BenchmarkBlockPatterns::numPatterns> allPatterns {
+        BenchmarkBlockPatterns::Pattern::fixed,
+        BenchmarkBlockPatterns::Pattern::randomUniform,
+        BenchmarkBlockPatterns::Pattern::dawSplit,
+        BenchmarkBlockPatterns::Pattern::singleSample
+    };
+
+    String formatValue (const double value, const int decimalPlaces)
+    {
+        return std::isfinite (value) ? String (value, decimalPlaces) : String ("-");
+    }
+
+    var toValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+}
+
+double BenchmarkBlockPatterns::PatternResults::getAverageBlockSize() const
+{
+    return calls > 0 ? static_cast<double> (samples) / static_cast<double> (calls) : 0.0;
+}
+double BenchmarkBlockPatterns::PatternResults::getNsPerSample (const int numChannels) const
+{
+    if (samples <= 0 || numChannels <= 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return totalMs * 1.0E6 / (static_cast<double> (samples) * static_cast<double> (numChannels));
+}
+double BenchmarkBlockPatterns::SlotResults::getRelativeCost (const Pattern pattern) const
+{
+    const auto* fixed = getPattern (Pattern::fixed);
+    const auto* other = getPattern (pattern);
+    if (!fixed || !other || fixed->totalMs <= 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    // The channel count is the same for every pattern, so it cancels out
+    return other->getNsPerSample (1) / fixed->getNsPerSample (1);
+}
+double BenchmarkBlockPatterns::SlotResults::getFixedCostPerCallNs() const
+{
+    const auto* fixed = getPattern (Pattern::fixed);
+    const auto* single = getPattern (Pattern::singleSample);
+    if (!fixed || !single)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    // Solves time = calls * costPerCall + samples * costPerSample for both patterns (the warm-up leaves out a different number of
+    // samples from each, otherwise this is just the difference in time over the difference in calls)
+    const auto callsS = static_cast<double> (single->calls), samplesS = static_cast<double> (single->samples);
+    const auto callsF = static_cast<double> (fixed->calls), samplesF = static_cast<double> (fixed->samples);
+    const auto determinant = callsS * samplesF - callsF * samplesS;
+    if (determinant <= 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return jmax (0.0, (single->totalMs * samplesF - fixed->totalMs * samplesS) * 1.0E6 / determinant);
+}
+const BenchmarkBlockPatterns::PatternResults* BenchmarkBlockPatterns::SlotResults::getPattern (const Pattern pattern) const
+{
+    for (const auto& p : patterns)
+        if (p.pattern == pattern && p.calls > 0)
+            return &p;
+    return nullptr;
+}
+void BenchmarkBlockPatterns::setHostBuffers (const int numberOfHostBuffers)
+{
+    jassert (numberOfHostBuffers > 0);
+    hostBuffers = jmax (1, numberOfHostBuffers);
+}
+void BenchmarkBlockPatterns::setRuns (const int numberOfRuns)
+{
+    jassert (numberOfRuns > 0);
+    runs = jmax (1, numberOfRuns);
+}
+void BenchmarkBlockPatterns::setMaxSplits (const int maximumSplits)
+{
+    jassert (maximumSplits >= 0);
+    maxSplits = jmax (0, maximumSplits);
+}
+void BenchmarkBlockPatterns::setTimingSource (const BenchmarkTimer::Source source)
+{
+    timingSource = source;
+}
+int BenchmarkBlockPatterns::getHostBuffers() const
+{
+    return hostBuffers;
+}
+int BenchmarkBlockPatterns::getRuns() const
+{
+    return runs;
+}
+int BenchmarkBlockPatterns::getMaxSplits() const
+{
+    return maxSplits;
+}
+bool BenchmarkBlockPatterns::run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& processSpec, dsp::AudioBlock<float>& block,
+                                  const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    jassert (processSpec.sampleRate > 0.0 && processSpec.maximumBlockSize > 0);
+    jassert (block.getNumSamples() >= processSpec.maximumBlockSize && block.getNumChannels() >= processSpec.numChannels);
+
+    spec = processSpec;
+    slotResults.clear();
+    slotResults.resize (harnesses.size());
+
+    const auto maxBlockSize = static_cast<int> (spec.maximumBlockSize);
+    auto hostBlock = block.getSubBlock (0, spec.maximumBlockSize).getSubsetChannelBlock (0, spec.numChannels);
+
+    // The block sizes are generated up front (so that generating them isn't timed) & the same sequence is used for every processor
+    std::vector<std::vector<int>> blockSizes;
+    auto numHarnesses = 0;
+    for (const auto pattern : allPatterns)
+        blockSizes.push_back (generateBlockSizes (pattern, maxBlockSize));
+    for (size_t h = 0; h < harnesses.size(); ++h)
+    {
+        if (auto* harness = harnesses[h])
+        {
+            numHarnesses++;
+            slotResults[h].name = harness->getProcessorName();
+            if (!harness->setTimingSource (timingSource))
+                jassertfalse;
+        }
+    }
+
+    // Progress is measured in samples, as the number of calls varies so much between the patterns
+    auto numerator = 0.0;
+    const auto denominator = static_cast<double> (numHarnesses) * static_cast<double> (runs) * numPatterns * static_cast<double> (hostBuffers) * maxBlockSize;
+    const auto reportProgress = [&]
+    {
+        return progressCallback == nullptr || progressCallback (numerator / denominator);
+    };
+
+    auto completed = true;
+    for (size_t h = 0; h < harnesses.size() && completed; ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        for (size_t p = 0; p < allPatterns.size() && completed; ++p)
+        {
+            PatternResults results;
+            results.pattern = allPatterns[p];
+            const auto isHostSplit = results.pattern != Pattern::randomUniform;
+            harness->resetStatistics();
+
+            for (auto r = 0; r < runs && completed; ++r)
+            {
+                harness->resetHarness();
+                harness->prepareHarness (spec);
+
+                // Split patterns process consecutive parts of each host buffer, whereas the random sizes each start a new buffer
+                auto position = 0;
+                for (const auto numSamples : blockSizes[p])
+                {
+                    const auto offset = isHostSplit ? position : 0;
+                    auto subBlock = hostBlock.getSubBlock (static_cast<size_t> (offset), static_cast<size_t> (numSamples));
+                    const dsp::ProcessContextReplacing<float> context (subBlock);
+                    const auto steadyCallsBefore = harness->queryProcessingDurationNumSamples();
+                    harness->processHarness (context);
+
+                    // Only the steady state calls are totalled, so the totals cover the same calls as the average, p99 & max
+                    if (harness->queryProcessingDurationNumSamples() > steadyCallsBefore)
+                    {
+                        results.totalMs += harness->queryProcessingDurationLast();
+                        results.calls++;
+                        results.samples += numSamples;
+                    }
+
+                    // Progress is only reported at the end of each host buffer, so single sample calls aren't swamped by it
+                    position = (offset + numSamples) % maxBlockSize;
+                    numerator += numSamples;
+                    if ((position == 0 || !isHostSplit) && !reportProgress())
+                    {
+                        completed = false;
+                        break;
+                    }
+                }
+            }
+
+            // There are no steady state calls if the warm-up was as long as the runs
+            if (harness->queryProcessingDurationNumSamples() > 0.0)
+            {
+                results.avgCall = harness->queryProcessingDurationAverage();
+                results.p99Call = harness->queryProcessingDurationPercentile (99.0);
+                results.maxCall = harness->queryProcessingDurationMax();
+            }
+            if (completed)
+                slotResults[h].patterns.push_back (results);
+        }
+    }
+    return completed;
+}
+const std::vector<BenchmarkBlockPatterns::SlotResults>& BenchmarkBlockPatterns::getSlotResults() const
+{
+    return slotResults;
+}
+String BenchmarkBlockPatterns::getResultsAsText() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    String txt;
+    txt << "Spec: up to " << static_cast<int> (spec.maximumBlockSize) << " samples, " << numChannels << " channels, " << spec.sampleRate << " Hz" << newLine
+        << "Each pattern processes " << hostBuffers << " host buffers of samples, " << runs << " run(s), DAW splits at up to " << maxSplits << " points per buffer" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ")" << newLine
+            << "  Pattern              Calls  Avg block   ns/sample/ch   vs fixed   Avg call (us)   p99 call (us)" << newLine;
+        for (const auto& p : slot.patterns)
+        {
+            txt << "  " << getPatternName (p.pattern).paddedRight (' ', 16)
+                << String (p.calls).paddedLeft (' ', 9)
+                << String (p.getAverageBlockSize(), 1).paddedLeft (' ', 11)
+                << formatValue (p.getNsPerSample (numChannels), 3).paddedLeft (' ', 15)
+                << (formatValue (slot.getRelativeCost (p.pattern), 2) + "x").paddedLeft (' ', 11)
+                << String (p.avgCall * 1000.0, 2).paddedLeft (' ', 16)
+                << String (p.p99Call * 1000.0, 2).paddedLeft (' ', 16) << newLine;
+        }
+
+        const auto fixedCost = slot.getFixedCostPerCallNs();
+        if (std::isfinite (fixedCost))
+            txt << "  Estimated fixed cost per call: " << String (fixedCost, 1) << " ns (from the single sample & fixed patterns)" << newLine;
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkBlockPatterns::getResultsAsJson() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        Array<var> patterns;
+        for (const auto& p : slot.patterns)
+        {
+            auto* patternObj = new DynamicObject();
+            patternObj->setProperty ("pattern", getPatternKey (p.pattern));
+            patternObj->setProperty ("calls", p.calls);
+            patternObj->setProperty ("samples", p.samples);
+            patternObj->setProperty ("avg_block_size", p.getAverageBlockSize());
+            patternObj->setProperty ("ns_per_sample", toValue (p.getNsPerSample (numChannels)));
+            patternObj->setProperty ("relative_to_fixed", toValue (slot.getRelativeCost (p.pattern)));
+            patternObj->setProperty ("avg_call_us", p.avgCall * 1000.0);
+            patternObj->setProperty ("p99_call_us", p.p99Call * 1000.0);
+            patternObj->setProperty ("max_call_us", p.maxCall * 1000.0);
+            patterns.add (var (patternObj));
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("fixed_cost_per_call_ns", toValue (slot.getFixedCostPerCallNs()));
+        procObj->setProperty ("patterns", patterns);
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", numChannels);
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("hostBuffers", hostBuffers);
+    root->setProperty ("runs", runs);
+    root->setProperty ("maxSplits", maxSplits);
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkBlockPatterns::getResultsAsCsv() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    String csv ("slot,processor,pattern,calls,samples,avg_block_size,ns_per_sample,relative_to_fixed,avg_call_us,p99_call_us,max_call_us\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        for (const auto& p : slot.patterns)
+        {
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+            fields.add (slot.name.quoted());
+            fields.add (getPatternKey (p.pattern));
+            fields.add (String (p.calls));
+            fields.add (String (p.samples));
+            fields.add (String (p.getAverageBlockSize()));
+            fields.add (String (p.getNsPerSample (numChannels)));
+            fields.add (String (slot.getRelativeCost (p.pattern)));
+            fields.add (String (p.avgCall * 1000.0));
+            fields.add (String (p.p99Call * 1000.0));
+            fields.add (String (p.maxCall * 1000.0));
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+String BenchmarkBlockPatterns::getPatternName (const Pattern pattern)
+{
+    switch (pattern)
+    {
+        case Pattern::fixed: return "Fixed";
+        case Pattern::randomUniform: return "Random uniform";
+        case Pattern::dawSplit: return "DAW splits";
+        case Pattern::singleSample: return "Single sample";
+        default: return {};
+    }
+}
+String BenchmarkBlockPatterns::getPatternKey (const Pattern pattern)
+{
+    switch (pattern)
+    {
+        case Pattern::fixed: return "fixed";
+        case Pattern::randomUniform: return "random";
+        case Pattern::dawSplit: return "daw-split";
+        case Pattern::singleSample: return "single-sample";
+        default: return {};
+    }
+}
+std::vector<int> BenchmarkBlockPatterns::generateBlockSizes (const Pattern pattern, const int maxBlockSize) const
+{
+    // Seeded so that every run (& every build being compared) sees the same sequence
+    Random random (0xb10c);
+    std::vector<int> sizes;
+    const auto totalSamples = static_cast<int64> (hostBuffers) * maxBlockSize;
+
+    if (pattern == Pattern::fixed)
+    {
+        sizes.assign (static_cast<size_t> (hostBuffers), maxBlockSize);
+    }
+    else if (pattern == Pattern::singleSample)
+    {
+        sizes.assign (static_cast<size_t> (totalSamples), 1);
+    }
+    else if (pattern == Pattern::randomUniform)
+    {
+        // The last block is shortened so that every pattern processes the same number of samples
+        for (int64 remaining = totalSamples; remaining > 0;)
+        {
+            const auto size = static_cast<int> (jmin (remaining, static_cast<int64> (1 + random.nextInt (maxBlockSize))));
+            sizes.push_back (size);
+            remaining -= size;
+        }
+    }
+    else if (pattern == Pattern::dawSplit)
+    {
+        std::vector<int> splitPoints;
+        for (auto b = 0; b < hostBuffers; ++b)
+        {
+            splitPoints.clear();
+            const auto numSplits = maxBlockSize > 1 ? random.nextInt (maxSplits + 1) : 0;
+            for (auto i = 0; i < numSplits; ++i)
+                splitPoints.push_back (1 + random.nextInt (maxBlockSize - 1));
+            splitPoints.push_back (maxBlockSize);
+            std::sort (splitPoints.begin(), splitPoints.end());
+
+            // Coincident split points (e.g. two parameters automated at the same sample) only split the buffer once
+            auto start = 0;
+            for (const auto point : splitPoints)
+            {
+                if (point > start)
+                    sizes.push_back (point - start);
+                start = point;
+            }
+        }
+    }
+    else
+    {
+        jassertfalse;
+    }
+    return sizes;
+}
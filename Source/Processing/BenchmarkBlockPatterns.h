@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    BenchmarkBlockPatterns.h
+    Created: 18 Oct 2026 10:52:37pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Feeds each processor the same number of samples in blocks of varying size, as real hosts do, rather than always calling it
+ * with the maximum block size. Hosts split their buffers at automation & MIDI events, some vary the buffer size as the play
+ * position moves, and sample accurate automation can mean processing a single sample at a time. Comparing the cost per sample
+ * of each pattern against fixed size blocks exposes the fixed cost of each process call, which the constant block benchmark hides.
+ */
+class BenchmarkBlockPatterns
+{
+public:
+
+    /** Block size patterns (values start at 1 so they can be used as ComboBox IDs). */
+    enum class Pattern : int
+    {
+        fixed = 1,          /**< Every call is the maximum block size. */
+        randomUniform,      /**< Block sizes are uniformly distributed between 1 & the maximum block size. */
+        dawSplit,           /**< Each host buffer of the maximum block size is split at up to maxSplits random (automation) points. */
+        singleSample        /**< Every call is a single sample (e.g. sample accurate automation). */
+    };
+
+    static constexpr int numPatterns = 4;
+
+    /** Results for one pattern (times are in milliseconds, as per ProcessorHarness). */
+    struct PatternResults
+    {
+        Pattern pattern = Pattern::fixed;
+        int64 calls = 0;                /**< Number of steady state calls (the harness's warm-up calls are left out, as per its statistics). */
+        int64 samples = 0;              /**< Number of samples processed by the steady state calls (per channel). */
+        double totalMs = 0.0;           /**< Total time of the steady state calls. */
+        double avgCall = 0.0;
+        double p99Call = 0.0;
+        double maxCall = 0.0;
+
+        [[nodiscard]] double getAverageBlockSize() const;
+
+        /** Returns the cost in nanoseconds per sample per channel. */
+        [[nodiscard]] double getNsPerSample (const int numChannels) const;
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        std::vector<PatternResults> patterns {};
+
+        /** Returns the cost per sample of a pattern relative to fixed size blocks (NaN if either wasn't measured). */
+        [[nodiscard]] double getRelativeCost (const Pattern pattern) const;
+
+        /** Returns an estimate of the fixed cost of each process call in nanoseconds, from the difference between the single sample
+         *  & fixed patterns (which process about the same number of samples in a very different number of calls). NaN if either
+         *  wasn't measured.
+         */
+        [[nodiscard]] double getFixedCostPerCallNs() const;
+
+        [[nodiscard]] const PatternResults* getPattern (const Pattern pattern) const;
+    };
+
+    BenchmarkBlockPatterns() = default;
+    ~BenchmarkBlockPatterns() = default;
+
+    /** Set the number of host buffers (of the maximum block size) fed to the processor in each run. */
+    void setHostBuffers (const int numberOfHostBuffers);
+
+    /** Set the number of times each pattern is run through each processor (the processor is reset & prepared before each run). */
+    void setRuns (const int numberOfRuns);
+
+    /** Set the maximum number of points each host buffer is split at in the DAW split pattern. */
+    void setMaxSplits (const int maximumSplits);
+
+    /** Set the clock used to time the process calls. */
+    void setTimingSource (const BenchmarkTimer::Source source);
+
+    [[nodiscard]] int getHostBuffers() const;
+    [[nodiscard]] int getRuns() const;
+    [[nodiscard]] int getMaxSplits() const;
+
+    /** Runs each pattern against each non null harness using (sub blocks of) the given block, which should hold the test signal.
+     *  The harness statistics are reset for each pattern, so they are left holding the last one. Returns false if the run was
+     *  aborted by the progress callback.
+     */
+    bool run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& spec, dsp::AudioBlock<float>& block,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+    /** Returns a display name for a pattern (e.g. "Random uniform"). */
+    static String getPatternName (const Pattern pattern);
+
+    /** Returns a short name for a pattern, as used in the results & on the command line (e.g. "random"). */
+    static String getPatternKey (const Pattern pattern);
+
+private:
+
+    /** Returns the block sizes for a pattern, which add up to the given number of host buffers of the maximum block size. */
+    std::vector<int> generateBlockSizes (const Pattern pattern, const int maxBlockSize) const;
+
+    int hostBuffers = 1000;
+    int runs = 1;
+    int maxSplits = 3;
+    BenchmarkTimer::Source timingSource = BenchmarkTimer::Source::juceHighResolution;
+
+    dsp::ProcessSpec spec {};
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkBlockPatterns)
+};
@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    BenchmarkColdWarm.cpp
+    Created: 18 Oct 2026 8:58:07pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkColdWarm.h"
+
+namespace
+{
+    /** Returns a var for a statistic, or a void var if it isn't valid (e.g. a counter which wasn't available). */
+    var toValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+
+    String formatValue (const double value, const int decimalPlaces)
+    {
+        return std::isfinite (value) ? String (value, decimalPlaces) : String ("-");
+    }
+}
+
+void BenchmarkColdWarm::setColdState (const BenchmarkRunner::CacheState state)
+{
+    jassert (state != BenchmarkRunner::CacheState::warm);
+    coldState = state;
+}
+BenchmarkRunner::CacheState BenchmarkColdWarm::getColdState() const
+{
+    return coldState;
+}
+bool BenchmarkColdWarm::run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    slotResults.clear();
+    slotResults.resize (harnesses.size());
+    spec = runner.getProcessSpec();
+    lastLevelCacheSize = CacheEvictor::getLastLevelCacheSize();
+
+    const auto previousState = runner.getCacheState();
+    auto completed = true;
+    for (const auto pass : { 0, 1 })
+    {
+        for (auto* h : harnesses)
+            if (h) h->resetStatistics();
+
+        runner.setCacheState (pass == 0 ? BenchmarkRunner::CacheState::warm : coldState);
+        completed = runner.run (harnesses, [&progressCallback, pass] (const double progress)
+        {
+            return progressCallback == nullptr || progressCallback ((static_cast<double> (pass) + progress) / 2.0);
+        });
+        if (!completed)
+            break;
+
+        for (size_t h = 0; h < harnesses.size(); ++h)
+        {
+            if (auto* harness = harnesses[h])
+            {
+                slotResults[h].name = harness->getProcessorName();
+                (pass == 0 ? slotResults[h].warm : slotResults[h].cold) = summarise (*harness);
+            }
+        }
+    }
+
+    runner.setCacheState (previousState);
+    return completed;
+}
+const std::vector<BenchmarkColdWarm::SlotResults>& BenchmarkColdWarm::getSlotResults() const
+{
+    return slotResults;
+}
+String BenchmarkColdWarm::getResultsAsText() const
+{
+    String txt;
+    txt << "Spec: " << static_cast<int> (spec.maximumBlockSize) << " samples, " << static_cast<int> (spec.numChannels) << " channels, " << spec.sampleRate << " Hz" << newLine
+        << "Cold pass: " << BenchmarkRunner::getCacheStateName (coldState) << " (last level cache "
+        << (lastLevelCacheSize > 0 ? File::descriptionOfSizeInBytes (static_cast<int64> (lastLevelCacheSize)) : String ("unknown")) << ")" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ")" << newLine
+            << "                          Warm          Cold     Cold/Warm" << newLine;
+
+        const auto addRow = [&txt] (const String& name, const double warm, const double cold, const int decimalPlaces)
+        {
+            txt << "  " << name.paddedRight (' ', 18)
+                << formatValue (warm, decimalPlaces).paddedLeft (' ', 10)
+                << formatValue (cold, decimalPlaces).paddedLeft (' ', 14)
+                << (warm > 0.0 ? formatValue (cold / warm, 2) : String ("-")).paddedLeft (' ', 14) << newLine;
+        };
+        addRow ("Min (us)", slot.warm.min * 1000.0, slot.cold.min * 1000.0, 2);
+        addRow ("Avg (us)", slot.warm.avg * 1000.0, slot.cold.avg * 1000.0, 2);
+        addRow ("p50 (us)", slot.warm.p50 * 1000.0, slot.cold.p50 * 1000.0, 2);
+        addRow ("p99 (us)", slot.warm.p99 * 1000.0, slot.cold.p99 * 1000.0, 2);
+        addRow ("p99.9 (us)", slot.warm.p99_9 * 1000.0, slot.cold.p99_9 * 1000.0, 2);
+        addRow ("Max (us)", slot.warm.max * 1000.0, slot.cold.max * 1000.0, 2);
+        addRow ("Budget avg (%)", slot.warm.budget.meanFraction * 100.0, slot.cold.budget.meanFraction * 100.0, 1);
+        addRow ("Budget p99 (%)", slot.warm.budget.p99Fraction * 100.0, slot.cold.budget.p99Fraction * 100.0, 1);
+        addRow ("Deadline misses", slot.warm.budget.deadlineMisses, slot.cold.budget.deadlineMisses, 0);
+        if (slot.warm.counters.numSamples > 0.0 || slot.cold.counters.numSamples > 0.0)
+        {
+            addRow ("IPC", slot.warm.counters.getInstructionsPerCycle(), slot.cold.counters.getInstructionsPerCycle(), 2);
+            addRow ("L1D misses/sample", slot.warm.counters.getPerSample (PerformanceCounters::l1dReadMisses), slot.cold.counters.getPerSample (PerformanceCounters::l1dReadMisses), 3);
+            addRow ("LLC misses/sample", slot.warm.counters.getPerSample (PerformanceCounters::llcMisses), slot.cold.counters.getPerSample (PerformanceCounters::llcMisses), 4);
+        }
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkColdWarm::getResultsAsJson() const
+{
+    const auto summaryToVar = [] (const Summary& summary)
+    {
+        auto* obj = new DynamicObject();
+        obj->setProperty ("min_us", summary.min * 1000.0);
+        obj->setProperty ("avg_us", summary.avg * 1000.0);
+        obj->setProperty ("p50_us", summary.p50 * 1000.0);
+        obj->setProperty ("p99_us", summary.p99 * 1000.0);
+        obj->setProperty ("p99_9_us", summary.p99_9 * 1000.0);
+        obj->setProperty ("max_us", summary.max * 1000.0);
+        obj->setProperty ("budget_used_avg", summary.budget.meanFraction);
+        obj->setProperty ("budget_used_p99", summary.budget.p99Fraction);
+        obj->setProperty ("deadline_misses", static_cast<int64> (summary.budget.deadlineMisses));
+        if (summary.counters.numSamples > 0.0)
+        {
+            obj->setProperty ("ipc", toValue (summary.counters.getInstructionsPerCycle()));
+            obj->setProperty ("l1d_read_misses_per_sample", toValue (summary.counters.getPerSample (PerformanceCounters::l1dReadMisses)));
+            obj->setProperty ("llc_misses_per_sample", toValue (summary.counters.getPerSample (PerformanceCounters::llcMisses)));
+        }
+        return var (obj);
+    };
+
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("warm", summaryToVar (slot.warm));
+        procObj->setProperty ("cold", summaryToVar (slot.cold));
+        procObj->setProperty ("cold_warm_ratio_avg", slot.warm.avg > 0.0 ? var (slot.cold.avg / slot.warm.avg) : var());
+        procObj->setProperty ("cold_warm_ratio_p99", slot.warm.p99 > 0.0 ? var (slot.cold.p99 / slot.warm.p99) : var());
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", static_cast<int> (spec.numChannels));
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("coldState", BenchmarkRunner::getCacheStateName (coldState));
+    root->setProperty ("lastLevelCacheBytes", static_cast<int64> (lastLevelCacheSize));
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkColdWarm::getResultsAsCsv() const
+{
+    String csv ("slot,processor,cache,min_us,avg_us,p50_us,p99_us,p99_9_us,max_us,budget_used_avg,budget_used_p99,deadline_misses,ipc,l1d_read_misses_per_sample,llc_misses_per_sample\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        for (const auto pass : { 0, 1 })
+        {
+            const auto& summary = pass == 0 ? slot.warm : slot.cold;
+            const auto hasCounters = summary.counters.numSamples > 0.0;
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+            fields.add (slot.name.quoted());
+            fields.add (BenchmarkRunner::getCacheStateName (pass == 0 ? BenchmarkRunner::CacheState::warm : coldState));
+            for (const auto value : { summary.min, summary.avg, summary.p50, summary.p99, summary.p99_9, summary.max })
+                fields.add (String (value * 1000.0));
+            fields.add (String (summary.budget.meanFraction));
+            fields.add (String (summary.budget.p99Fraction));
+            fields.add (String (static_cast<int64> (summary.budget.deadlineMisses)));
+            fields.add (hasCounters ? toValue (summary.counters.getInstructionsPerCycle()).toString() : String());
+            fields.add (hasCounters ? toValue (summary.counters.getPerSample (PerformanceCounters::l1dReadMisses)).toString() : String());
+            fields.add (hasCounters ? toValue (summary.counters.getPerSample (PerformanceCounters::llcMisses)).toString() : String());
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+BenchmarkColdWarm::Summary BenchmarkColdWarm::summarise (const ProcessorHarness& harness)
+{
+    Summary summary;
+    summary.counters = harness.getPerformanceCounterTotals();
+    if (harness.queryProcessingDurationNumSamples() <= 0.0)
+        return summary;
+
+    summary.min = harness.queryProcessingDurationMin();
+    summary.avg = harness.queryProcessingDurationAverage();
+    summary.p50 = harness.queryProcessingDurationPercentile (50.0);
+    summary.p99 = harness.queryProcessingDurationPercentile (99.0);
+    summary.p99_9 = harness.queryProcessingDurationPercentile (99.9);
+    summary.max = harness.queryProcessingDurationMax();
+    summary.budget = RealtimeBudget::forProcessing (harness);
+    return summary;
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    BenchmarkColdWarm.h
+    Created: 18 Oct 2026 8:58:07pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Runs the benchmark cycles twice - once with warm caches and once with the caches evicted before every process call - so that
+ * the best case numbers can be reported side by side with the numbers you'd expect in a busy DAW.
+ */
+class BenchmarkColdWarm
+{
+public:
+
+    /** Process routine statistics from one pass (times are in milliseconds, as per ProcessorHarness). */
+    struct Summary
+    {
+        double min = 0.0;
+        double avg = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double p99_9 = 0.0;
+        double max = 0.0;
+        RealtimeBudget budget {};
+        PerformanceCounters::Totals counters {};
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        Summary warm {};
+        Summary cold {};
+    };
+
+    BenchmarkColdWarm() = default;
+    ~BenchmarkColdWarm() = default;
+
+    /** Set the cache state used for the cold pass (either cold or coldWithInstructionCache). */
+    void setColdState (const BenchmarkRunner::CacheState state);
+    [[nodiscard]] BenchmarkRunner::CacheState getColdState() const;
+
+    /** Runs the warm pass & then the cold pass using the runner's settings, resetting the statistics of the harnesses before each
+     *  pass (so they are left holding the cold pass). The runner's cache state is restored afterwards. Returns false if aborted.
+     */
+    bool run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+private:
+
+    static Summary summarise (const ProcessorHarness& harness);
+
+    BenchmarkRunner::CacheState coldState = BenchmarkRunner::CacheState::cold;
+    dsp::ProcessSpec spec {};
+    size_t lastLevelCacheSize = 0;
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkColdWarm)
+};
@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+    BenchmarkComparison.cpp
+    Created: 18 Oct 2026 6:07:25pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkComparison.h"
+
+namespace
+{
+    constexpr auto numBootstrapResamples = 2000;
+    constexpr auto roundsBetweenAnalyses = 10;
+
+    /** Returns the total time of the steady state process calls made by the harness so far (in milliseconds). */
+    double getProcessingDurationSum (const ProcessorHarness& harness)
+    {
+        const auto count = harness.queryProcessingDurationNumSamples();
+        return count > 0.0 ? harness.queryProcessingDurationAverage() * count : 0.0;
+    }
+
+    /** Returns the two sided p-value of the Wilcoxon signed-rank test for paired samples (using the normal approximation). */
+    double getWilcoxonSignedRankPValue (const std::vector<double>& a, const std::vector<double>& b)
+    {
+        std::vector<double> differences;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (b[i] != a[i])
+                differences.push_back (b[i] - a[i]);
+
+        const auto n = static_cast<double> (differences.size());
+        if (differences.size() < 2)
+            return 1.0;
+
+        std::sort (differences.begin(), differences.end(), [] (const double x, const double y) { return std::abs (x) < std::abs (y); });
+
+        // Sum the ranks of the positive differences (tied magnitudes share the average rank)
+        auto positiveRankSum = 0.0;
+        auto tieCorrection = 0.0;
+        for (size_t i = 0; i < differences.size();)
+        {
+            auto j = i;
+            while (j + 1 < differences.size() && std::abs (differences[j + 1]) == std::abs (differences[i]))
+                ++j;
+            const auto rank = (static_cast<double> (i + j) / 2.0) + 1.0;
+            const auto numTied = static_cast<double> (j - i + 1);
+            tieCorrection += numTied * numTied * numTied - numTied;
+            for (auto k = i; k <= j; ++k)
+                if (differences[k] > 0.0)
+                    positiveRankSum += rank;
+            i = j + 1;
+        }
+
+        const auto mean = n * (n + 1.0) / 4.0;
+        const auto variance = n * (n + 1.0) * (2.0 * n + 1.0) / 24.0 - tieCorrection / 48.0;
+        if (variance <= 0.0)
+            return 1.0;
+        const auto z = (positiveRankSum - mean) / std::sqrt (variance);
+        return std::erfc (std::abs (z) / MathConstants<double>::sqrt2);
+    }
+}
+
+void BenchmarkComparison::setBatchIterations (const int iterations)
+{
+    jassert (iterations > 0);
+    batchIterations = iterations;
+}
+void BenchmarkComparison::setRoundLimits (const int minimum, const int maximum)
+{
+    jassert (minimum > 1 && maximum >= minimum);
+    minRounds = minimum;
+    maxRounds = maximum;
+}
+void BenchmarkComparison::setTargetPrecision (const double relativeHalfWidth)
+{
+    jassert (relativeHalfWidth > 0.0);
+    targetPrecision = relativeHalfWidth;
+}
+void BenchmarkComparison::setConfidenceLevel (const double level)
+{
+    jassert (level > 0.0 && level < 1.0);
+    confidenceLevel = level;
+}
+int BenchmarkComparison::getBatchIterations() const
+{
+    return batchIterations;
+}
+double BenchmarkComparison::getTargetPrecision() const
+{
+    return targetPrecision;
+}
+double BenchmarkComparison::getConfidenceLevel() const
+{
+    return confidenceLevel;
+}
+bool BenchmarkComparison::run (ProcessorHarness& harnessA, ProcessorHarness& harnessB, const dsp::ProcessSpec& spec, dsp::AudioBlock<float>& block,
+                               const std::function<bool (double)>& progressCallback)
+{
+    nameA = harnessA.getProcessorName();
+    nameB = harnessB.getProcessorName();
+    roundsA.clear();
+    roundsB.clear();
+    result = {};
+
+    const dsp::ProcessContextReplacing<float> context (block);
+    for (auto* h : { &harnessA, &harnessB })
+    {
+        h->resetHarness();
+        h->prepareHarness (spec);
+    }
+
+    // Warm-up calls are left out of the harness's sum, so the average is over the steady state calls of the batch (NaN if there were none)
+    const auto runBatch = [this, &context] (ProcessorHarness& harness)
+    {
+        const auto sumBefore = getProcessingDurationSum (harness);
+        const auto countBefore = harness.queryProcessingDurationNumSamples();
+        for (auto i = 0; i < batchIterations; ++i)
+            harness.processHarness (context);
+        const auto count = harness.queryProcessingDurationNumSamples() - countBefore;
+        return count > 0.0 ? (getProcessingDurationSum (harness) - sumBefore) / count : std::numeric_limits<double>::quiet_NaN();
+    };
+
+    // The warm-up (which only follows prepare) is run once up front, a batch at a time so that a long warm-up can be cancelled,
+    // rather than by retrying rounds until their batches are past it
+    for (auto* h : { &harnessA, &harnessB })
+    {
+        while (h->getIterationClassifier().isWarmingUp())
+        {
+            for (auto i = 0; i < batchIterations && h->getIterationClassifier().isWarmingUp(); ++i)
+                h->processHarness (context);
+            if (progressCallback != nullptr && !progressCallback (0.0))
+                return false;
+        }
+    }
+
+    for (auto round = 0; round < maxRounds;)
+    {
+        // Alternate which processor goes first so that neither always follows the other
+        auto meanA = 0.0, meanB = 0.0;
+        if (round % 2 == 0)
+        {
+            meanA = runBatch (harnessA);
+            meanB = runBatch (harnessB);
+        }
+        else
+        {
+            meanB = runBatch (harnessB);
+            meanA = runBatch (harnessA);
+        }
+
+        // A batch with no steady state calls has nothing to compare (which can't happen after the warm-up), so the round is run
+        // again, without stopping the run from being cancelled
+        if (std::isnan (meanA) || std::isnan (meanB))
+        {
+            jassertfalse;
+            if (progressCallback != nullptr && !progressCallback (static_cast<double> (round) / static_cast<double> (maxRounds)))
+                return false;
+            continue;
+        }
+        roundsA.push_back (meanA);
+        roundsB.push_back (meanB);
+
+        const auto numRounds = ++round;
+        if (numRounds >= minRounds && (numRounds % roundsBetweenAnalyses == 0 || numRounds == maxRounds))
+        {
+            analyse();
+            if (result.ratio > 0.0 && (result.ratioHigh - result.ratioLow) / 2.0 <= targetPrecision * result.ratio)
+            {
+                result.converged = true;
+                break;
+            }
+        }
+
+        if (progressCallback != nullptr && !progressCallback (static_cast<double> (numRounds) / static_cast<double> (maxRounds)))
+            return false;
+    }
+
+    analyse();
+    result.converged = result.ratio > 0.0 && (result.ratioHigh - result.ratioLow) / 2.0 <= targetPrecision * result.ratio;
+    return true;
+}
+const BenchmarkComparison::Result& BenchmarkComparison::getResult() const
+{
+    return result;
+}
+const std::vector<double>& BenchmarkComparison::getRoundsA() const
+{
+    return roundsA;
+}
+const std::vector<double>& BenchmarkComparison::getRoundsB() const
+{
+    return roundsB;
+}
+String BenchmarkComparison::getResultAsText() const
+{
+    String txt;
+    txt << "A: " << nameA << newLine << "B: " << nameB << newLine << newLine;
+    if (result.numRounds == 0)
+        return txt << "No results" << newLine;
+
+    const auto confidencePercent = String (confidenceLevel * 100.0, 0);
+    txt << "Rounds:          " << result.numRounds << " (" << batchIterations << " process calls per processor per round)" << newLine
+        << "Mean A:          " << String (result.meanA * 1000.0, 3) << " us per call" << newLine
+        << "Mean B:          " << String (result.meanB * 1000.0, 3) << " us per call" << newLine
+        << "Ratio B/A:       " << String (result.ratio, 4) << " (" << confidencePercent << "% CI " << String (result.ratioLow, 4) << " .. " << String (result.ratioHigh, 4) << ")" << newLine
+        << "p-value:         " << String (result.pValue, 6) << " (Wilcoxon signed-rank)" << newLine
+        << "Precision:       " << (result.converged ? "reached" : "not reached") << " (target +/- " << String (targetPrecision * 100.0, 2) << "%)" << newLine << newLine;
+
+    const auto percent = std::abs (result.ratio - 1.0) * 100.0;
+    const auto significant = result.pValue < 1.0 - confidenceLevel && (result.ratioLow > 1.0 || result.ratioHigh < 1.0);
+    if (significant)
+        txt << "B is " << String (percent, 1) << "% " << (result.ratio > 1.0 ? "slower" : "faster") << " than A (significant at the " << confidencePercent << "% level)" << newLine;
+    else
+        txt << "No significant difference between A and B at the " << confidencePercent << "% level" << newLine;
+    return txt;
+}
+var BenchmarkComparison::getResultAsJson() const
+{
+    auto* root = new DynamicObject();
+    root->setProperty ("a", nameA);
+    root->setProperty ("b", nameB);
+    root->setProperty ("rounds", result.numRounds);
+    root->setProperty ("batchIterations", batchIterations);
+    root->setProperty ("confidenceLevel", confidenceLevel);
+    root->setProperty ("targetPrecision", targetPrecision);
+    root->setProperty ("converged", result.converged);
+    root->setProperty ("meanA_us", result.meanA * 1000.0);
+    root->setProperty ("meanB_us", result.meanB * 1000.0);
+    root->setProperty ("ratio", result.ratio);
+    root->setProperty ("ratioLow", result.ratioLow);
+    root->setProperty ("ratioHigh", result.ratioHigh);
+    root->setProperty ("pValue", result.pValue);
+
+    Array<var> a, b;
+    for (size_t i = 0; i < roundsA.size(); ++i)
+    {
+        a.add (roundsA[i] * 1000.0);
+        b.add (roundsB[i] * 1000.0);
+    }
+    root->setProperty ("roundsA_us", a);
+    root->setProperty ("roundsB_us", b);
+    return var (root);
+}
+String BenchmarkComparison::getRoundsAsCsv() const
+{
+    String csv ("round,a_us,b_us\n");
+    for (size_t i = 0; i < roundsA.size(); ++i)
+        csv << static_cast<int> (i + 1) << "," << roundsA[i] * 1000.0 << "," << roundsB[i] * 1000.0 << "\n";
+    return csv;
+}
+void BenchmarkComparison::analyse()
+{
+    const auto n = roundsA.size();
+    result.numRounds = static_cast<int> (n);
+    if (n == 0)
+        return;
+
+    const auto sumA = std::accumulate (roundsA.begin(), roundsA.end(), 0.0);
+    const auto sumB = std::accumulate (roundsB.begin(), roundsB.end(), 0.0);
+    result.meanA = sumA / static_cast<double> (n);
+    result.meanB = sumB / static_cast<double> (n);
+    result.ratio = sumA > 0.0 ? sumB / sumA : 0.0;
+
+    // Bootstrap the ratio by resampling whole rounds (keeping the pairs together). A fixed seed keeps the interval repeatable.
+    Random random (0x5eed);
+    std::vector<double> ratios;
+    ratios.reserve (static_cast<size_t> (numBootstrapResamples));
+    for (auto r = 0; r < numBootstrapResamples; ++r)
+    {
+        auto resampledSumA = 0.0, resampledSumB = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto idx = static_cast<size_t> (random.nextInt (static_cast<int> (n)));
+            resampledSumA += roundsA[idx];
+            resampledSumB += roundsB[idx];
+        }
+        if (resampledSumA > 0.0)
+            ratios.push_back (resampledSumB / resampledSumA);
+    }
+
+    if (!ratios.empty())
+    {
+        std::sort (ratios.begin(), ratios.end());
+        const auto tail = (1.0 - confidenceLevel) / 2.0;
+        const auto last = static_cast<double> (ratios.size() - 1);
+        result.ratioLow = ratios[static_cast<size_t> (std::floor (tail * last))];
+        result.ratioHigh = ratios[static_cast<size_t> (std::ceil ((1.0 - tail) * last))];
+    }
+
+    result.pValue = getWilcoxonSignedRankPValue (roundsA, roundsB);
+}
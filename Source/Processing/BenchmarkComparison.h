@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    BenchmarkComparison.h
+    Created: 18 Oct 2026 6:07:25pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ProcessorHarness.h"
+
+/**
+ * Compares the processing time of two harnesses by interleaving batches of process calls (A then B, then B then A, and so on)
+ * so that frequency scaling & thermal drift affect both equally. Each round gives a paired sample of the average time per call
+ * for each processor, from which the B/A time ratio is estimated with a bootstrap confidence interval and a Wilcoxon signed-rank
+ * test. Rounds continue until the confidence interval is narrow enough, or the maximum number of rounds is reached.
+ */
+class BenchmarkComparison
+{
+public:
+
+    struct Result
+    {
+        int numRounds = 0;
+        double meanA = 0.0;             /**< Average time per process call for A (milliseconds). */
+        double meanB = 0.0;             /**< Average time per process call for B (milliseconds). */
+        double ratio = 0.0;             /**< Ratio of B's time to A's time (i.e. > 1 if B is slower). */
+        double ratioLow = 0.0;          /**< Lower bound of the confidence interval of the ratio. */
+        double ratioHigh = 0.0;         /**< Upper bound of the confidence interval of the ratio. */
+        double pValue = 1.0;            /**< Two sided p-value of the Wilcoxon signed-rank test (null hypothesis: no difference). */
+        bool converged = false;         /**< True if the target precision was reached before the maximum number of rounds. */
+    };
+
+    BenchmarkComparison() = default;
+    ~BenchmarkComparison() = default;
+
+    /** Set the number of process calls for each processor in each round. */
+    void setBatchIterations (const int iterations);
+
+    /** Set the minimum & maximum number of rounds (each round runs a batch of A and a batch of B). */
+    void setRoundLimits (const int minimum, const int maximum);
+
+    /** Set the target precision (half width of the confidence interval relative to the ratio, e.g. 0.01 for +/- 1%). */
+    void setTargetPrecision (const double relativeHalfWidth);
+
+    /** Set the confidence level for the interval (e.g. 0.95). */
+    void setConfidenceLevel (const double level);
+
+    [[nodiscard]] int getBatchIterations() const;
+    [[nodiscard]] double getTargetPrecision() const;
+    [[nodiscard]] double getConfidenceLevel() const;
+
+    /** Runs the comparison (both harnesses are reset & prepared first). Returns false if it was aborted by the progress callback. */
+    bool run (ProcessorHarness& harnessA, ProcessorHarness& harnessB, const dsp::ProcessSpec& spec, dsp::AudioBlock<float>& block,
+              const std::function<bool (double)>& progressCallback = nullptr);
+
+    [[nodiscard]] const Result& getResult() const;
+
+    /** Returns the average time per call of each round (milliseconds), in the order the rounds were run. */
+    [[nodiscard]] const std::vector<double>& getRoundsA() const;
+    [[nodiscard]] const std::vector<double>& getRoundsB() const;
+
+    /** Returns a readable summary of the result. */
+    [[nodiscard]] String getResultAsText() const;
+
+    /** Returns the result (and the round data) as a JSON object (times are in microseconds). */
+    [[nodiscard]] var getResultAsJson() const;
+
+    /** Returns the round data as CSV text with a header row (times are in microseconds). */
+    [[nodiscard]] String getRoundsAsCsv() const;
+
+private:
+
+    /** Updates the result from the rounds gathered so far. */
+    void analyse();
+
+    int batchIterations = 100;
+    int minRounds = 20;
+    int maxRounds = 500;
+    double targetPrecision = 0.01;
+    double confidenceLevel = 0.95;
+    String nameA {}, nameB {};
+    std::vector<double> roundsA {}, roundsB {};
+    Result result {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkComparison)
+};
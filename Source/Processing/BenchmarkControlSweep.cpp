@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+
+    BenchmarkControlSweep.cpp
+    Created: 18 Oct 2026 11:36:48pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkControlSweep.h"
+
+namespace
+{
+    var toCostValue (const double nanoseconds)
+    {
+        if (!std::isfinite (nanoseconds))
+            return {};
+        return nanoseconds;
+    }
+
+    String formatCost (const double nanoseconds, const int width)
+    {
+        return (std::isfinite (nanoseconds) ? String (nanoseconds, 2) : String ("-")).paddedLeft (' ', width);
+    }
+
+    var costToVar (const BenchmarkSweep::Cost& cost)
+    {
+        auto* obj = new DynamicObject();
+        obj->setProperty ("min_ns_per_sample", toCostValue (cost.min));
+        obj->setProperty ("avg_ns_per_sample", toCostValue (cost.avg));
+        obj->setProperty ("p50_ns_per_sample", toCostValue (cost.p50));
+        obj->setProperty ("p99_ns_per_sample", toCostValue (cost.p99));
+        return var (obj);
+    }
+}
+
+const BenchmarkControlSweep::Point* BenchmarkControlSweep::SlotResults::getWorstPoint() const
+{
+    const Point* worst = nullptr;
+    for (const auto& p : points)
+        if (std::isfinite (p.cost.avg) && (worst == nullptr || p.cost.avg > worst->cost.avg))
+            worst = &p;
+    return worst;
+}
+void BenchmarkControlSweep::setSteps (const int numberOfSteps)
+{
+    jassert (numberOfSteps >= 2);
+    steps = jmax (2, numberOfSteps);
+}
+void BenchmarkControlSweep::setControls (const int controlX, const int controlY)
+{
+    sweptControlX = jmax (-1, controlX);
+    sweptControlY = sweptControlX < 0 || controlY == controlX ? -1 : jmax (-1, controlY);
+}
+int BenchmarkControlSweep::getSteps() const
+{
+    return steps;
+}
+int BenchmarkControlSweep::getControlX() const
+{
+    return sweptControlX;
+}
+int BenchmarkControlSweep::getControlY() const
+{
+    return sweptControlY;
+}
+bool BenchmarkControlSweep::isPair() const
+{
+    return sweptControlY >= 0;
+}
+double BenchmarkControlSweep::getStepValue (const int step) const
+{
+    return static_cast<double> (step) / static_cast<double> (steps - 1);
+}
+bool BenchmarkControlSweep::run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const BenchmarkSweep::FillCallback& fillCallback,
+                                 const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    spec = runner.getProcessSpec();
+    slotResults.clear();
+    slotResults.resize (harnesses.size());
+
+    // Each harness is run on its own, with one extra run at the default settings as the reference
+    std::vector<std::vector<Point>> points (harnesses.size());
+    auto numRuns = 0;
+    for (size_t h = 0; h < harnesses.size(); ++h)
+    {
+        if (auto* harness = harnesses[h])
+        {
+            slotResults[h].name = harness->getProcessorName();
+            for (auto c = 0; c < harness->getNumControls(); ++c)
+                slotResults[h].controlNames.add (harness->getControlName (c));
+            points[h] = getPoints (harness->getNumControls());
+            numRuns += 1 + static_cast<int> (points[h].size());
+        }
+    }
+
+    auto runIndex = 0;
+    const auto runAtCurrentSettings = [&] (ProcessorHarness* harness, const size_t harnessIndex, BenchmarkSweep::Cost& cost)
+    {
+        if (fillCallback)
+            fillCallback (runner.getAudioBlock(), spec);
+        harness->resetStatistics();
+
+        std::vector<ProcessorHarness*> single (harnesses.size(), nullptr);
+        single[harnessIndex] = harness;
+        const auto completed = runner.run (single, [&] (const double progress)
+        {
+            return progressCallback == nullptr || progressCallback ((static_cast<double> (runIndex) + progress) / static_cast<double> (numRuns));
+        });
+        cost = BenchmarkSweep::getCost (harness, spec);
+        runIndex++;
+        return completed;
+    };
+
+    auto completed = true;
+    for (size_t h = 0; h < harnesses.size() && completed; ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        // The sweep leaves the controls as it found them (e.g. as set by the sliders in the GUI)
+        std::vector<double> savedValues;
+        for (auto c = 0; c < harness->getNumControls(); ++c)
+        {
+            savedValues.push_back (harness->getControlValue (c));
+            harness->setControlValue (c, harness->getDefaultControlValue (c));
+        }
+
+        completed = runAtCurrentSettings (harness, h, slotResults[h].defaultCost);
+        for (auto& point : points[h])
+        {
+            if (!completed)
+                break;
+
+            for (auto c = 0; c < harness->getNumControls(); ++c)
+                harness->setControlValue (c, harness->getDefaultControlValue (c));
+            harness->setControlValue (point.controlX, point.valueX);
+            if (point.controlY >= 0)
+                harness->setControlValue (point.controlY, point.valueY);
+
+            completed = runAtCurrentSettings (harness, h, point.cost);
+            if (completed)
+                slotResults[h].points.push_back (point);
+        }
+
+        for (auto c = 0; c < static_cast<int> (savedValues.size()); ++c)
+            harness->setControlValue (c, savedValues[static_cast<size_t> (c)]);
+    }
+    return completed;
+}
+const std::vector<BenchmarkControlSweep::SlotResults>& BenchmarkControlSweep::getSlotResults() const
+{
+    return slotResults;
+}
+String BenchmarkControlSweep::getResultsAsText() const
+{
+    constexpr auto columnWidth = 14;
+    String txt;
+    txt << "Spec: " << static_cast<int> (spec.maximumBlockSize) << " samples, " << static_cast<int> (spec.numChannels) << " channels, "
+        << spec.sampleRate << " Hz, " << steps << " steps per control" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ") - average ns per sample per channel";
+        if (slot.points.empty())
+        {
+            txt << newLine << "  " << (slot.controlNames.isEmpty() ? "No controls to sweep" : "The swept controls don't exist") << newLine << newLine;
+            continue;
+        }
+        const auto pair = slot.points.front().controlY >= 0;
+        if (pair)
+            txt << ", " << slot.controlNames[slot.points.front().controlX] << " down, " << slot.controlNames[slot.points.front().controlY] << " across";
+        txt << newLine << String ("Value").paddedRight (' ', 8);
+
+        // The columns are either the values of the second control of a pair, or each control swept on its own
+        Array<int> columnControls;
+        for (const auto& p : slot.points)
+            columnControls.addIfNotAlreadyThere (p.controlX);
+        if (pair)
+        {
+            for (auto step = 0; step < steps; ++step)
+                txt << String (getStepValue (step), 2).paddedLeft (' ', columnWidth);
+        }
+        else
+        {
+            for (const auto c : columnControls)
+                txt << slot.controlNames[c].substring (0, columnWidth - 1).paddedLeft (' ', columnWidth);
+        }
+        txt << newLine;
+
+        for (auto row = 0; row < steps; ++row)
+        {
+            const auto rowValue = getStepValue (row);
+            txt << String (rowValue, 2).paddedRight (' ', 8);
+            for (const auto& p : slot.points)
+                if (p.valueX == rowValue)
+                    txt << formatCost (p.cost.avg, columnWidth);
+            txt << newLine;
+        }
+
+        txt << "Default controls " << formatCost (slot.defaultCost.avg, 0) << " ns (p99 " << formatCost (slot.defaultCost.p99, 0) << " ns)" << newLine;
+        if (const auto* worst = slot.getWorstPoint())
+        {
+            txt << "Worst case " << slot.controlNames[worst->controlX] << " = " << String (worst->valueX, 2);
+            if (worst->controlY >= 0)
+                txt << ", " << slot.controlNames[worst->controlY] << " = " << String (worst->valueY, 2);
+            txt << ": " << formatCost (worst->cost.avg, 0) << " ns (p99 " << formatCost (worst->cost.p99, 0) << " ns)";
+            if (slot.defaultCost.avg > 0.0)
+                txt << ", " << String (worst->cost.avg / slot.defaultCost.avg, 2) << "x the default controls";
+            txt << newLine;
+        }
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkControlSweep::getResultsAsJson() const
+{
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        Array<var> pointArray;
+        for (const auto& p : slot.points)
+        {
+            auto pointResult = costToVar (p.cost);
+            auto* pointObj = pointResult.getDynamicObject();
+            pointObj->setProperty ("controlX", p.controlX);
+            pointObj->setProperty ("valueX", p.valueX);
+            if (p.controlY >= 0)
+            {
+                pointObj->setProperty ("controlY", p.controlY);
+                pointObj->setProperty ("valueY", p.valueY);
+            }
+            pointArray.add (pointResult);
+        }
+
+        var worstResult;
+        if (const auto* worst = slot.getWorstPoint())
+        {
+            worstResult = costToVar (worst->cost);
+            worstResult.getDynamicObject()->setProperty ("controlX", worst->controlX);
+            worstResult.getDynamicObject()->setProperty ("valueX", worst->valueX);
+            if (worst->controlY >= 0)
+            {
+                worstResult.getDynamicObject()->setProperty ("controlY", worst->controlY);
+                worstResult.getDynamicObject()->setProperty ("valueY", worst->valueY);
+            }
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("controls", slot.controlNames);
+        procObj->setProperty ("default", costToVar (slot.defaultCost));
+        procObj->setProperty ("worst", worstResult);
+        procObj->setProperty ("points", pointArray);
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", static_cast<int> (spec.numChannels));
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("steps", steps);
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkControlSweep::getResultsAsCsv() const
+{
+    String csv ("slot,processor,control_x,value_x,control_y,value_y,min_ns_per_sample,avg_ns_per_sample,p50_ns_per_sample,p99_ns_per_sample\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        for (const auto& p : slot.points)
+        {
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+            fields.add (slot.name.quoted());
+            fields.add (slot.controlNames[p.controlX].quoted());
+            fields.add (String (p.valueX));
+            fields.add (p.controlY >= 0 ? slot.controlNames[p.controlY].quoted() : String());
+            fields.add (p.controlY >= 0 ? String (p.valueY) : String());
+            fields.add (toCostValue (p.cost.min).toString());
+            fields.add (toCostValue (p.cost.avg).toString());
+            fields.add (toCostValue (p.cost.p50).toString());
+            fields.add (toCostValue (p.cost.p99).toString());
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+std::vector<BenchmarkControlSweep::Point> BenchmarkControlSweep::getPoints (const int numControls) const
+{
+    std::vector<Point> points;
+    if (sweptControlX >= numControls || sweptControlY >= numControls)
+        return points;
+
+    if (isPair())
+    {
+        for (auto x = 0; x < steps; ++x)
+        {
+            for (auto y = 0; y < steps; ++y)
+            {
+                Point point;
+                point.controlX = sweptControlX;
+                point.valueX = getStepValue (x);
+                point.controlY = sweptControlY;
+                point.valueY = getStepValue (y);
+                points.push_back (point);
+            }
+        }
+        return points;
+    }
+
+    // Ordered by value then control, so that each row of the text table is one value
+    for (auto step = 0; step < steps; ++step)
+    {
+        for (auto c = 0; c < numControls; ++c)
+        {
+            if (sweptControlX >= 0 && c != sweptControlX)
+                continue;
+
+            Point point;
+            point.controlX = c;
+            point.valueX = getStepValue (step);
+            points.push_back (point);
+        }
+    }
+    return points;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    BenchmarkControlSweep.h
+    Created: 18 Oct 2026 11:36:48pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkSweep.h"
+
+/**
+ * Runs the benchmark cycles with the processor's controls stepped across their 0..1 range, either each control on its own (a
+ * curve for each control) or a pair of controls together (a surface), with the other controls at their default values. The
+ * cost of some processors depends on their settings (e.g. filter order, oversampling factor or lookahead length), & it is the
+ * worst case setting which limits how many instances can run, whereas the other benchmarks only measure the current settings.
+ */
+class BenchmarkControlSweep
+{
+public:
+
+    /** Processing cost of a harness with the swept control(s) at one setting. */
+    struct Point
+    {
+        int controlX = 0;
+        double valueX = 0.0;
+        int controlY = -1;              /**< Second control of a pair (-1 when a single control is swept). */
+        double valueY = 0.0;
+        BenchmarkSweep::Cost cost {};   /**< In nanoseconds per sample per channel. */
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        StringArray controlNames {};
+        BenchmarkSweep::Cost defaultCost {};    /**< Cost with all of the controls at their default values. */
+        std::vector<Point> points {};
+
+        /** Returns the point with the highest average cost (nullptr if there aren't any). */
+        [[nodiscard]] const Point* getWorstPoint() const;
+    };
+
+    BenchmarkControlSweep() = default;
+    ~BenchmarkControlSweep() = default;
+
+    /** Set the number of values each control is stepped through (from 0 to 1 inclusive, at least 2). */
+    void setSteps (const int numberOfSteps);
+
+    /** Set the controls to sweep: a negative x sweeps each control on its own, a negative y sweeps control x on its own, &
+     *  otherwise controls x & y are swept together over a grid of values.
+     */
+    void setControls (const int controlX, const int controlY);
+
+    [[nodiscard]] int getSteps() const;
+    [[nodiscard]] int getControlX() const;
+    [[nodiscard]] int getControlY() const;
+    [[nodiscard]] bool isPair() const;
+
+    /** Returns the control value for a step. */
+    [[nodiscard]] double getStepValue (const int step) const;
+
+    /** Runs the runner's test cycles at its current spec for each setting of the controls of each harness in turn (the harness
+     *  statistics are reset for each setting, & the control values are restored afterwards). The block is refilled before each
+     *  setting, as processing it in place for every setting would otherwise change the signal. Returns false if aborted.
+     */
+    bool run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const BenchmarkSweep::FillCallback& fillCallback,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    /** Returns text tables of the average cost for each processor (values down, controls or the second control across), along
+     *  with the worst case setting.
+     */
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+private:
+
+    /** Returns the settings to sweep for a harness with the given number of controls. */
+    [[nodiscard]] std::vector<Point> getPoints (const int numControls) const;
+
+    int steps = 11;
+    int sweptControlX = -1;
+    int sweptControlY = -1;
+    dsp::ProcessSpec spec {};
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkControlSweep)
+};
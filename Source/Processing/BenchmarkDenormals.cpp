@@ -0,0 +1,347 @@
+/*
+  ==============================================================================
+
+    BenchmarkDenormals.cpp
+    Created: 18 Oct 2026 9:58:41pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkDenormals.h"
+
+namespace
+{
+    String formatValue (const double value, const int decimalPlaces)
+    {
+        return std::isfinite (value) ? String (value, decimalPlaces) : String ("-");
+    }
+
+    double getRatio (const double numerator, const double denominator)
+    {
+        return denominator > 0.0 ? numerator / denominator : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    var toValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+}
+
+double BenchmarkDenormals::SlotResults::getSilenceSlowdown() const
+{
+    return getRatio (denormals.silenceAvg, ftzDaz.silenceAvg);
+}
+double BenchmarkDenormals::SlotResults::getDecaySlowdown() const
+{
+    return getRatio (denormals.decayAvg, ftzDaz.decayAvg);
+}
+bool BenchmarkDenormals::SlotResults::needsDenormalProtection() const
+{
+    // NaN compares false, so a pass which wasn't measured doesn't count
+    return getSilenceSlowdown() >= slowdownThreshold || getDecaySlowdown() >= slowdownThreshold;
+}
+void BenchmarkDenormals::setDecaySeconds (const double seconds)
+{
+    jassert (seconds > 0.0);
+    decaySeconds = jmax (0.01, seconds);
+}
+void BenchmarkDenormals::setSilenceSeconds (const double seconds)
+{
+    jassert (seconds > 0.0);
+    silenceSeconds = jmax (0.01, seconds);
+}
+void BenchmarkDenormals::setRuns (const int numberOfRuns)
+{
+    jassert (numberOfRuns > 0);
+    runs = jmax (1, numberOfRuns);
+}
+void BenchmarkDenormals::setTimingSource (const BenchmarkTimer::Source source)
+{
+    timingSource = source;
+}
+double BenchmarkDenormals::getDecaySeconds() const
+{
+    return decaySeconds;
+}
+double BenchmarkDenormals::getSilenceSeconds() const
+{
+    return silenceSeconds;
+}
+int BenchmarkDenormals::getRuns() const
+{
+    return runs;
+}
+bool BenchmarkDenormals::run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& processSpec, dsp::AudioBlock<float>& block,
+                              const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    jassert (processSpec.sampleRate > 0.0 && processSpec.maximumBlockSize > 0);
+    jassert (block.getNumSamples() >= processSpec.maximumBlockSize && block.getNumChannels() >= processSpec.numChannels);
+
+    spec = processSpec;
+    slotResults.clear();
+    slotResults.resize (harnesses.size());
+    subnormalInputs = 0;
+
+    const auto blockSize = static_cast<int64> (spec.maximumBlockSize);
+    numDecaySamples = jmax (static_cast<int64> (1), static_cast<int64> (decaySeconds * spec.sampleRate));
+    const auto numSilenceSamples = static_cast<int64> (silenceSeconds * spec.sampleRate);
+    numDecayBlocks = static_cast<int> ((numDecaySamples + blockSize - 1) / blockSize);
+    const auto numBlocks = static_cast<int> ((numDecaySamples + numSilenceSamples + blockSize - 1) / blockSize);
+
+    auto processBlock = block.getSubBlock (0, spec.maximumBlockSize).getSubsetChannelBlock (0, spec.numChannels);
+    const dsp::ProcessContextReplacing<float> context (processBlock);
+
+    auto numHarnesses = 0;
+    const ProcessorHarness* firstHarness = nullptr;
+    for (size_t h = 0; h < harnesses.size(); ++h)
+    {
+        if (auto* harness = harnesses[h])
+        {
+            numHarnesses++;
+            if (!firstHarness)
+                firstHarness = harness;
+            slotResults[h].name = harness->getProcessorName();
+            if (!harness->setTimingSource (timingSource))
+                jassertfalse;
+        }
+    }
+
+    auto numerator = 0.0;
+    const auto denominator = static_cast<double> (2 * runs * numHarnesses * numBlocks);
+    const auto reportProgress = [&]
+    {
+        return progressCallback == nullptr || progressCallback (numerator / denominator);
+    };
+
+    // The stimulus is always generated with denormals enabled, so both passes are fed identical (subnormal) samples & only the
+    // process calls are run with FTZ/DAZ (the mode is switched outside of the harness timer)
+    const auto denormalsWereDisabled = FloatVectorOperations::areDenormalsDisabled();
+    FloatVectorOperations::disableDenormalisedNumberSupport (false);
+
+    auto completed = true;
+    for (const auto pass : { 0, 1 })
+    {
+        for (size_t h = 0; h < harnesses.size() && completed; ++h)
+        {
+            auto* harness = harnesses[h];
+            if (!harness)
+                continue;
+
+            auto& results = pass == 0 ? slotResults[h].denormals : slotResults[h].ftzDaz;
+            results.blockTimes.assign (static_cast<size_t> (numBlocks), 0.0);
+            std::vector<int> blockRuns (static_cast<size_t> (numBlocks), 0);
+            harness->resetStatistics();
+
+            for (auto r = 0; r < runs && completed; ++r)
+            {
+                harness->resetHarness();
+                harness->prepareHarness (spec);
+
+                Random random (0x5eed);
+                for (auto b = 0; b < numBlocks; ++b)
+                {
+                    fillStimulus (processBlock, static_cast<int64> (b) * blockSize, random);
+                    if (pass == 0 && r == 0 && harness == firstHarness)
+                        subnormalInputs += ProcessorHarness::countSubnormals (processBlock);
+
+                    const auto steadyCallsBefore = harness->queryProcessingDurationNumSamples();
+                    FloatVectorOperations::disableDenormalisedNumberSupport (pass == 1);
+                    harness->processHarness (context);
+                    FloatVectorOperations::disableDenormalisedNumberSupport (false);
+
+                    // Only the steady state calls are totalled, so the block times cover the same calls as the p99 & max
+                    if (harness->queryProcessingDurationNumSamples() > steadyCallsBefore)
+                    {
+                        results.blockTimes[static_cast<size_t> (b)] += harness->queryProcessingDurationLast();
+                        blockRuns[static_cast<size_t> (b)]++;
+                    }
+                    results.subnormalOutputs += ProcessorHarness::countSubnormals (processBlock);
+
+                    numerator++;
+                    if (!reportProgress())
+                    {
+                        completed = false;
+                        break;
+                    }
+                }
+            }
+
+            // Each block is averaged over the runs in which it wasn't a warm-up call (a block which always was has no time)
+            auto decaySum = 0.0, silenceSum = 0.0;
+            auto numDecay = 0, numSilence = 0;
+            for (auto b = 0; b < numBlocks; ++b)
+            {
+                auto& blockTime = results.blockTimes[static_cast<size_t> (b)];
+                const auto numRuns = blockRuns[static_cast<size_t> (b)];
+                if (numRuns == 0)
+                {
+                    blockTime = std::numeric_limits<double>::quiet_NaN();
+                    continue;
+                }
+                blockTime /= static_cast<double> (numRuns);
+                if (b < numDecayBlocks)
+                {
+                    decaySum += blockTime;
+                    numDecay++;
+                }
+                else
+                {
+                    silenceSum += blockTime;
+                    numSilence++;
+                }
+            }
+            results.decayAvg = numDecay > 0 ? decaySum / numDecay : std::numeric_limits<double>::quiet_NaN();
+            results.silenceAvg = numSilence > 0 ? silenceSum / numSilence : std::numeric_limits<double>::quiet_NaN();
+            results.p99 = harness->queryProcessingDurationPercentile (99.0);
+            results.max = harness->queryProcessingDurationMax();
+        }
+    }
+
+    FloatVectorOperations::disableDenormalisedNumberSupport (denormalsWereDisabled);
+    return completed;
+}
+const std::vector<BenchmarkDenormals::SlotResults>& BenchmarkDenormals::getSlotResults() const
+{
+    return slotResults;
+}
+double BenchmarkDenormals::getSilenceStartSeconds() const
+{
+    return spec.sampleRate > 0.0 ? static_cast<double> (numDecaySamples) / spec.sampleRate : 0.0;
+}
+double BenchmarkDenormals::getBlockSeconds() const
+{
+    return spec.sampleRate > 0.0 ? static_cast<double> (spec.maximumBlockSize) / spec.sampleRate : 0.0;
+}
+String BenchmarkDenormals::getResultsAsText() const
+{
+    String txt;
+    txt << "Spec: " << static_cast<int> (spec.maximumBlockSize) << " samples, " << static_cast<int> (spec.numChannels) << " channels, " << spec.sampleRate << " Hz" << newLine
+        << "Stimulus: " << String (decaySeconds, 2) << " s of noise decaying through the subnormal range to silence, then "
+        << String (silenceSeconds, 2) << " s of silence (" << subnormalInputs << " subnormal input samples), " << runs << " run(s)" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ")" << newLine
+            << "                     Denormals       FTZ/DAZ      Slowdown" << newLine;
+
+        const auto addRow = [&txt] (const String& name, const double denormals, const double ftzDaz, const int decimalPlaces, const bool showRatio)
+        {
+            txt << "  " << name.paddedRight (' ', 18)
+                << formatValue (denormals, decimalPlaces).paddedLeft (' ', 10)
+                << formatValue (ftzDaz, decimalPlaces).paddedLeft (' ', 14)
+                << (showRatio ? formatValue (getRatio (denormals, ftzDaz), 2) : String()).paddedLeft (' ', 14) << newLine;
+        };
+        addRow ("Decay avg (us)", slot.denormals.decayAvg * 1000.0, slot.ftzDaz.decayAvg * 1000.0, 2, true);
+        addRow ("Silence avg (us)", slot.denormals.silenceAvg * 1000.0, slot.ftzDaz.silenceAvg * 1000.0, 2, true);
+        addRow ("p99 (us)", slot.denormals.p99 * 1000.0, slot.ftzDaz.p99 * 1000.0, 2, true);
+        addRow ("Max (us)", slot.denormals.max * 1000.0, slot.ftzDaz.max * 1000.0, 2, true);
+        addRow ("Subnormal outputs", static_cast<double> (slot.denormals.subnormalOutputs), static_cast<double> (slot.ftzDaz.subnormalOutputs), 0, false);
+
+        txt << "  " << (slot.needsDenormalProtection() ? "Needs denormal protection (e.g. ScopedNoDenormals in the process callback)"
+                                                       : String ("No significant denormal slowdown")) << newLine;
+        if (slot.ftzDaz.subnormalOutputs > 0)
+            txt << "  Subnormals are still output with FTZ/DAZ enabled (e.g. input samples which are copied to the output)" << newLine;
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkDenormals::getResultsAsJson() const
+{
+    // A time is NaN if every call it covers was a warm-up call, which JSON can't represent
+    const auto us = [] (const double ms) { return std::isfinite (ms) ? var (ms * 1000.0) : var(); };
+    const auto passToVar = [&us] (const Pass& pass)
+    {
+        auto* obj = new DynamicObject();
+        obj->setProperty ("decay_avg_us", us (pass.decayAvg));
+        obj->setProperty ("silence_avg_us", us (pass.silenceAvg));
+        obj->setProperty ("p99_us", us (pass.p99));
+        obj->setProperty ("max_us", us (pass.max));
+        obj->setProperty ("subnormal_outputs", pass.subnormalOutputs);
+        return var (obj);
+    };
+
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("denormals", passToVar (slot.denormals));
+        procObj->setProperty ("ftz_daz", passToVar (slot.ftzDaz));
+        procObj->setProperty ("decay_slowdown", toValue (slot.getDecaySlowdown()));
+        procObj->setProperty ("silence_slowdown", toValue (slot.getSilenceSlowdown()));
+        procObj->setProperty ("needs_denormal_protection", slot.needsDenormalProtection());
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", static_cast<int> (spec.numChannels));
+
+    auto* stimulusObj = new DynamicObject();
+    stimulusObj->setProperty ("decaySeconds", decaySeconds);
+    stimulusObj->setProperty ("silenceSeconds", silenceSeconds);
+    stimulusObj->setProperty ("runs", runs);
+    stimulusObj->setProperty ("subnormalInputs", subnormalInputs);
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("stimulus", var (stimulusObj));
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkDenormals::getResultsAsCsv() const
+{
+    // One row per block of the stimulus, so the onset of any slowdown can be plotted
+    String csv ("slot,processor,block,time_s,segment,denormals_us,ftz_daz_us\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        const auto numBlocks = jmin (slot.denormals.blockTimes.size(), slot.ftzDaz.blockTimes.size());
+        for (size_t b = 0; b < numBlocks; ++b)
+        {
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+            fields.add (slot.name.quoted());
+            fields.add (String (static_cast<int64> (b)));
+            fields.add (String (static_cast<double> (b) * getBlockSeconds()));
+            fields.add (static_cast<int> (b) < numDecayBlocks ? "decay" : "silence");
+            fields.add (std::isfinite (slot.denormals.blockTimes[b]) ? String (slot.denormals.blockTimes[b] * 1000.0) : String());
+            fields.add (std::isfinite (slot.ftzDaz.blockTimes[b]) ? String (slot.ftzDaz.blockTimes[b] * 1000.0) : String());
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+void BenchmarkDenormals::fillStimulus (dsp::AudioBlock<float>& block, const int64 startSample, Random& random) const
+{
+    // The envelope falls exponentially from full scale to the smallest subnormal float over the decay, so the input passes through
+    // the subnormal range (as a reverb tail from an upstream plugin would) before becoming exactly zero
+    const auto decayRate = -std::log (static_cast<double> (std::numeric_limits<float>::denorm_min())) / static_cast<double> (numDecaySamples);
+
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        const auto n = startSample + static_cast<int64> (i);
+        auto sample = 0.0f;
+        if (n < numDecaySamples)
+            sample = static_cast<float> ((random.nextDouble() * 2.0 - 1.0) * std::exp (-decayRate * static_cast<double> (n)));
+
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            block.setSample (static_cast<int> (ch), static_cast<int> (i), sample);
+    }
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    BenchmarkDenormals.h
+    Created: 18 Oct 2026 9:58:41pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Feeds each processor noise which decays through the subnormal range to silence, followed by a stretch of silence, once with
+ * denormals enabled & once with flush-to-zero / denormals-are-zero enabled (as per ScopedNoDenormals). Filter & reverb state
+ * decaying into the subnormal range can make a processor many times slower once its input goes quiet, so comparing the time per
+ * block of the two passes shows whether it needs denormal protection. The subnormal samples in the outputs are also counted.
+ */
+class BenchmarkDenormals
+{
+public:
+
+    /** Results of one pass over the stimulus (times are in milliseconds, as per ProcessorHarness). */
+    struct Pass
+    {
+        std::vector<double> blockTimes {};  /**< Average time per call for each block of the stimulus (averaged over the runs in which it wasn't a warm-up call, NaN if it always was). */
+        double decayAvg = 0.0;              /**< Average time per call while the input is decaying. */
+        double silenceAvg = 0.0;            /**< Average time per call once the input is silent. */
+        double p99 = 0.0;
+        double max = 0.0;
+        int64 subnormalOutputs = 0;         /**< Number of subnormal output samples over all runs. */
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        Pass denormals {};                  /**< Pass with denormals enabled (the default floating point mode). */
+        Pass ftzDaz {};                     /**< Pass with flush-to-zero & denormals-are-zero enabled. */
+
+        /** Returns the ratio of the time per call without & with FTZ/DAZ once the input is silent. */
+        [[nodiscard]] double getSilenceSlowdown() const;
+
+        /** Returns the ratio of the time per call without & with FTZ/DAZ while the input is decaying. */
+        [[nodiscard]] double getDecaySlowdown() const;
+
+        /** Returns true if either slowdown is large enough to be worth protecting against. */
+        [[nodiscard]] bool needsDenormalProtection() const;
+    };
+
+    /** Slowdown (without vs with FTZ/DAZ) above which a processor is reported as needing denormal protection. */
+    static constexpr double slowdownThreshold = 1.5;
+
+    BenchmarkDenormals() = default;
+    ~BenchmarkDenormals() = default;
+
+    /** Set the length of the decaying part of the stimulus (the envelope reaches the smallest subnormal at the end). */
+    void setDecaySeconds (const double seconds);
+
+    /** Set the length of the silence following the decay. */
+    void setSilenceSeconds (const double seconds);
+
+    /** Set the number of times the stimulus is run through each processor for each pass. */
+    void setRuns (const int numberOfRuns);
+
+    /** Set the clock used to time the process calls. */
+    void setTimingSource (const BenchmarkTimer::Source source);
+
+    [[nodiscard]] double getDecaySeconds() const;
+    [[nodiscard]] double getSilenceSeconds() const;
+    [[nodiscard]] int getRuns() const;
+
+    /** Runs both passes against each non null harness using the given block, which is overwritten with the stimulus (the harness
+     *  statistics are reset for each pass, so they are left holding the FTZ/DAZ pass). The floating point mode of the calling
+     *  thread is restored afterwards. Returns false if the run was aborted by the progress callback.
+     */
+    bool run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& spec, dsp::AudioBlock<float>& block,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    /** Returns the time (in seconds) at which the silence starts (e.g. to mark it on a plot of the block times). */
+    [[nodiscard]] double getSilenceStartSeconds() const;
+
+    /** Returns the duration of each block of the stimulus (in seconds). */
+    [[nodiscard]] double getBlockSeconds() const;
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+private:
+
+    /** Fills the block with the stimulus starting at the given sample position (the same signal is used for every channel). */
+    void fillStimulus (dsp::AudioBlock<float>& block, const int64 startSample, Random& random) const;
+
+    double decaySeconds = 1.0;
+    double silenceSeconds = 4.0;
+    int runs = 1;
+    BenchmarkTimer::Source timingSource = BenchmarkTimer::Source::juceHighResolution;
+
+    dsp::ProcessSpec spec {};
+    int64 numDecaySamples = 0;
+    int numDecayBlocks = 0;
+    int64 subnormalInputs = 0;
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkDenormals)
+};
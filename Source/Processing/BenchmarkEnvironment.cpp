@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    BenchmarkEnvironment.cpp
+    Created: 19 Oct 2026 12:47:52am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkEnvironment.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/utsname.h>
+#endif
+
+namespace
+{
+    /** Returns the trimmed contents of a (sysfs or procfs) file, or an empty string if it can't be read. */
+    String readSystemFile (const String& path)
+    {
+        const File file (path);
+        return file.existsAsFile() ? file.loadFileAsString().trim() : String();
+    }
+
+    String getCompiler()
+    {
+       #if defined (__clang__)
+        return "Clang " __clang_version__;
+       #elif defined (__GNUC__)
+        return "GCC " __VERSION__;
+       #elif defined (_MSC_VER)
+        return "MSVC " + String (_MSC_FULL_VER);
+       #else
+        return "Unknown";
+       #endif
+    }
+
+    /** Returns the flags passed by the build (if known), followed by the relevant predefined macros of this translation unit. */
+    String getBuildFlags()
+    {
+        StringArray flags;
+       #ifdef DSP_TESTBENCH_CXX_FLAGS
+        flags.addTokens (DSP_TESTBENCH_CXX_FLAGS, " ", "\"");
+       #endif
+       #if defined (__OPTIMIZE__)
+        flags.add ("__OPTIMIZE__");
+       #endif
+       #if defined (__FAST_MATH__)
+        flags.add ("__FAST_MATH__");
+       #endif
+       #if defined (NDEBUG)
+        flags.add ("NDEBUG");
+       #endif
+       #if defined (__AVX512F__)
+        flags.add ("__AVX512F__");
+       #endif
+       #if defined (__AVX2__)
+        flags.add ("__AVX2__");
+       #endif
+       #if defined (__AVX__)
+        flags.add ("__AVX__");
+       #endif
+       #if defined (__FMA__)
+        flags.add ("__FMA__");
+       #endif
+       #if defined (__SSE4_2__)
+        flags.add ("__SSE4_2__");
+       #endif
+       #if defined (__ARM_NEON)
+        flags.add ("__ARM_NEON");
+       #endif
+        flags.removeEmptyStrings();
+        flags.removeDuplicates (false);
+        return flags.joinIntoString (" ");
+    }
+
+    String getBuildType()
+    {
+       #if defined (DSP_TESTBENCH_BUILD_TYPE)
+        if (String (DSP_TESTBENCH_BUILD_TYPE).isNotEmpty())
+            return DSP_TESTBENCH_BUILD_TYPE;
+       #endif
+       #if JUCE_DEBUG
+        return "Debug";
+       #else
+        return "Release";
+       #endif
+    }
+
+    StringArray getIsaExtensions()
+    {
+        StringArray extensions;
+        const std::pair<bool, const char*> features[] = {
+            { SystemStats::hasSSE2(), "SSE2" }, { SystemStats::hasSSE3(), "SSE3" }, { SystemStats::hasSSSE3(), "SSSE3" },
+            { SystemStats::hasSSE41(), "SSE4.1" }, { SystemStats::hasSSE42(), "SSE4.2" }, { SystemStats::hasAVX(), "AVX" },
+            { SystemStats::hasAVX2(), "AVX2" }, { SystemStats::hasFMA3(), "FMA3" }, { SystemStats::hasAVX512F(), "AVX-512F" },
+            { SystemStats::hasAVX512BW(), "AVX-512BW" }, { SystemStats::hasAVX512DQ(), "AVX-512DQ" }, { SystemStats::hasAVX512VL(), "AVX-512VL" },
+            { SystemStats::hasNeon(), "NEON" }
+        };
+        for (const auto& feature : features)
+            if (feature.first)
+                extensions.add (feature.second);
+        return extensions;
+    }
+
+    /** Returns the current frequency of each CPU in MHz (NaN for any which aren't known), or an empty list if none are known. */
+    std::vector<double> sampleFrequencies()
+    {
+        std::vector<double> frequencies;
+       #if JUCE_LINUX
+        auto anyKnown = false;
+        for (auto c = 0; c < SystemStats::getNumCpus(); ++c)
+        {
+            const auto kHz = readSystemFile ("/sys/devices/system/cpu/cpu" + String (c) + "/cpufreq/scaling_cur_freq");
+            anyKnown = anyKnown || kHz.isNotEmpty();
+            frequencies.push_back (kHz.isNotEmpty() ? kHz.getDoubleValue() / 1000.0 : std::numeric_limits<double>::quiet_NaN());
+        }
+        if (!anyKnown)
+            frequencies.clear();
+       #endif
+        return frequencies;
+    }
+
+    var toValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+}
+
+void BenchmarkEnvironment::captureStart()
+{
+    startTime = Time::getCurrentTime().toISO8601 (true);
+    cpuModel = SystemStats::getCpuModel();
+    cpuVendor = SystemStats::getCpuVendor();
+    numCpus = SystemStats::getNumCpus();
+    numPhysicalCpus = SystemStats::getNumPhysicalCpus();
+    nominalMHz = SystemStats::getCpuSpeedInMegahertz();
+    isaExtensions = getIsaExtensions();
+    os = SystemStats::getOperatingSystemName();
+    compiler = getCompiler();
+    buildType = getBuildType();
+    buildFlags = getBuildFlags();
+
+   #if JUCE_LINUX || JUCE_MAC
+    utsname names {};
+    if (uname (&names) == 0)
+        kernel = String (names.sysname) + " " + String (names.release);
+   #endif
+
+   #if JUCE_LINUX
+    // The governor is per CPU (policy), so report it as mixed if they differ
+    StringArray governors;
+    for (auto c = 0; c < numCpus; ++c)
+        governors.addIfNotAlreadyThere (readSystemFile ("/sys/devices/system/cpu/cpu" + String (c) + "/cpufreq/scaling_governor"));
+    governors.removeEmptyStrings();
+    governor = governors.size() > 1 ? String ("mixed (" + governors.joinIntoString ("/") + ")") : governors.joinIntoString ({});
+
+    // intel_pstate has a no_turbo switch, while acpi-cpufreq & amd-pstate have a boost switch
+    const auto noTurbo = readSystemFile ("/sys/devices/system/cpu/intel_pstate/no_turbo");
+    const auto boost = readSystemFile ("/sys/devices/system/cpu/cpufreq/boost");
+    if (noTurbo.isNotEmpty())
+        turbo = noTurbo == "1" ? "disabled" : "enabled";
+    else if (boost.isNotEmpty())
+        turbo = boost == "1" ? "enabled" : "disabled";
+
+    const auto smtActive = readSystemFile ("/sys/devices/system/cpu/smt/active");
+    if (smtActive.isNotEmpty())
+        smt = smtActive == "1" ? "enabled" : "disabled";
+
+    const auto loadAverages = readSystemFile ("/proc/loadavg");
+    if (loadAverages.isNotEmpty())
+        loadAverage = loadAverages.upToFirstOccurrenceOf (" ", false, false).getDoubleValue();
+   #endif
+
+    startFrequenciesMHz = sampleFrequencies();
+    endFrequenciesMHz.clear();
+}
+void BenchmarkEnvironment::captureEnd()
+{
+    endFrequenciesMHz = sampleFrequencies();
+}
+StringArray BenchmarkEnvironment::getWarnings() const
+{
+    StringArray warnings;
+    if (buildType.equalsIgnoreCase ("Debug"))
+        warnings.add ("This is a debug build, so the results don't reflect release performance");
+    if (governor.isNotEmpty() && governor != "performance")
+        warnings.add ("The CPU frequency governor is " + governor + " (use performance for stable results)");
+    if (turbo == "enabled")
+        warnings.add ("Turbo is enabled, so the clock depends on the temperature & the number of busy cores");
+    if (loadAverage >= 0.0 && numCpus > 0 && loadAverage / static_cast<double> (numCpus) > loadAverageThreshold)
+        warnings.add ("The load average is " + String (loadAverage, 2) + " on " + String (numCpus) + " CPUs, so other processes may disturb the results");
+
+    const auto startMean = getMeanFrequency (startFrequenciesMHz);
+    const auto endMean = getMeanFrequency (endFrequenciesMHz);
+    if (std::isfinite (startMean) && std::isfinite (endMean) && startMean > 0.0 && std::abs (endMean - startMean) / startMean > frequencyChangeThreshold)
+        warnings.add ("The mean CPU frequency changed from " + String (startMean, 0) + " MHz to " + String (endMean, 0) + " MHz during the run");
+    return warnings;
+}
+String BenchmarkEnvironment::getSummaryText() const
+{
+    const auto orUnknown = [] (const String& value) { return value.isNotEmpty() ? value : String ("unknown"); };
+
+    String txt;
+    txt << "CPU: " << cpuModel << " (" << numCpus << " logical / " << numPhysicalCpus << " physical, " << nominalMHz << " MHz nominal), "
+        << isaExtensions.joinIntoString (" ") << newLine
+        << "Governor " << orUnknown (governor) << ", turbo " << orUnknown (turbo) << ", SMT " << orUnknown (smt);
+    const auto startMean = getMeanFrequency (startFrequenciesMHz);
+    if (std::isfinite (startMean))
+        txt << ", mean frequency " << String (startMean, 0) << " MHz";
+    txt << newLine
+        << "OS: " << os << (kernel.isNotEmpty() ? " (" + kernel + ")" : String()) << newLine
+        << "Build: " << compiler << ", " << buildType << (buildFlags.isNotEmpty() ? ", " + buildFlags : String()) << newLine;
+    for (const auto& warning : getWarnings())
+        txt << "Warning: " << warning << newLine;
+    return txt;
+}
+var BenchmarkEnvironment::getAsJson() const
+{
+    const auto frequenciesToVar = [] (const std::vector<double>& frequencies)
+    {
+        Array<var> values;
+        for (const auto f : frequencies)
+            values.add (toValue (f));
+        return var (values);
+    };
+
+    auto* cpuObj = new DynamicObject();
+    cpuObj->setProperty ("model", cpuModel);
+    cpuObj->setProperty ("vendor", cpuVendor);
+    cpuObj->setProperty ("numCpus", numCpus);
+    cpuObj->setProperty ("numPhysicalCpus", numPhysicalCpus);
+    cpuObj->setProperty ("nominal_mhz", nominalMHz);
+    cpuObj->setProperty ("isa", isaExtensions);
+    cpuObj->setProperty ("governor", governor.isNotEmpty() ? var (governor) : var());
+    cpuObj->setProperty ("turbo", turbo.isNotEmpty() ? var (turbo) : var());
+    cpuObj->setProperty ("smt", smt.isNotEmpty() ? var (smt) : var());
+    cpuObj->setProperty ("start_mhz", frequenciesToVar (startFrequenciesMHz));
+    cpuObj->setProperty ("end_mhz", frequenciesToVar (endFrequenciesMHz));
+
+    auto* buildObj = new DynamicObject();
+    buildObj->setProperty ("compiler", compiler);
+    buildObj->setProperty ("type", buildType);
+    buildObj->setProperty ("flags", buildFlags);
+
+    auto* root = new DynamicObject();
+    root->setProperty ("time", startTime);
+    root->setProperty ("cpu", var (cpuObj));
+    root->setProperty ("os", os);
+    root->setProperty ("kernel", kernel);
+    root->setProperty ("load_average", loadAverage >= 0.0 ? var (loadAverage) : var());
+    root->setProperty ("build", var (buildObj));
+    root->setProperty ("warnings", getWarnings());
+    return var (root);
+}
+var BenchmarkEnvironment::addToResults (const var& results) const
+{
+    if (auto* obj = results.getDynamicObject())
+        obj->setProperty ("environment", getAsJson());
+    return results;
+}
+double BenchmarkEnvironment::getMeanFrequency (const std::vector<double>& frequencies)
+{
+    auto sum = 0.0;
+    auto count = 0;
+    for (const auto f : frequencies)
+    {
+        if (std::isfinite (f))
+        {
+            sum += f;
+            count++;
+        }
+    }
+    return count > 0 ? sum / static_cast<double> (count) : std::numeric_limits<double>::quiet_NaN();
+}
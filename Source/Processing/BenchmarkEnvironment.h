@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    BenchmarkEnvironment.h
+    Created: 19 Oct 2026 12:47:52am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/**
+ * Records what a benchmark ran on (CPU model & ISA extensions, frequency governor, turbo & SMT state, kernel, compiler & build
+ * flags), so that results from different machines can be compared, & warns about an unstable environment (e.g. a powersave
+ * governor, turbo, a busy system or the CPU frequency changing during the run) which makes the results unreliable.
+ *
+ * The governor, turbo, SMT & frequency details are read from sysfs, so they are only known on Linux.
+ */
+class BenchmarkEnvironment
+{
+public:
+
+    /** Relative change in the mean CPU frequency between the start & end of a run above which the run is reported as unstable. */
+    static constexpr double frequencyChangeThreshold = 0.05;
+
+    /** One minute load average (per CPU) above which other processes are likely to disturb the results. */
+    static constexpr double loadAverageThreshold = 0.25;
+
+    BenchmarkEnvironment() = default;
+    ~BenchmarkEnvironment() = default;
+
+    /** Captures the environment & samples the CPU frequencies (call this just before a run). */
+    void captureStart();
+
+    /** Samples the CPU frequencies again so they can be checked against the start of the run (call this just after a run). */
+    void captureEnd();
+
+    /** Returns warnings about anything which makes the results unstable (empty if none were found). */
+    [[nodiscard]] StringArray getWarnings() const;
+
+    /** Returns a few lines describing the environment, followed by any warnings. */
+    [[nodiscard]] String getSummaryText() const;
+
+    [[nodiscard]] var getAsJson() const;
+
+    /** Returns the results with the environment added to them (as an "environment" property, if the results are an object). */
+    [[nodiscard]] var addToResults (const var& results) const;
+
+private:
+
+    /** Returns the mean of the frequencies which are known (NaN if none are). */
+    static double getMeanFrequency (const std::vector<double>& frequencies);
+
+    String cpuModel {};
+    String cpuVendor {};
+    int numCpus = 0;
+    int numPhysicalCpus = 0;
+    int nominalMHz = 0;
+    StringArray isaExtensions {};
+    String governor {};         /**< Frequency governor (e.g. "performance", "mixed" if the CPUs differ, empty if unknown). */
+    String turbo {};            /**< "enabled", "disabled" or empty if unknown. */
+    String smt {};              /**< "enabled", "disabled" or empty if unknown. */
+    String os {};
+    String kernel {};
+    String compiler {};
+    String buildType {};
+    String buildFlags {};
+    double loadAverage = -1.0;  /**< One minute load average (negative if unknown). */
+    std::vector<double> startFrequenciesMHz {};
+    std::vector<double> endFrequenciesMHz {};
+    String startTime {};
+
+    JUCE_LEAK_DETECTOR (BenchmarkEnvironment)
+};
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    BenchmarkIsolation.cpp
+    Created: 19 Oct 2026 12:21:09am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkIsolation.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <pthread.h>
+ #include <sched.h>
+ #include <sys/mman.h>
+ #include <cerrno>
+ #include <cstring>
+
+namespace
+{
+    String describeError (const int error)
+    {
+        String description (std::strerror (error));
+        if (error == EPERM)
+            description << " (needs CAP_SYS_NICE or a large enough rtprio / memlock limit)";
+        else if (error == ENOMEM)
+            description << " (check the memlock limit)";
+        return description;
+    }
+}
+#endif
+
+#if JUCE_WINDOWS
+namespace
+{
+    /** Affinity masks are 32 bit, so this is the highest CPU the thread can be pinned to. */
+    constexpr auto maxPinnableCpus = 32;
+}
+#endif
+
+void BenchmarkIsolation::setCpu (const int cpuIndex)
+{
+    cpu = jmax (-1, cpuIndex);
+}
+void BenchmarkIsolation::setScheduling (const Scheduling policy, const int priority)
+{
+    jassert (priority >= 1 && priority <= 99);
+    scheduling = policy;
+    realtimePriority = jlimit (1, 99, priority);
+}
+void BenchmarkIsolation::setMemoryLocked (const bool shouldLockMemory)
+{
+    lockMemory = shouldLockMemory;
+}
+int BenchmarkIsolation::getCpu() const
+{
+    return cpu;
+}
+BenchmarkIsolation::Scheduling BenchmarkIsolation::getScheduling() const
+{
+    return scheduling;
+}
+int BenchmarkIsolation::getPriority() const
+{
+    return realtimePriority;
+}
+bool BenchmarkIsolation::isMemoryLocked() const
+{
+    return lockMemory;
+}
+bool BenchmarkIsolation::isEnabled() const
+{
+    return cpu >= 0 || scheduling != Scheduling::normal || lockMemory;
+}
+bool BenchmarkIsolation::apply()
+{
+    // If this fires then the previous settings weren't restored
+    jassert (previousCpus.empty() && !schedulingChanged && !memoryLocked);
+
+    StringArray applied, failed;
+    if (cpu >= SystemStats::getNumCpus())
+    {
+        failed.add ("CPU " + String (cpu) + " doesn't exist");
+    }
+    else if (cpu >= 0)
+    {
+       #if JUCE_LINUX
+        cpu_set_t cpus;
+        CPU_ZERO (&cpus);
+        if (pthread_getaffinity_np (pthread_self(), sizeof (cpus), &cpus) == 0)
+            for (auto c = 0; c < CPU_SETSIZE; ++c)
+                if (CPU_ISSET (c, &cpus))
+                    previousCpus.push_back (c);
+
+        CPU_ZERO (&cpus);
+        CPU_SET (cpu, &cpus);
+        const auto error = pthread_setaffinity_np (pthread_self(), sizeof (cpus), &cpus);
+        if (error == 0)
+            applied.add ("pinned to CPU " + String (cpu));
+        else
+            failed.add ("pinning to CPU " + String (cpu) + " failed: " + describeError (error));
+       #elif JUCE_WINDOWS
+        if (cpu < maxPinnableCpus)
+        {
+            for (auto c = 0; c < jmin (SystemStats::getNumCpus(), maxPinnableCpus); ++c)
+                previousCpus.push_back (c);
+            Thread::setCurrentThreadAffinityMask (1u << static_cast<uint32> (cpu));
+            applied.add ("pinned to CPU " + String (cpu));
+        }
+        else
+        {
+            failed.add ("only the first " + String (maxPinnableCpus) + " CPUs can be pinned to");
+        }
+       #else
+        failed.add ("pinning to a CPU isn't supported on this platform");
+       #endif
+    }
+
+    if (scheduling != Scheduling::normal)
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        sched_param param {};
+        if (pthread_getschedparam (pthread_self(), &previousPolicy, &param) == 0)
+            previousPriority = param.sched_priority;
+
+        const auto policy = scheduling == Scheduling::fifo ? SCHED_FIFO : SCHED_RR;
+        param.sched_priority = jlimit (sched_get_priority_min (policy), sched_get_priority_max (policy), realtimePriority);
+        const auto error = pthread_setschedparam (pthread_self(), policy, &param);
+        if (error == 0)
+        {
+            schedulingChanged = true;
+            applied.add (getSchedulingName (scheduling) + " priority " + String (param.sched_priority));
+        }
+        else
+        {
+            failed.add (getSchedulingName (scheduling) + " failed: " + describeError (error));
+        }
+       #else
+        failed.add ("real-time scheduling isn't supported on this platform");
+       #endif
+    }
+
+    if (lockMemory)
+    {
+       #if JUCE_LINUX
+        if (mlockall (MCL_CURRENT | MCL_FUTURE) == 0)
+        {
+            memoryLocked = true;
+            applied.add ("memory locked");
+        }
+        else
+        {
+            failed.add ("locking memory failed: " + describeError (errno));
+        }
+       #else
+        failed.add ("locking memory isn't supported on this platform");
+       #endif
+    }
+
+    status = applied.joinIntoString (", ");
+    if (failed.size() > 0)
+        status << (status.isEmpty() ? "" : ", ") << failed.joinIntoString (", ");
+    if (status.isEmpty())
+        status = "not isolated";
+    return failed.isEmpty();
+}
+void BenchmarkIsolation::restore()
+{
+    if (!previousCpus.empty())
+    {
+       #if JUCE_LINUX
+        cpu_set_t cpus;
+        CPU_ZERO (&cpus);
+        for (const auto c : previousCpus)
+            CPU_SET (c, &cpus);
+        pthread_setaffinity_np (pthread_self(), sizeof (cpus), &cpus);
+       #elif JUCE_WINDOWS
+        uint32 mask = 0;
+        for (const auto c : previousCpus)
+            mask |= 1u << static_cast<uint32> (c);
+        Thread::setCurrentThreadAffinityMask (mask);
+       #endif
+        previousCpus.clear();
+    }
+
+   #if JUCE_LINUX || JUCE_MAC
+    if (schedulingChanged)
+    {
+        sched_param param {};
+        param.sched_priority = previousPriority;
+        pthread_setschedparam (pthread_self(), previousPolicy, &param);
+    }
+   #endif
+    schedulingChanged = false;
+
+   #if JUCE_LINUX
+    if (memoryLocked)
+        munlockall();
+   #endif
+    memoryLocked = false;
+}
+String BenchmarkIsolation::getStatus() const
+{
+    return status;
+}
+String BenchmarkIsolation::getSchedulingName (const Scheduling policy)
+{
+    switch (policy)
+    {
+        case Scheduling::normal: return "Normal";
+        case Scheduling::fifo: return "SCHED_FIFO";
+        case Scheduling::roundRobin: return "SCHED_RR";
+        default: return {};
+    }
+}
+int BenchmarkIsolation::parseScheduling (const String& name)
+{
+    if (name.equalsIgnoreCase ("normal"))
+        return static_cast<int> (Scheduling::normal);
+    if (name.equalsIgnoreCase ("fifo"))
+        return static_cast<int> (Scheduling::fifo);
+    if (name.equalsIgnoreCase ("rr"))
+        return static_cast<int> (Scheduling::roundRobin);
+    return 0;
+}
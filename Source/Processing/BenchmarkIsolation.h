@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    BenchmarkIsolation.h
+    Created: 19 Oct 2026 12:21:09am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/**
+ * Isolates the benchmark thread from the rest of the system by pinning it to one CPU, raising it to a real-time scheduling
+ * policy & locking the process memory, as an audio callback thread would be. Without these, migrations between cores,
+ * preemption by other threads & page faults show up as noise in the maximum & high percentile times.
+ *
+ * Pinning & memory locking are supported on Linux (pinning also on Windows, for the first 32 CPUs), & real-time scheduling on
+ * Linux & macOS. Real-time scheduling needs CAP_SYS_NICE or an rtprio limit on Linux, & memory locking needs a large enough
+ * memlock limit (locking future allocations too can then make them fail once the limit is reached).
+ */
+class BenchmarkIsolation
+{
+public:
+
+    /** Scheduling policy for the benchmark thread (values start at 1 so they can be used as ComboBox IDs). */
+    enum class Scheduling : int
+    {
+        normal = 1,     /**< The thread's scheduling is left as it is. */
+        fifo,           /**< SCHED_FIFO: runs until it blocks or yields, preempting all normal threads. */
+        roundRobin      /**< SCHED_RR: as per SCHED_FIFO, but time sliced with other real-time threads of the same priority. */
+    };
+
+    /** Real-time priority used if none is specified (high, but below the kernel's own threads). */
+    static constexpr int defaultPriority = 80;
+
+    BenchmarkIsolation() = default;
+    ~BenchmarkIsolation() = default;
+
+    /** Set the CPU to pin the benchmark thread to (-1 leaves it free to run on any CPU). */
+    void setCpu (const int cpuIndex);
+
+    /** Set the scheduling policy & real-time priority (1 to 99, limited to the range of the policy). */
+    void setScheduling (const Scheduling policy, const int priority = defaultPriority);
+
+    /** Set whether the process memory (current & future) is locked into RAM, so the benchmark can't page fault. */
+    void setMemoryLocked (const bool shouldLockMemory);
+
+    [[nodiscard]] int getCpu() const;
+    [[nodiscard]] Scheduling getScheduling() const;
+    [[nodiscard]] int getPriority() const;
+    [[nodiscard]] bool isMemoryLocked() const;
+
+    /** Returns true if any of the isolation settings are enabled. */
+    [[nodiscard]] bool isEnabled() const;
+
+    /** Applies the settings to the calling thread (& locks the process memory). Returns false if any of them couldn't be applied,
+     *  in which case the others are still applied & getStatus() describes the failures.
+     */
+    bool apply();
+
+    /** Restores the previous affinity & scheduling of the calling thread & unlocks the memory. This must be called from the
+     *  thread which called apply() (it's not needed if that thread is about to exit, other than to unlock the memory).
+     */
+    void restore();
+
+    /** Returns a description of what the last call to apply() did (e.g. "pinned to CPU 2, SCHED_FIFO priority 80"). */
+    [[nodiscard]] String getStatus() const;
+
+    /** Returns the name of a scheduling policy (e.g. "SCHED_FIFO"). */
+    static String getSchedulingName (const Scheduling policy);
+
+    /** Returns the scheduling policy for a command line name ("normal", "fifo" or "rr"), or 0 if it isn't recognised. */
+    static int parseScheduling (const String& name);
+
+private:
+
+    int cpu = -1;
+    Scheduling scheduling = Scheduling::normal;
+    int realtimePriority = defaultPriority;
+    bool lockMemory = false;
+
+    String status {};
+    std::vector<int> previousCpus {};   /**< CPUs the thread could run on before it was pinned (empty if it wasn't pinned). */
+    bool schedulingChanged = false;
+    int previousPolicy = 0;
+    int previousPriority = 0;
+    bool memoryLocked = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkIsolation)
+};
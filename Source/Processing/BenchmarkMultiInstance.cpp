@@ -0,0 +1,457 @@
+/*
+  ==============================================================================
+
+    BenchmarkMultiInstance.cpp
+    Created: 18 Oct 2026 7:46:10pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkMultiInstance.h"
+
+namespace
+{
+    /** Number of lock-step iterations between progress reports (progress is reported while the instances are running). */
+    constexpr auto iterationsPerChunk = 100;
+
+    /** Throughput increase below which adding instances is considered to have stopped helping. */
+    constexpr auto saturationThreshold = 1.05;
+
+    /** Affinity masks are 32 bit, so this is the highest CPU an instance can be pinned to. */
+    constexpr auto maxPinnableCpus = 32;
+
+    inline void spinPause() noexcept
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #else
+        std::this_thread::yield();
+       #endif
+    }
+
+    /** Waits for an atomic to change from the given value, spinning briefly (so that the waiting threads start together) before yielding. */
+    void waitWhileEqual (const std::atomic<int>& value, const int current) noexcept
+    {
+        for (auto spins = 0; value.load (std::memory_order_acquire) == current; ++spins)
+        {
+            if (spins < 10000)
+                spinPause();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    /** Barrier for the instance threads, so that each lock-step iteration starts together. */
+    class SpinBarrier
+    {
+    public:
+        explicit SpinBarrier (const int participants) : numParticipants (participants) {}
+
+        void arriveAndWait() noexcept
+        {
+            const auto currentGeneration = generation.load (std::memory_order_acquire);
+            if (numArrived.fetch_add (1, std::memory_order_acq_rel) + 1 == numParticipants)
+            {
+                numArrived.store (0, std::memory_order_relaxed);
+                generation.fetch_add (1, std::memory_order_release);
+                return;
+            }
+            waitWhileEqual (generation, currentGeneration);
+        }
+
+    private:
+        const int numParticipants;
+        std::atomic<int> numArrived { 0 };
+        std::atomic<int> generation { 0 };
+    };
+
+    /**
+     * Starts each chunk of iterations on the instance threads, and blocks the coordinating thread until they have all finished it.
+     * The coordinating thread isn't pinned, so it mustn't spin on a CPU which an instance is using (it would slow down the very
+     * contention being measured once there is an instance for every CPU).
+     */
+    class ChunkControl
+    {
+    public:
+        explicit ChunkControl (const int numInstances) : numParticipants (numInstances) {}
+
+        /** Starts a chunk of iterations, optionally resetting the statistics of the instances first (called by the coordinating thread). */
+        void start (const int numIterations, const bool resetStatisticsFirst) noexcept
+        {
+            iterations.store (numIterations, std::memory_order_relaxed);
+            resetStatistics.store (resetStatisticsFirst, std::memory_order_relaxed);
+            numFinished.store (0, std::memory_order_relaxed);
+            generation.fetch_add (1, std::memory_order_release);
+        }
+
+        /** Tells the instances to stop (called by the coordinating thread). */
+        void stop() noexcept
+        {
+            shouldStop.store (true, std::memory_order_relaxed);
+            generation.fetch_add (1, std::memory_order_release);
+        }
+
+        void waitUntilFinished()
+        {
+            finished.wait();
+        }
+
+        /** Waits for the chunk after the given one, returning the new chunk's generation (called by the instances). */
+        int waitForStart (const int previousGeneration) const noexcept
+        {
+            waitWhileEqual (generation, previousGeneration);
+            return generation.load (std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool isStopping() const noexcept             { return shouldStop.load (std::memory_order_relaxed); }
+        [[nodiscard]] int getIterations() const noexcept           { return iterations.load (std::memory_order_relaxed); }
+        [[nodiscard]] bool shouldResetStatistics() const noexcept  { return resetStatistics.load (std::memory_order_relaxed); }
+
+        /** Called by each instance once it has finished the chunk (the last one wakes the coordinating thread). */
+        void finish() noexcept
+        {
+            if (numFinished.fetch_add (1, std::memory_order_acq_rel) + 1 == numParticipants)
+                finished.signal();
+        }
+
+    private:
+        const int numParticipants;
+        std::atomic<int> iterations { 0 };
+        std::atomic<bool> resetStatistics { false };
+        std::atomic<bool> shouldStop { false };
+        std::atomic<int> numFinished { 0 };
+        std::atomic<int> generation { 0 };
+        WaitableEvent finished;
+    };
+
+    /** Runs one processor instance in lock-step with the others. */
+    class InstanceThread : public Thread
+    {
+    public:
+        InstanceThread (ProcessorHarness& harnessToRun, const int cpuIndex, const dsp::ProcessSpec& specToRun, const dsp::AudioBlock<float>& source,
+                        ChunkControl& controlForChunks, SpinBarrier& barrierForIterations)
+            : Thread ("Benchmark instance " + String (cpuIndex)),
+              harness (harnessToRun),
+              cpu (cpuIndex),
+              spec (specToRun),
+              sourceBlock (source),
+              chunkControl (controlForChunks),
+              iterationBarrier (barrierForIterations)
+        { }
+
+        void run() override
+        {
+            if (cpu < maxPinnableCpus)
+                Thread::setCurrentThreadAffinityMask (1u << static_cast<uint32> (cpu));
+
+            // Allocate & fill this instance's buffer on its own thread, so the memory is local to the CPU running it
+            HeapBlock<char> heapBlock;
+            dsp::AudioBlock<float> block (heapBlock, spec.numChannels, spec.maximumBlockSize);
+            block.copyFrom (sourceBlock);
+            const dsp::ProcessContextReplacing<float> context (block);
+
+            // The statistics are reset before prepare, which starts the warm-up (if the prototype has one)
+            harness.resetHarness();
+            harness.resetStatistics();
+            harness.prepareHarness (spec);
+
+            for (auto chunk = 0;;)
+            {
+                chunk = chunkControl.waitForStart (chunk);
+                if (chunkControl.isStopping())
+                    break;
+
+                if (chunkControl.shouldResetStatistics())
+                    harness.resetStatistics();
+                const auto numIterations = chunkControl.getIterations();
+                for (auto i = 0; i < numIterations; ++i)
+                {
+                    iterationBarrier.arriveAndWait();
+                    harness.processHarness (context);
+                }
+                chunkControl.finish();
+            }
+        }
+
+    private:
+        ProcessorHarness& harness;
+        const int cpu;
+        const dsp::ProcessSpec spec;
+        const dsp::AudioBlock<float>& sourceBlock;
+        ChunkControl& chunkControl;
+        SpinBarrier& iterationBarrier;
+
+        JUCE_DECLARE_NON_COPYABLE (InstanceThread)
+    };
+}
+
+BenchmarkMultiInstance::BenchmarkMultiInstance()
+{
+    setMaxInstances (SystemStats::getNumCpus());
+}
+void BenchmarkMultiInstance::setMaxInstances (const int maximum)
+{
+    maxInstances = jlimit (1, jmin (SystemStats::getNumCpus(), maxPinnableCpus), maximum);
+}
+void BenchmarkMultiInstance::setIterations (const int numIterations)
+{
+    jassert (numIterations > 0);
+    iterations = numIterations;
+}
+void BenchmarkMultiInstance::setTimingSource (const BenchmarkTimer::Source source)
+{
+    timingSource = source;
+}
+int BenchmarkMultiInstance::getMaxInstances() const
+{
+    return maxInstances;
+}
+Array<int> BenchmarkMultiInstance::getInstanceCounts() const
+{
+    Array<int> counts;
+    for (auto n = 1; n < maxInstances; n *= 2)
+        counts.add (n);
+    counts.add (maxInstances);
+    return counts;
+}
+bool BenchmarkMultiInstance::run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& spec, const dsp::AudioBlock<float>& sourceBlock,
+                                  const std::function<bool (double)>& progressCallback)
+{
+    slotResults.clear();
+    const auto counts = getInstanceCounts();
+
+    // Create a test instance of each processor up front, so that we know how much work there is to do
+    auto numRuns = 0;
+    for (auto* h : harnesses)
+    {
+        SlotResults slot;
+        if (h)
+        {
+            slot.name = h->getProcessorName();
+            slot.supported = h->createInstance() != nullptr;
+            if (slot.supported)
+                numRuns += counts.size();
+        }
+        slotResults.push_back (slot);
+    }
+
+    auto runIndex = 0;
+    for (size_t s = 0; s < harnesses.size(); ++s)
+    {
+        auto& slot = slotResults[s];
+        if (!slot.supported)
+            continue;
+
+        for (const auto n : counts)
+        {
+            Result result;
+            const auto completed = runInstances (*harnesses[s], n, spec, sourceBlock, result, [&] (const double progress)
+            {
+                return progressCallback == nullptr || progressCallback ((static_cast<double> (runIndex) + progress) / static_cast<double> (numRuns));
+            });
+            if (!completed)
+                return false;
+
+            const auto singleInstanceThroughput = slot.results.empty() ? result.throughput : slot.results.front().throughput;
+            result.efficiency = singleInstanceThroughput > 0.0 ? result.throughput / (static_cast<double> (n) * singleInstanceThroughput) : 0.0;
+            slot.results.push_back (result);
+            runIndex++;
+        }
+    }
+    return true;
+}
+const std::vector<BenchmarkMultiInstance::SlotResults>& BenchmarkMultiInstance::getSlotResults() const
+{
+    return slotResults;
+}
+int BenchmarkMultiInstance::getSaturationCount (const SlotResults& slot)
+{
+    for (size_t i = 1; i < slot.results.size(); ++i)
+        if (slot.results[i].throughput < slot.results[i - 1].throughput * saturationThreshold)
+            return slot.results[i - 1].numInstances;
+    return 0;
+}
+String BenchmarkMultiInstance::getResultsAsText() const
+{
+    String txt;
+    txt << "Lock-step iterations per instance count: " << iterations << ", maximum instances: " << maxInstances
+        << " (" << SystemStats::getNumCpus() << " CPUs)" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ")" << newLine;
+        if (!slot.supported)
+        {
+            txt << "  Skipped - the processor doesn't implement createInstance()" << newLine << newLine;
+            continue;
+        }
+
+        txt << "  Instances  Avg us/call  Worst us/call  Throughput (MS/s)  Efficiency" << newLine;
+        for (const auto& r : slot.results)
+        {
+            const auto sum = std::accumulate (r.instanceMeans.begin(), r.instanceMeans.end(), 0.0);
+            const auto worst = r.instanceMeans.empty() ? 0.0 : *std::max_element (r.instanceMeans.begin(), r.instanceMeans.end());
+            const auto avg = r.instanceMeans.empty() ? 0.0 : sum / static_cast<double> (r.instanceMeans.size());
+            txt << "  " << String (r.numInstances).paddedLeft (' ', 9)
+                << String (avg * 1000.0, 2).paddedLeft (' ', 13)
+                << String (worst * 1000.0, 2).paddedLeft (' ', 15)
+                << String (r.throughput / 1.0E6, 2).paddedLeft (' ', 19)
+                << (String (r.efficiency * 100.0, 1) + "%").paddedLeft (' ', 12) << newLine;
+        }
+
+        const auto saturation = getSaturationCount (slot);
+        if (saturation > 0)
+            txt << "  Throughput stops increasing (by " << roundToInt ((saturationThreshold - 1.0) * 100.0) << "% or more) beyond " << saturation << " instance(s)" << newLine << newLine;
+        else
+            txt << "  Throughput kept increasing up to " << maxInstances << " instance(s)" << newLine << newLine;
+    }
+    return txt;
+}
+var BenchmarkMultiInstance::getResultsAsJson() const
+{
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        Array<var> results;
+        for (const auto& r : slot.results)
+        {
+            Array<var> means;
+            for (const auto m : r.instanceMeans)
+                means.add (m * 1000.0);
+
+            auto* resultObj = new DynamicObject();
+            resultObj->setProperty ("instances", r.numInstances);
+            resultObj->setProperty ("instance_avg_us", means);
+            resultObj->setProperty ("wall_time_ms", r.wallTimeMs);
+            resultObj->setProperty ("throughput_samples_per_second", r.throughput);
+            resultObj->setProperty ("efficiency", r.efficiency);
+            results.add (var (resultObj));
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("supported", slot.supported);
+        procObj->setProperty ("saturation_instances", getSaturationCount (slot));
+        procObj->setProperty ("results", results);
+        processors.add (var (procObj));
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty ("iterations", iterations);
+    root->setProperty ("maxInstances", maxInstances);
+    root->setProperty ("numCpus", SystemStats::getNumCpus());
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkMultiInstance::getResultsAsCsv() const
+{
+    String csv ("slot,processor,instances,instance,avg_us,throughput_samples_per_second,efficiency\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        for (const auto& r : slot.results)
+        {
+            for (size_t i = 0; i < r.instanceMeans.size(); ++i)
+            {
+                StringArray fields;
+                fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+                fields.add (slot.name.quoted());
+                fields.add (String (r.numInstances));
+                fields.add (String (static_cast<int> (i)));
+                fields.add (String (r.instanceMeans[i] * 1000.0));
+                fields.add (String (r.throughput));
+                fields.add (String (r.efficiency));
+                csv << fields.joinIntoString (",") << "\n";
+            }
+        }
+    }
+    return csv;
+}
+bool BenchmarkMultiInstance::runInstances (ProcessorHarness& prototype, const int numInstances, const dsp::ProcessSpec& spec, const dsp::AudioBlock<float>& sourceBlock,
+                                           Result& result, const std::function<bool (double)>& chunkProgress)
+{
+    std::vector<std::unique_ptr<ProcessorHarness>> instances;
+    for (auto i = 0; i < numInstances; ++i)
+    {
+        auto instance = prototype.createInstance();
+        jassert (instance);
+        for (auto c = 0; c < prototype.getNumControls(); ++c)
+            instance->setControlValue (c, prototype.getControlValue (c));
+        if (!instance->setTimingSource (timingSource))
+            jassertfalse;
+        instance->setRealtimeGuardEnabled (prototype.isRealtimeGuardEnabled());
+        instance->setWarmup (prototype.getIterationClassifier().getWarmup());
+        instances.push_back (std::move (instance));
+    }
+
+    ChunkControl chunkControl (numInstances);
+    SpinBarrier iterationBarrier (numInstances);
+
+    std::vector<std::unique_ptr<InstanceThread>> threads;
+    for (auto i = 0; i < numInstances; ++i)
+    {
+        threads.push_back (std::make_unique<InstanceThread> (*instances[static_cast<size_t> (i)], i, spec, sourceBlock, chunkControl, iterationBarrier));
+        threads.back()->startThread();
+    }
+
+    // The instances were last written by their threads before they finished the chunk, so they can be read between chunks
+    const auto isWarmingUp = [&instances]
+    {
+        for (const auto& instance : instances)
+            if (instance->getIterationClassifier().isWarmingUp())
+                return true;
+        return false;
+    };
+
+    // Run the warm-up (if there is one) until every instance has finished it, then reset the statistics so that the instance means
+    // & the wall clock time both cover the same lock-step iterations. Only the chunks themselves are timed, not the progress reports.
+    auto remaining = iterations;
+    auto aborted = false;
+    auto previousWasWarmup = false;
+    int64 wallTicks = 0;
+    while (remaining > 0 && !aborted)
+    {
+        const auto warmingUp = isWarmingUp();
+        const auto numIterations = warmingUp ? iterationsPerChunk : jmin (iterationsPerChunk, remaining);
+        const auto resetStatistics = !warmingUp && previousWasWarmup;
+        previousWasWarmup = warmingUp;
+
+        const auto startTicks = Time::getHighResolutionTicks();
+        chunkControl.start (numIterations, resetStatistics);
+        chunkControl.waitUntilFinished();
+        if (warmingUp)
+            continue;
+
+        wallTicks += Time::getHighResolutionTicks() - startTicks;
+        remaining -= numIterations;
+        if (chunkProgress != nullptr && !chunkProgress (static_cast<double> (iterations - remaining) / static_cast<double> (iterations)))
+            aborted = true;
+    }
+
+    chunkControl.stop();
+    for (auto& t : threads)
+        t->waitForThreadToExit (-1);
+    for (const auto& instance : instances)
+        prototype.mergeRealtimeViolations (*instance);
+
+    if (aborted)
+        return false;
+
+    result.numInstances = numInstances;
+    result.wallTimeMs = Time::highResolutionTicksToSeconds (wallTicks) * 1000.0;
+    for (const auto& instance : instances)
+        result.instanceMeans.push_back (instance->queryProcessingDurationNumSamples() > 0.0 ? instance->queryProcessingDurationAverage() : 0.0);
+    const auto totalSamples = static_cast<double> (numInstances) * static_cast<double> (iterations) * static_cast<double> (spec.maximumBlockSize);
+    result.throughput = result.wallTimeMs > 0.0 ? totalSamples / (result.wallTimeMs / 1000.0) : 0.0;
+    return true;
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    BenchmarkMultiInstance.h
+    Created: 18 Oct 2026 7:46:10pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Runs N independent instances of a processor on N threads (each pinned to its own CPU where the platform allows it), driven
+ * in lock-step as they would be by a host processing many tracks in parallel. This is repeated for N = 1, 2, 4 ... up to the
+ * maximum, to show how throughput scales as the instances contend for shared cache & memory bandwidth.
+ *
+ * The instances are created with ProcessorHarness::createInstance(), so processors which don't override it are skipped.
+ */
+class BenchmarkMultiInstance
+{
+public:
+
+    /** Results for one instance count. */
+    struct Result
+    {
+        int numInstances = 0;
+        std::vector<double> instanceMeans {};   /**< Average time per process call of each instance (milliseconds). */
+        double wallTimeMs = 0.0;                /**< Wall clock time for all of the lock-step iterations (after the warm-up). */
+        double throughput = 0.0;                /**< Aggregate throughput of all instances (samples per second, per channel). */
+        double efficiency = 0.0;                /**< Throughput relative to N times the single instance throughput (1.0 = perfect scaling). */
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        bool supported = false;                 /**< False if the processor doesn't implement createInstance(). */
+        std::vector<Result> results {};
+    };
+
+    BenchmarkMultiInstance();
+    ~BenchmarkMultiInstance() = default;
+
+    /** Set the maximum number of instances (this is limited to the number of CPUs). */
+    void setMaxInstances (const int maximum);
+
+    /** Set the number of lock-step process iterations to run for each instance count. */
+    void setIterations (const int iterations);
+
+    void setTimingSource (const BenchmarkTimer::Source source);
+
+    [[nodiscard]] int getMaxInstances() const;
+
+    /** Returns the instance counts which will be run (1, 2, 4 ... and the maximum). */
+    [[nodiscard]] Array<int> getInstanceCounts() const;
+
+    /** Runs the benchmark for each non null harness (the harnesses themselves aren't run, but their control values are copied to
+     *  the instances). The source block is copied to a separate buffer for each instance. Returns false if aborted.
+     */
+    bool run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& spec, const dsp::AudioBlock<float>& sourceBlock,
+              const std::function<bool (double)>& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    /** Returns the instance count beyond which throughput increases by less than 5%, or 0 if it kept scaling. */
+    [[nodiscard]] static int getSaturationCount (const SlotResults& slot);
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+private:
+
+    /** Runs one instance count for one processor, returning false if aborted. */
+    bool runInstances (ProcessorHarness& prototype, const int numInstances, const dsp::ProcessSpec& spec, const dsp::AudioBlock<float>& sourceBlock,
+                       Result& result, const std::function<bool (double)>& chunkProgress);
+
+    int maxInstances = 1;
+    int iterations = 1000;
+    BenchmarkTimer::Source timingSource = BenchmarkTimer::Source::juceHighResolution;
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkMultiInstance)
+};
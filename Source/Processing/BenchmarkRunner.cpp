@@ -0,0 +1,522 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.cpp
+    Created: 18 Oct 2026 9:12:40am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+
+namespace
+{
+    const StringArray routineNames = { "prepare", "process", "reset" };
+
+    constexpr size_t cacheLineSize = 64;
+
+    /** Approximate number of times progress is reported during a run. */
+    constexpr auto progressReportsPerRun = 200;
+
+    /** Returns the JSON key / CSV column name for a ProcessorHarness::queryByIndex() percentile value (e.g. p99_9_us). */
+    String getPercentileKey (const int valueIndex)
+    {
+        return ProcessorHarness::getQueryValueName (valueIndex).replaceCharacter ('.', '_') + "_us";
+    }
+
+    /** Converts a harness statistic (in milliseconds) to microseconds, returning a void var if the statistic is not yet valid. */
+    var toMicroseconds (const double milliseconds)
+    {
+        if (!std::isfinite (milliseconds) || milliseconds < 0.0 || milliseconds >= 1.0E100)
+            return {};
+        return milliseconds * 1000.0;
+    }
+
+    /** Returns the JSON key / CSV column name for a performance counter (e.g. llc_misses). */
+    String getCounterKey (const PerformanceCounters::Counter counter)
+    {
+        return PerformanceCounters::getCounterName (counter).toLowerCase().replaceCharacter (' ', '_');
+    }
+
+    /** Returns the JSON key / CSV column name for a resource usage counter (e.g. minor_faults). */
+    String getResourceKey (const ResourceUsage::Counter counter)
+    {
+        return ResourceUsage::getCounterName (counter).toLowerCase().replaceCharacter (' ', '_');
+    }
+
+    /** Converts a performance counter metric to a var, returning a void var if the counter wasn't available. */
+    var toCounterValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+}
+
+void BenchmarkRunner::setTestCycles (const int cycles)
+{
+    testCycles = cycles;
+}
+void BenchmarkRunner::setProcessingIterations (const int iterations)
+{
+    processingIterations = iterations;
+}
+void BenchmarkRunner::setProcessSpec (const dsp::ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0 && spec.maximumBlockSize > 0 && spec.sampleRate > 0);
+    testSpec = spec;
+
+    // Initialise audio block, placing each channel at the requested offset from a cache line boundary
+    const auto channelBytes = static_cast<size_t> (testSpec.maximumBlockSize) * sizeof (float);
+    const auto alignedChannelBytes = (channelBytes + cacheLineSize - 1) & ~(cacheLineSize - 1);
+    bufferChannelStride = alignedChannelBytes + static_cast<size_t> (bufferChannelPadding);
+    heapBlock.allocate (cacheLineSize + static_cast<size_t> (bufferByteOffset) + testSpec.numChannels * bufferChannelStride, true);
+
+    const auto address = reinterpret_cast<uintptr_t> (heapBlock.get());
+    auto* base = heapBlock.get() + (((address + cacheLineSize - 1) & ~static_cast<uintptr_t> (cacheLineSize - 1)) - address);
+    channelPointers.resize (testSpec.numChannels);
+    for (size_t ch = 0; ch < channelPointers.size(); ++ch)
+        channelPointers[ch] = reinterpret_cast<float*> (base + static_cast<size_t> (bufferByteOffset) + ch * bufferChannelStride);
+
+    audioBlock = std::make_unique<dsp::AudioBlock<float>> (channelPointers.data(), channelPointers.size(), static_cast<size_t> (testSpec.maximumBlockSize));
+}
+void BenchmarkRunner::setBufferLayout (const int byteOffset, const int channelPadding)
+{
+    jassert (byteOffset >= 0 && byteOffset % static_cast<int> (sizeof (float)) == 0);
+    jassert (channelPadding >= 0 && channelPadding % static_cast<int> (sizeof (float)) == 0);
+    bufferByteOffset = jmax (0, byteOffset) & ~static_cast<int> (sizeof (float) - 1);
+    bufferChannelPadding = jmax (0, channelPadding) & ~static_cast<int> (sizeof (float) - 1);
+}
+void BenchmarkRunner::setTimingSource (const BenchmarkTimer::Source source)
+{
+    timingSource = source;
+}
+void BenchmarkRunner::setPerformanceCountersEnabled (const bool shouldBeEnabled)
+{
+    performanceCountersEnabled = shouldBeEnabled;
+}
+void BenchmarkRunner::setCacheState (const CacheState state)
+{
+    cacheState = state;
+}
+int BenchmarkRunner::getTestCycles() const
+{
+    return testCycles;
+}
+int BenchmarkRunner::getProcessingIterations() const
+{
+    return processingIterations;
+}
+dsp::ProcessSpec BenchmarkRunner::getProcessSpec() const
+{
+    return testSpec;
+}
+BenchmarkTimer::Source BenchmarkRunner::getTimingSource() const
+{
+    return timingSource;
+}
+bool BenchmarkRunner::getPerformanceCountersEnabled() const
+{
+    return performanceCountersEnabled;
+}
+BenchmarkRunner::CacheState BenchmarkRunner::getCacheState() const
+{
+    return cacheState;
+}
+int BenchmarkRunner::getBufferByteOffset() const
+{
+    return bufferByteOffset;
+}
+int BenchmarkRunner::getBufferChannelPadding() const
+{
+    return bufferChannelPadding;
+}
+size_t BenchmarkRunner::getBufferChannelStride() const
+{
+    return bufferChannelStride;
+}
+int BenchmarkRunner::getAudioBlockAlignment() const
+{
+    if (!audioBlock)
+        return 0;
+
+    auto alignment = static_cast<int> (cacheLineSize);
+    for (size_t ch = 0; ch < audioBlock->getNumChannels(); ++ch)
+        alignment = jmin (alignment, getAlignment (audioBlock->getChannelPointer (ch)));
+    return alignment;
+}
+String BenchmarkRunner::getPerformanceCountersError() const
+{
+    return performanceCountersError;
+}
+dsp::AudioBlock<float>& BenchmarkRunner::getAudioBlock()
+{
+    jassert (audioBlock); // You need to call setProcessSpec() first!
+    return *audioBlock;
+}
+bool BenchmarkRunner::run (const std::vector<ProcessorHarness*>& harnesses, const ProgressCallback& progressCallback)
+{
+    jassert (testCycles > 0 && processingIterations > 0);
+    jassert (testSpec.numChannels > 0 && testSpec.maximumBlockSize > 0 && testSpec.sampleRate > 0);
+    jassert (audioBlock);
+
+    const dsp::ProcessContextReplacing<float> context (*audioBlock.get());
+
+    // Only count non null harnesses
+    auto numHarnesses = 0;
+    for (auto* p : harnesses)
+    {
+        if (p)
+        {
+            numHarnesses++;
+            // If this fires then the clock isn't available on this machine, so the harness keeps its current clock
+            if (!p->setTimingSource (timingSource))
+                jassertfalse;
+        }
+    }
+
+    // The counters count the calling thread, so they need to be opened here on the benchmark thread
+    PerformanceCounters counters;
+    performanceCountersError.clear();
+    if (performanceCountersEnabled)
+    {
+        counters.open();
+        performanceCountersError = counters.getLastError();
+    }
+
+    const auto evictCaches = cacheState != CacheState::warm;
+    if (evictCaches)
+    {
+        cacheEvictor.setInstructionCachePollution (cacheState == CacheState::coldWithInstructionCache);
+        cacheEvictor.prepare();
+    }
+
+    auto numerator = 0;
+    const auto denominator = static_cast<double> (numHarnesses * testCycles * (2 + processingIterations));
+
+    // Progress is reported in batches (about 200 times per run) rather than after every call, so the callback (which may update
+    // the GUI or check for cancellation) doesn't disturb the caches & timing of the calls either side of it
+    const auto progressStep = jmax (1, static_cast<int> (denominator / static_cast<double> (progressReportsPerRun)));
+    auto nextReport = 0;
+    const auto reportProgress = [&]
+    {
+        if (numerator < nextReport)
+            return true;
+        nextReport = numerator + progressStep;
+        return progressCallback == nullptr || progressCallback (static_cast<double> (numerator) / denominator);
+    };
+
+    if (!reportProgress()) return false;
+    for (auto c = 0; c < testCycles; ++c)
+    {
+        for (auto* p : harnesses)
+        {
+            if (p)
+            {
+                p->resetHarness();
+                numerator++;
+                if (!reportProgress()) return false;
+
+                p->prepareHarness (testSpec);
+                numerator++;
+                if (!reportProgress()) return false;
+
+                if (evictCaches)
+                {
+                    // The counters have to be read for each call here, otherwise they would include the eviction
+                    for (auto i = 0; i < processingIterations; ++i)
+                    {
+                        cacheEvictor.evict();
+                        if (counters.isOpen())
+                            p->processHarnessWithCounters (context, 1, counters);
+                        else
+                            p->processHarness (context);
+                        numerator++;
+                        if (!reportProgress()) return false;
+                    }
+                }
+                else if (counters.isOpen())
+                {
+                    p->processHarnessWithCounters (context, processingIterations, counters);
+                    numerator += processingIterations;
+                    if (!reportProgress()) return false;
+                }
+                else
+                {
+                    for (auto i = 0; i < processingIterations; ++i)
+                    {
+                        p->processHarness (context);
+                        numerator++;
+                        if (!reportProgress()) return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+int BenchmarkRunner::getAlignment (const float* data)
+{
+    const auto address = reinterpret_cast<uintptr_t> (data);
+    auto alignment = 1;
+    while (alignment < static_cast<int> (cacheLineSize) && (address & static_cast<uintptr_t> (alignment * 2 - 1)) == 0)
+        alignment *= 2;
+    return alignment;
+}
+String BenchmarkRunner::getAudioBlockAlignmentStatus() const
+{
+    if (!audioBlock)
+        return {};
+
+    // Name the widest SIMD loads which are aligned for every channel
+    const auto alignment = getAudioBlockAlignment();
+    String status;
+    status << "AudioBlock is " << alignment << " byte aligned";
+    if (alignment >= 64)
+        status << " (cache line)";
+    else if (alignment >= 32)
+        status << " (AVX)";
+    else if (alignment >= 16)
+        status << " (SSE/NEON)";
+    else
+        status << " (not SIMD aligned)";
+    return status;
+}
+var BenchmarkRunner::getResultsAsJson (const std::vector<ProcessorHarness*>& harnesses) const
+{
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", testSpec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (testSpec.maximumBlockSize));
+    specObj->setProperty ("numChannels", static_cast<int> (testSpec.numChannels));
+
+    Array<var> processors;
+    for (auto h = 0; h < static_cast<int> (harnesses.size()); ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", getSlotName (h));
+        procObj->setProperty ("name", harness->getProcessorName());
+
+        auto* timerObj = new DynamicObject();
+        timerObj->setProperty ("source", BenchmarkTimer::getSourceName (harness->getTimer().getSource()));
+        timerObj->setProperty ("overhead_ns", harness->getTimer().getOverheadMs() * 1.0E6);
+        procObj->setProperty ("timer", var (timerObj));
+
+        const auto budget = RealtimeBudget::forProcessing (*harness);
+        if (budget.isValid())
+        {
+            auto* budgetObj = new DynamicObject();
+            budgetObj->setProperty ("budget_us", budget.budgetMs * 1000.0);
+            budgetObj->setProperty ("used_avg", budget.meanFraction);
+            budgetObj->setProperty ("used_p99", budget.p99Fraction);
+            budgetObj->setProperty ("used_p99_9", budget.p99_9Fraction);
+            budgetObj->setProperty ("used_max", budget.maxFraction);
+            budgetObj->setProperty ("deadline_misses", static_cast<int64> (budget.deadlineMisses));
+            budgetObj->setProperty ("max_instances_avg", budget.maxInstancesAtMean);
+            budgetObj->setProperty ("max_instances_p99", budget.maxInstancesAtP99);
+            procObj->setProperty ("realtime", var (budgetObj));
+        }
+
+        const auto& totals = harness->getPerformanceCounterTotals();
+        if (totals.numSamples > 0.0)
+        {
+            auto* countersObj = new DynamicObject();
+            countersObj->setProperty ("samples", totals.numSamples);
+            countersObj->setProperty ("ipc", toCounterValue (totals.getInstructionsPerCycle()));
+            for (auto c = 0; c < PerformanceCounters::numCounters; ++c)
+            {
+                const auto counter = static_cast<PerformanceCounters::Counter> (c);
+                const auto key = getCounterKey (counter);
+                countersObj->setProperty (Identifier (key), totals.available[static_cast<size_t> (c)] ? var (totals.counts[static_cast<size_t> (c)]) : var());
+                countersObj->setProperty (Identifier (key + "_per_sample"), toCounterValue (totals.getPerSample (counter)));
+            }
+            procObj->setProperty ("counters", var (countersObj));
+        }
+
+        for (auto r = 0; r < routineNames.size(); ++r)
+        {
+            // Statistics are gathered in milliseconds, but we report microseconds
+            auto* routineObj = new DynamicObject();
+            routineObj->setProperty ("min_us", toMicroseconds (harness->queryByIndex (r, 0)));
+            routineObj->setProperty ("avg_us", toMicroseconds (harness->queryByIndex (r, 1)));
+            routineObj->setProperty ("max_us", toMicroseconds (harness->queryByIndex (r, 2)));
+            routineObj->setProperty ("count", static_cast<int64> (harness->queryByIndex (r, 3)));
+            for (auto v = 4; v < ProcessorHarness::numQueryValues; ++v)
+                routineObj->setProperty (Identifier (getPercentileKey (v)), toMicroseconds (harness->queryByIndex (r, v)));
+            if (const auto* violations = harness->getRealtimeViolations (r))
+            {
+                auto* violationsObj = new DynamicObject();
+                for (auto k = 0; k < static_cast<int> (RealtimeGuard::Kind::numKinds); ++k)
+                {
+                    const auto kind = static_cast<RealtimeGuard::Kind> (k);
+                    violationsObj->setProperty (Identifier (RealtimeGuard::getKindName (kind)), violations->getCount (kind));
+                }
+                violationsObj->setProperty ("stack_traces", violations->getStackTraceDescriptions());
+                routineObj->setProperty ("realtime_violations", var (violationsObj));
+            }
+            if (routineNames[r] == "process")
+            {
+                // The warm-up calls are left out of the statistics above, so they are reported on their own
+                const auto& classifier = harness->getIterationClassifier();
+                const auto& warmup = classifier.getWarmupStatistics();
+                if (warmup.numCalls > 0.0)
+                {
+                    auto* warmupObj = new DynamicObject();
+                    warmupObj->setProperty ("calls_per_cycle", warmup.getCallsPerCycle());
+                    warmupObj->setProperty ("auto", classifier.getWarmup() == IterationClassifier::autoWarmup);
+                    warmupObj->setProperty ("avg_us", toMicroseconds (warmup.getAverage()));
+                    warmupObj->setProperty ("max_us", toMicroseconds (warmup.durationMax));
+                    warmupObj->setProperty ("first_call_avg_us", toMicroseconds (warmup.getFirstCallAverage()));
+                    warmupObj->setProperty ("first_call_max_us", toMicroseconds (warmup.firstCallMax));
+                    routineObj->setProperty ("warmup", var (warmupObj));
+                }
+
+                const auto median = harness->queryProcessingDurationPercentile (50.0);
+                Array<var> outlierCalls;
+                for (auto i = 0; i < classifier.getNumOutliers (median); ++i)
+                {
+                    const auto outlier = classifier.getOutlier (i, median);
+                    auto* callObj = new DynamicObject();
+                    callObj->setProperty ("cycle", outlier.cycle);
+                    callObj->setProperty ("call", outlier.call);
+                    callObj->setProperty ("us", outlier.durationMs * 1000.0);
+                    outlierCalls.add (var (callObj));
+                }
+                auto* outliersObj = new DynamicObject();
+                outliersObj->setProperty ("factor", classifier.getOutlierFactor());
+                outliersObj->setProperty ("count", outlierCalls.size());
+                outliersObj->setProperty ("not_recorded", classifier.getNumOutliersNotRecorded());
+                outliersObj->setProperty ("period_calls", classifier.getOutlierPeriod (median));
+                outliersObj->setProperty ("calls", outlierCalls);
+                routineObj->setProperty ("outliers", var (outliersObj));
+
+                if (const auto* profiler = harness->getSectionProfiler())
+                    routineObj->setProperty ("sections", profiler->getAsJson (harness->queryProcessingDurationAverage()));
+            }
+            if (const auto* usage = harness->getResourceUsage (r))
+            {
+                auto* usageObj = new DynamicObject();
+                for (auto c = 0; c < ResourceUsage::numCounters; ++c)
+                    usageObj->setProperty (Identifier (getResourceKey (static_cast<ResourceUsage::Counter> (c))), usage->counts[static_cast<size_t> (c)]);
+                usageObj->setProperty ("calls_with_faults", usage->callsWithFaults);
+                usageObj->setProperty ("first_faulting_call", usage->firstFaultingCall >= 0 ? var (usage->firstFaultingCall) : var());
+                usageObj->setProperty ("peak_rss_growth_kb", usage->peakRssGrowthKb);
+                routineObj->setProperty ("resources", var (usageObj));
+            }
+            procObj->setProperty (Identifier (routineNames[r]), var (routineObj));
+        }
+        processors.add (var (procObj));
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("testCycles", testCycles);
+    root->setProperty ("processingIterations", processingIterations);
+    root->setProperty ("cache", getCacheStateName (cacheState));
+
+    auto* bufferObj = new DynamicObject();
+    bufferObj->setProperty ("byteOffset", bufferByteOffset);
+    bufferObj->setProperty ("channelPadding", bufferChannelPadding);
+    bufferObj->setProperty ("channelStride", static_cast<int64> (bufferChannelStride));
+    bufferObj->setProperty ("alignment", getAudioBlockAlignment());
+    root->setProperty ("buffer", var (bufferObj));
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkRunner::getResultsAsCsv (const std::vector<ProcessorHarness*>& harnesses) const
+{
+    String csv ("slot,processor,sample_rate,block_size,channels,routine,min_us,avg_us,max_us,count");
+    for (auto v = 4; v < ProcessorHarness::numQueryValues; ++v)
+        csv << "," << getPercentileKey (v);
+    csv << ",budget_us,budget_used_avg,budget_used_p99,budget_used_p99_9,budget_used_max,deadline_misses,max_instances_avg,max_instances_p99";
+    csv << ",ipc";
+    for (auto c = 0; c < PerformanceCounters::numCounters; ++c)
+        csv << "," << getCounterKey (static_cast<PerformanceCounters::Counter> (c)) << "_per_sample";
+    for (auto k = 0; k < static_cast<int> (RealtimeGuard::Kind::numKinds); ++k)
+        csv << "," << RealtimeGuard::getKindName (static_cast<RealtimeGuard::Kind> (k));
+    for (auto c = 0; c < ResourceUsage::numCounters; ++c)
+        csv << "," << getResourceKey (static_cast<ResourceUsage::Counter> (c));
+    csv << ",calls_with_faults,peak_rss_growth_kb";
+    csv << ",warmup_calls_per_cycle,warmup_avg_us,first_call_avg_us,outliers";
+    csv << "\n";
+
+    for (auto h = 0; h < static_cast<int> (harnesses.size()); ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        for (auto r = 0; r < routineNames.size(); ++r)
+        {
+            StringArray fields;
+            fields.add (getSlotName (h));
+            fields.add (harness->getProcessorName().quoted());
+            fields.add (String (testSpec.sampleRate));
+            fields.add (String (testSpec.maximumBlockSize));
+            fields.add (String (testSpec.numChannels));
+            fields.add (routineNames[r]);
+            fields.add (toMicroseconds (harness->queryByIndex (r, 0)).toString());
+            fields.add (toMicroseconds (harness->queryByIndex (r, 1)).toString());
+            fields.add (toMicroseconds (harness->queryByIndex (r, 2)).toString());
+            fields.add (String (static_cast<int64> (harness->queryByIndex (r, 3))));
+            for (auto v = 4; v < ProcessorHarness::numQueryValues; ++v)
+                fields.add (toMicroseconds (harness->queryByIndex (r, v)).toString());
+
+            // The real-time budget & performance counters only apply to the process routine
+            const auto budget = RealtimeBudget::forProcessing (*harness);
+            const auto hasBudget = routineNames[r] == "process" && budget.isValid();
+            for (const auto value : { budget.budgetMs * 1000.0, budget.meanFraction, budget.p99Fraction, budget.p99_9Fraction, budget.maxFraction })
+                fields.add (hasBudget ? String (value) : String());
+            fields.add (hasBudget ? String (static_cast<int64> (budget.deadlineMisses)) : String());
+            fields.add (hasBudget ? String (budget.maxInstancesAtMean) : String());
+            fields.add (hasBudget ? String (budget.maxInstancesAtP99) : String());
+
+            const auto& totals = harness->getPerformanceCounterTotals();
+            const auto hasCounters = routineNames[r] == "process" && totals.numSamples > 0.0;
+            fields.add (hasCounters ? toCounterValue (totals.getInstructionsPerCycle()).toString() : String());
+            for (auto c = 0; c < PerformanceCounters::numCounters; ++c)
+                fields.add (hasCounters ? toCounterValue (totals.getPerSample (static_cast<PerformanceCounters::Counter> (c))).toString() : String());
+
+            // Real-time violations are only counted for the guarded routines, and only when the guard is enabled
+            const auto* violations = harness->getRealtimeViolations (r);
+            for (auto k = 0; k < static_cast<int> (RealtimeGuard::Kind::numKinds); ++k)
+                fields.add (violations != nullptr ? String (violations->getCount (static_cast<RealtimeGuard::Kind> (k))) : String());
+
+            // Resource usage is only sampled when it is enabled
+            const auto* usage = harness->getResourceUsage (r);
+            for (auto c = 0; c < ResourceUsage::numCounters; ++c)
+                fields.add (usage != nullptr ? String (usage->counts[static_cast<size_t> (c)]) : String());
+            fields.add (usage != nullptr ? String (usage->callsWithFaults) : String());
+            fields.add (usage != nullptr ? String (usage->peakRssGrowthKb) : String());
+
+            // The warm-up & outliers only apply to the process routine
+            const auto isProcess = routineNames[r] == "process";
+            const auto& classifier = harness->getIterationClassifier();
+            const auto& warmup = classifier.getWarmupStatistics();
+            fields.add (isProcess ? String (warmup.getCallsPerCycle()) : String());
+            fields.add (isProcess ? toMicroseconds (warmup.getAverage()).toString() : String());
+            fields.add (isProcess ? toMicroseconds (warmup.getFirstCallAverage()).toString() : String());
+            fields.add (isProcess ? String (classifier.getNumOutliers (harness->queryProcessingDurationPercentile (50.0))) : String());
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+String BenchmarkRunner::getSlotName (const int harnessIndex)
+{
+    return String::charToString (static_cast<juce_wchar> ('A' + harnessIndex));
+}
+String BenchmarkRunner::getCacheStateName (const CacheState state)
+{
+    switch (state)
+    {
+        case CacheState::warm: return "warm";
+        case CacheState::cold: return "cold";
+        case CacheState::coldWithInstructionCache: return "cold-code";
+        default: return {};
+    }
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 18 Oct 2026 9:12:40am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ProcessorHarness.h"
+#include "RealtimeBudget.h"
+#include "CacheEvictor.h"
+
+/**
+ * Runs the reset, prepare & process benchmark cycles against one or more ProcessorHarness objects.
+ * This has no dependency on the GUI or an audio device so that it can be shared by the BenchmarkComponent
+ * and the headless benchmark runner.
+ */
+class BenchmarkRunner
+{
+public:
+
+    /** Called periodically with the progress (0..1) of a run. Return false to abort the run. */
+    using ProgressCallback = std::function<bool (double)>;
+
+    /** State of the CPU caches at the start of each process call (values start at 1 so they can be used as ComboBox IDs). */
+    enum class CacheState : int
+    {
+        warm = 1,                       /**< The same block & processor state are reused every iteration, so they stay cached. */
+        cold,                           /**< The data caches are evicted before every process call. */
+        coldWithInstructionCache        /**< The data caches are evicted & the instruction cache is polluted before every process call. */
+    };
+
+    BenchmarkRunner() = default;
+    ~BenchmarkRunner() = default;
+
+    /** Set number of full test cycles to run (reset, prepare, processing). */
+    void setTestCycles (const int cycles);
+
+    /** Set number of times to iterate the processing within each cycle. */
+    void setProcessingIterations (const int iterations);
+
+    /** Set ProcessSpec to test against (this reallocates the audio block). */
+    void setProcessSpec (const dsp::ProcessSpec& spec);
+
+    /** Set the layout of the channel buffers, which is applied when the audio block is next allocated by setProcessSpec().
+     *  Each channel starts byteOffset bytes after a cache line boundary, and consecutive channels are channelPadding bytes
+     *  further apart than the channel length (rounded up to a whole cache line). Both must be multiples of sizeof (float).
+     */
+    void setBufferLayout (const int byteOffset, const int channelPadding);
+
+    /** Set the clock used to time the harness routines (this is applied to each harness at the start of a run). */
+    void setTimingSource (const BenchmarkTimer::Source source);
+
+    /** Enables hardware performance counters around the processing iterations (Linux only). When enabled, progress is only
+     *  reported once per batch of processing iterations so that the counters aren't polluted by the progress callback.
+     */
+    void setPerformanceCountersEnabled (const bool shouldBeEnabled);
+
+    /** Set the cache state to benchmark the process routine in. In the cold states, the caches are evicted before every process
+     *  call (outside of the timed region), which makes the run much slower. Performance counters are then read for each call.
+     */
+    void setCacheState (const CacheState state);
+
+    [[nodiscard]] int getTestCycles() const;
+    [[nodiscard]] int getProcessingIterations() const;
+    [[nodiscard]] dsp::ProcessSpec getProcessSpec() const;
+    [[nodiscard]] BenchmarkTimer::Source getTimingSource() const;
+    [[nodiscard]] bool getPerformanceCountersEnabled() const;
+    [[nodiscard]] CacheState getCacheState() const;
+    [[nodiscard]] int getBufferByteOffset() const;
+    [[nodiscard]] int getBufferChannelPadding() const;
+
+    /** Returns the distance between the start of consecutive channels of the audio block (in bytes). */
+    [[nodiscard]] size_t getBufferChannelStride() const;
+
+    /** Returns the smallest alignment of the audio block's channels (in bytes, up to the cache line size). */
+    [[nodiscard]] int getAudioBlockAlignment() const;
+
+    /** Returns the reason the performance counters couldn't be opened during the last run (empty if they were opened). */
+    [[nodiscard]] String getPerformanceCountersError() const;
+
+    /** Returns the audio block which is fed to the processors (fill this with your test signal after calling setProcessSpec). */
+    [[nodiscard]] dsp::AudioBlock<float>& getAudioBlock();
+
+    /** Runs the benchmark against each non null harness. Progress is reported in batches of calls rather than after every call.
+     *  Returns false if the run was aborted by the progress callback.
+     */
+    bool run (const std::vector<ProcessorHarness*>& harnesses, const ProgressCallback& progressCallback = nullptr);
+
+    /** Returns a string describing the alignment of the audio block's channels. */
+    [[nodiscard]] String getAudioBlockAlignmentStatus() const;
+
+    /** Returns the statistics gathered by the harnesses as a JSON object (times are in microseconds). */
+    [[nodiscard]] var getResultsAsJson (const std::vector<ProcessorHarness*>& harnesses) const;
+
+    /** Returns the statistics gathered by the harnesses as CSV text with a header row (times are in microseconds). */
+    [[nodiscard]] String getResultsAsCsv (const std::vector<ProcessorHarness*>& harnesses) const;
+
+    /** Returns the slot name used for a harness in the results (i.e. "A", "B", ...). */
+    static String getSlotName (const int harnessIndex);
+
+    /** Returns a short name for a cache state (e.g. for the results). */
+    static String getCacheStateName (const CacheState state);
+
+private:
+
+    /** Returns the alignment of the specified pointer (in bytes, up to the cache line size). */
+    static int getAlignment (const float* data);
+
+    int testCycles = 0;
+    int processingIterations = 0;
+    dsp::ProcessSpec testSpec {};
+    BenchmarkTimer::Source timingSource = BenchmarkTimer::Source::juceHighResolution;
+    bool performanceCountersEnabled = false;
+    String performanceCountersError {};
+    CacheState cacheState = CacheState::warm;
+    CacheEvictor cacheEvictor;
+    int bufferByteOffset = 0;
+    int bufferChannelPadding = 0;
+    size_t bufferChannelStride = 0;
+    HeapBlock<char> heapBlock{};
+    std::vector<float*> channelPointers {};
+    std::unique_ptr<dsp::AudioBlock<float>> audioBlock{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkRunner)
+};
@@ -0,0 +1,486 @@
+/*
+  ==============================================================================
+
+    BenchmarkStimuli.cpp
+    Created: 18 Oct 2026 11:58:30pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkStimuli.h"
+#include "NoiseGenerators.h"
+
+namespace
+{
+    String formatValue (const double value, const int decimalPlaces)
+    {
+        return std::isfinite (value) ? String (value, decimalPlaces) : String ("-");
+    }
+
+    var toValue (const double value)
+    {
+        if (!std::isfinite (value))
+            return {};
+        return value;
+    }
+
+    int64 countNonFinite (const dsp::AudioBlock<float>& block)
+    {
+        int64 count = 0;
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+        {
+            const auto* samples = block.getChannelPointer (ch);
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+                if (!std::isfinite (samples[i]))
+                    count++;
+        }
+        return count;
+    }
+
+    /** Generates a stimulus block by block, continuing from where the previous block left off. */
+    class StimulusGenerator
+    {
+    public:
+
+        StimulusGenerator (const BenchmarkStimuli::Stimulus stimulusToGenerate, const double sampleRateToUse)
+            : stimulus (stimulusToGenerate),
+              sampleRate (sampleRateToUse)
+        {
+            whiteNoise.reset();
+        }
+
+        void fill (dsp::AudioBlock<float>& block)
+        {
+            using Stimulus = BenchmarkStimuli::Stimulus;
+            const dsp::ProcessContextReplacing<float> context (block);
+            const auto numSamples = static_cast<int> (block.getNumSamples());
+
+            switch (stimulus)
+            {
+                case Stimulus::silence:
+                    block.clear();
+                    break;
+                case Stimulus::whiteNoise:
+                    whiteNoise.process (context);
+                    break;
+                case Stimulus::pinkNoise:
+                    pinkNoise.process (context);
+                    break;
+                case Stimulus::denormalNoise:
+                    // Every sample is below the smallest normal float (the caller keeps denormals enabled while generating)
+                    whiteNoise.process (context);
+                    block.multiplyBy (std::numeric_limits<float>::min());
+                    break;
+                case Stimulus::nanInf:
+                {
+                    // Roughly one sample in 4096 is replaced, cycling through NaN, +infinity & -infinity
+                    const float specialValues[] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+                    whiteNoise.process (context);
+                    block.multiplyBy (0.5f);
+                    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+                    {
+                        for (auto i = 0; i < numSamples; ++i)
+                        {
+                            if (random.nextInt (4096) == 0)
+                            {
+                                block.setSample (static_cast<int> (ch), i, specialValues[numSpecialValues % 3]);
+                                numSpecialValues++;
+                            }
+                        }
+                    }
+                    break;
+                }
+                case Stimulus::sine:
+                case Stimulus::impulses:
+                case Stimulus::changing:
+                default:
+                {
+                    // The same signal on every channel
+                    for (auto i = 0; i < numSamples; ++i)
+                    {
+                        const auto sample = static_cast<float> (getSample (position + i));
+                        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+                            block.setSample (static_cast<int> (ch), i, sample);
+                    }
+                    break;
+                }
+            }
+            position += numSamples;
+        }
+
+    private:
+
+        /** Returns the sample at the given position (the changing signal's phase is accumulated, so call this in order). */
+        double getSample (const int64 sampleIndex)
+        {
+            using Stimulus = BenchmarkStimuli::Stimulus;
+            const auto n = static_cast<double> (sampleIndex);
+            if (stimulus == Stimulus::sine)
+                return std::sin (MathConstants<double>::twoPi * std::fmod (1000.0 * n / sampleRate, 1.0));
+
+            if (stimulus == Stimulus::impulses)
+                return sampleIndex % jmax (static_cast<int64> (1), static_cast<int64> (sampleRate / 10.0)) == 0 ? 1.0 : 0.0;
+
+            // Exponential glide from 50 Hz to 5 kHz & back over 10 s, with the level varying between -40 & 0 dB over 3 s
+            const auto glide = std::fmod (n / (10.0 * sampleRate), 1.0);
+            const auto frequency = 50.0 * std::pow (100.0, glide < 0.5 ? 2.0 * glide : 2.0 - 2.0 * glide);
+            const auto levelDb = -20.0 + 20.0 * std::cos (MathConstants<double>::twoPi * n / (3.0 * sampleRate));
+            phase = std::fmod (phase + frequency / sampleRate, 1.0);
+            return Decibels::decibelsToGain (levelDb) * std::sin (MathConstants<double>::twoPi * phase);
+        }
+
+        BenchmarkStimuli::Stimulus stimulus;
+        double sampleRate;
+        dsp::WhiteNoiseGenerator whiteNoise;
+        dsp::PinkNoiseGenerator pinkNoise;
+        Random random { 0x57e1 };
+        int64 position = 0;
+        int64 numSpecialValues = 0;
+        double phase = 0.0;
+    };
+}
+
+double BenchmarkStimuli::StimulusResults::getNsPerSample (const int numChannels) const
+{
+    if (samples <= 0 || numChannels <= 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return totalMs * 1.0E6 / (static_cast<double> (samples) * static_cast<double> (numChannels));
+}
+double BenchmarkStimuli::SlotResults::getRelativeCost (const StimulusResults& results) const
+{
+    for (const auto& s : stimuli)
+        if (s.stimulus == Stimulus::changing && s.totalMs > 0.0 && results.samples > 0)
+            return results.getNsPerSample (1) / s.getNsPerSample (1);
+    return std::numeric_limits<double>::quiet_NaN();
+}
+const BenchmarkStimuli::StimulusResults* BenchmarkStimuli::SlotResults::getFastest() const
+{
+    const StimulusResults* fastest = nullptr;
+    for (const auto& s : stimuli)
+        if (s.samples > 0 && (fastest == nullptr || s.getNsPerSample (1) < fastest->getNsPerSample (1)))
+            fastest = &s;
+    return fastest;
+}
+const BenchmarkStimuli::StimulusResults* BenchmarkStimuli::SlotResults::getSlowest() const
+{
+    const StimulusResults* slowest = nullptr;
+    for (const auto& s : stimuli)
+        if (s.samples > 0 && (slowest == nullptr || s.getNsPerSample (1) > slowest->getNsPerSample (1)))
+            slowest = &s;
+    return slowest;
+}
+BenchmarkStimuli::BenchmarkStimuli()
+    : stimuli (getAllStimuli())
+{
+}
+void BenchmarkStimuli::setStimuli (const std::vector<Stimulus>& stimuliToRun)
+{
+    jassert (!stimuliToRun.empty());
+    stimuli = stimuliToRun;
+}
+void BenchmarkStimuli::setHostBuffers (const int numberOfHostBuffers)
+{
+    jassert (numberOfHostBuffers > 0);
+    hostBuffers = jmax (1, numberOfHostBuffers);
+}
+void BenchmarkStimuli::setRuns (const int numberOfRuns)
+{
+    jassert (numberOfRuns > 0);
+    runs = jmax (1, numberOfRuns);
+}
+void BenchmarkStimuli::setTimingSource (const BenchmarkTimer::Source source)
+{
+    timingSource = source;
+}
+const std::vector<BenchmarkStimuli::Stimulus>& BenchmarkStimuli::getStimuli() const
+{
+    return stimuli;
+}
+int BenchmarkStimuli::getHostBuffers() const
+{
+    return hostBuffers;
+}
+int BenchmarkStimuli::getRuns() const
+{
+    return runs;
+}
+bool BenchmarkStimuli::run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& processSpec, dsp::AudioBlock<float>& block,
+                            const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    jassert (processSpec.sampleRate > 0.0 && processSpec.maximumBlockSize > 0);
+    jassert (block.getNumSamples() >= processSpec.maximumBlockSize && block.getNumChannels() >= processSpec.numChannels);
+
+    spec = processSpec;
+    slotResults.clear();
+    slotResults.resize (harnesses.size());
+
+    auto processBlock = block.getSubBlock (0, spec.maximumBlockSize).getSubsetChannelBlock (0, spec.numChannels);
+    const dsp::ProcessContextReplacing<float> context (processBlock);
+
+    auto numHarnesses = 0;
+    for (size_t h = 0; h < harnesses.size(); ++h)
+    {
+        if (auto* harness = harnesses[h])
+        {
+            numHarnesses++;
+            slotResults[h].name = harness->getProcessorName();
+            if (!harness->setTimingSource (timingSource))
+                jassertfalse;
+        }
+    }
+
+    auto numerator = 0.0;
+    const auto denominator = static_cast<double> (stimuli.size()) * static_cast<double> (numHarnesses) * static_cast<double> (runs) * static_cast<double> (hostBuffers);
+    const auto reportProgress = [&]
+    {
+        return progressCallback == nullptr || progressCallback (numerator / denominator);
+    };
+
+    // The stimuli are generated with denormals enabled, & the floating point mode is switched back outside of the harness timer
+    const auto denormalsWereDisabled = FloatVectorOperations::areDenormalsDisabled();
+
+    auto completed = true;
+    for (size_t h = 0; h < harnesses.size() && completed; ++h)
+    {
+        auto* harness = harnesses[h];
+        if (!harness)
+            continue;
+
+        for (const auto stimulus : stimuli)
+        {
+            StimulusResults results;
+            results.stimulus = stimulus;
+            harness->resetStatistics();
+
+            for (auto r = 0; r < runs && completed; ++r)
+            {
+                harness->resetHarness();
+                harness->prepareHarness (spec);
+
+                StimulusGenerator generator (stimulus, spec.sampleRate);
+                for (auto b = 0; b < hostBuffers; ++b)
+                {
+                    FloatVectorOperations::disableDenormalisedNumberSupport (false);
+                    generator.fill (processBlock);
+                    FloatVectorOperations::disableDenormalisedNumberSupport (denormalsWereDisabled);
+
+                    const auto steadyCallsBefore = harness->queryProcessingDurationNumSamples();
+                    harness->processHarness (context);
+
+                    // Only the steady state calls are totalled, so the totals cover the same calls as the average, percentiles & max
+                    if (harness->queryProcessingDurationNumSamples() > steadyCallsBefore)
+                    {
+                        results.totalMs += harness->queryProcessingDurationLast();
+                        results.calls++;
+                        results.samples += static_cast<int64> (spec.maximumBlockSize);
+                    }
+                    results.nonFiniteOutputs += countNonFinite (processBlock);
+
+                    numerator++;
+                    if (!reportProgress())
+                    {
+                        completed = false;
+                        break;
+                    }
+                }
+            }
+
+            // There are no steady state calls if the warm-up was as long as the runs
+            if (harness->queryProcessingDurationNumSamples() > 0.0)
+            {
+                results.avgCall = harness->queryProcessingDurationAverage();
+                results.p50Call = harness->queryProcessingDurationPercentile (50.0);
+                results.p99Call = harness->queryProcessingDurationPercentile (99.0);
+                results.maxCall = harness->queryProcessingDurationMax();
+            }
+            if (!completed)
+                break;
+            slotResults[h].stimuli.push_back (results);
+        }
+    }
+
+    FloatVectorOperations::disableDenormalisedNumberSupport (denormalsWereDisabled);
+    return completed;
+}
+const std::vector<BenchmarkStimuli::SlotResults>& BenchmarkStimuli::getSlotResults() const
+{
+    return slotResults;
+}
+String BenchmarkStimuli::getResultsAsText() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    String txt;
+    txt << "Spec: " << static_cast<int> (spec.maximumBlockSize) << " samples, " << numChannels << " channels, " << spec.sampleRate << " Hz" << newLine
+        << hostBuffers << " blocks, " << runs << " run(s), the stimulus is regenerated before every process call" << newLine
+        << "Costs are relative to the slowly changing signal" << newLine << newLine;
+
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        txt << "Processor " << BenchmarkRunner::getSlotName (static_cast<int> (s)) << " (" << slot.name << ")" << newLine
+            << "  Stimulus                 ns/sample/ch   vs changing   Avg call (us)   p99 call (us)   Max call (us)   Non-finite outputs" << newLine;
+        StringArray nonFiniteFromFinite;
+        for (const auto& results : slot.stimuli)
+        {
+            txt << "  " << getStimulusName (results.stimulus).paddedRight (' ', 22)
+                << formatValue (results.getNsPerSample (numChannels), 3).paddedLeft (' ', 15)
+                << (formatValue (slot.getRelativeCost (results), 2) + "x").paddedLeft (' ', 14)
+                << String (results.avgCall * 1000.0, 2).paddedLeft (' ', 16)
+                << String (results.p99Call * 1000.0, 2).paddedLeft (' ', 16)
+                << String (results.maxCall * 1000.0, 2).paddedLeft (' ', 16)
+                << String (results.nonFiniteOutputs).paddedLeft (' ', 21) << newLine;
+            if (results.stimulus != Stimulus::nanInf && results.nonFiniteOutputs > 0)
+                nonFiniteFromFinite.add (getStimulusKey (results.stimulus));
+        }
+
+        const auto* fastest = slot.getFastest();
+        const auto* slowest = slot.getSlowest();
+        if (fastest && slowest && fastest != slowest && fastest->totalMs > 0.0)
+            txt << "  Slowest is " << getStimulusName (slowest->stimulus) << ", " << String (slowest->getNsPerSample (1) / fastest->getNsPerSample (1), 2)
+                << "x the fastest (" << getStimulusName (fastest->stimulus) << ")" << newLine;
+        if (nonFiniteFromFinite.size() > 0)
+            txt << "  Outputs NaN or infinity from finite input (" << nonFiniteFromFinite.joinIntoString (", ") << ")" << newLine;
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkStimuli::getResultsAsJson() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    Array<var> processors;
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        Array<var> stimulusArray;
+        for (const auto& results : slot.stimuli)
+        {
+            auto* stimulusObj = new DynamicObject();
+            stimulusObj->setProperty ("stimulus", getStimulusKey (results.stimulus));
+            stimulusObj->setProperty ("calls", results.calls);
+            stimulusObj->setProperty ("samples", results.samples);
+            stimulusObj->setProperty ("ns_per_sample", toValue (results.getNsPerSample (numChannels)));
+            stimulusObj->setProperty ("relative_to_changing", toValue (slot.getRelativeCost (results)));
+            stimulusObj->setProperty ("avg_call_us", results.avgCall * 1000.0);
+            stimulusObj->setProperty ("p50_call_us", results.p50Call * 1000.0);
+            stimulusObj->setProperty ("p99_call_us", results.p99Call * 1000.0);
+            stimulusObj->setProperty ("max_call_us", results.maxCall * 1000.0);
+            stimulusObj->setProperty ("non_finite_outputs", results.nonFiniteOutputs);
+            stimulusArray.add (var (stimulusObj));
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (static_cast<int> (s)));
+        procObj->setProperty ("name", slot.name);
+        procObj->setProperty ("stimuli", stimulusArray);
+        processors.add (var (procObj));
+    }
+
+    auto* specObj = new DynamicObject();
+    specObj->setProperty ("sampleRate", spec.sampleRate);
+    specObj->setProperty ("blockSize", static_cast<int> (spec.maximumBlockSize));
+    specObj->setProperty ("numChannels", numChannels);
+
+    auto* root = new DynamicObject();
+    root->setProperty ("spec", var (specObj));
+    root->setProperty ("hostBuffers", hostBuffers);
+    root->setProperty ("runs", runs);
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkStimuli::getResultsAsCsv() const
+{
+    const auto numChannels = static_cast<int> (spec.numChannels);
+    String csv ("slot,processor,stimulus,calls,samples,ns_per_sample,relative_to_changing,avg_call_us,p50_call_us,p99_call_us,max_call_us,non_finite_outputs\n");
+    for (size_t s = 0; s < slotResults.size(); ++s)
+    {
+        const auto& slot = slotResults[s];
+        if (slot.name.isEmpty())
+            continue;
+
+        for (const auto& results : slot.stimuli)
+        {
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (static_cast<int> (s)));
+            fields.add (slot.name.quoted());
+            fields.add (getStimulusKey (results.stimulus));
+            fields.add (String (results.calls));
+            fields.add (String (results.samples));
+            fields.add (String (results.getNsPerSample (numChannels)));
+            fields.add (String (slot.getRelativeCost (results)));
+            fields.add (String (results.avgCall * 1000.0));
+            fields.add (String (results.p50Call * 1000.0));
+            fields.add (String (results.p99Call * 1000.0));
+            fields.add (String (results.maxCall * 1000.0));
+            fields.add (String (results.nonFiniteOutputs));
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+String BenchmarkStimuli::getStimulusName (const Stimulus stimulus)
+{
+    switch (stimulus)
+    {
+        case Stimulus::silence: return "Silence";
+        case Stimulus::sine: return "Full scale sine";
+        case Stimulus::whiteNoise: return "White noise";
+        case Stimulus::pinkNoise: return "Pink noise";
+        case Stimulus::impulses: return "Impulses";
+        case Stimulus::denormalNoise: return "Denormal level noise";
+        case Stimulus::nanInf: return "NaN/Inf injection";
+        case Stimulus::changing: return "Slowly changing";
+        default: return {};
+    }
+}
+String BenchmarkStimuli::getStimulusKey (const Stimulus stimulus)
+{
+    switch (stimulus)
+    {
+        case Stimulus::silence: return "silence";
+        case Stimulus::sine: return "sine";
+        case Stimulus::whiteNoise: return "white";
+        case Stimulus::pinkNoise: return "pink";
+        case Stimulus::impulses: return "impulses";
+        case Stimulus::denormalNoise: return "denormal";
+        case Stimulus::nanInf: return "nan-inf";
+        case Stimulus::changing: return "changing";
+        default: return {};
+    }
+}
+std::vector<BenchmarkStimuli::Stimulus> BenchmarkStimuli::parseStimuli (const String& list)
+{
+    std::vector<Stimulus> parsed;
+    StringArray tokens;
+    tokens.addTokens (list, ", ", "");
+    tokens.removeEmptyStrings();
+    for (const auto& token : tokens)
+    {
+        auto found = false;
+        for (const auto stimulus : getAllStimuli())
+        {
+            if (token.trim().equalsIgnoreCase (getStimulusKey (stimulus)))
+            {
+                if (std::find (parsed.begin(), parsed.end(), stimulus) == parsed.end())
+                    parsed.push_back (stimulus);
+                found = true;
+            }
+        }
+        if (!found)
+            return {};
+    }
+    return parsed;
+}
+std::vector<BenchmarkStimuli::Stimulus> BenchmarkStimuli::getAllStimuli()
+{
+    std::vector<Stimulus> all;
+    for (auto i = 1; i <= numStimuli; ++i)
+        all.push_back (static_cast<Stimulus> (i));
+    return all;
+}
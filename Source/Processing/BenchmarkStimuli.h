@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    BenchmarkStimuli.h
+    Created: 18 Oct 2026 11:58:30pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Times each processor on a set of input signals, as data dependent branches & early outs (e.g. skipping silent blocks, gates,
+ * envelope followers or NaN checks) make the cost depend on what is being processed. The other benchmarks process the same block
+ * in place on every iteration, so after the first call the processor is fed its own output. Here the stimulus is generated
+ * afresh (outside of the timed region) before every process call, continuing from where the previous block left off.
+ */
+class BenchmarkStimuli
+{
+public:
+
+    /** Input signals (values start at 1 so they can be used as ComboBox IDs). */
+    enum class Stimulus : int
+    {
+        silence = 1,        /**< All zeros. */
+        sine,               /**< Full scale 1 kHz sine. */
+        whiteNoise,         /**< Full scale white noise (different on each channel). */
+        pinkNoise,          /**< Pink noise (different on each channel). */
+        impulses,           /**< Full scale impulses every 100 ms, silent in between. */
+        denormalNoise,      /**< White noise scaled into the subnormal range. */
+        nanInf,             /**< Half scale white noise with occasional NaN & +/- infinity samples. */
+        changing            /**< Sine gliding slowly between 50 Hz & 5 kHz with a slowly varying level (the closest to real material). */
+    };
+
+    static constexpr int numStimuli = 8;
+
+    /** Results for one stimulus (times are in milliseconds, as per ProcessorHarness). */
+    struct StimulusResults
+    {
+        Stimulus stimulus = Stimulus::silence;
+        int64 calls = 0;                /**< Number of steady state calls (the harness's warm-up calls are left out, as per its statistics). */
+        int64 samples = 0;              /**< Number of samples processed by the steady state calls (per channel). */
+        double totalMs = 0.0;           /**< Total time of the steady state calls. */
+        double avgCall = 0.0;
+        double p50Call = 0.0;
+        double p99Call = 0.0;
+        double maxCall = 0.0;
+        int64 nonFiniteOutputs = 0;     /**< Number of NaN or infinite output samples over all runs. */
+
+        /** Returns the cost in nanoseconds per sample per channel. */
+        [[nodiscard]] double getNsPerSample (const int numChannels) const;
+    };
+
+    /** Results for one processor slot. */
+    struct SlotResults
+    {
+        String name {};
+        std::vector<StimulusResults> stimuli {};
+
+        /** Returns the cost per sample of a stimulus relative to the slowly changing signal (NaN if that wasn't measured). */
+        [[nodiscard]] double getRelativeCost (const StimulusResults& results) const;
+
+        /** Returns the stimuli with the lowest & highest cost per sample (nullptr if there aren't any). */
+        [[nodiscard]] const StimulusResults* getFastest() const;
+        [[nodiscard]] const StimulusResults* getSlowest() const;
+    };
+
+    BenchmarkStimuli();
+    ~BenchmarkStimuli() = default;
+
+    /** Set the stimuli to run (in the order given). */
+    void setStimuli (const std::vector<Stimulus>& stimuliToRun);
+
+    /** Set the number of blocks (of the maximum block size) fed to the processor in each run. */
+    void setHostBuffers (const int numberOfHostBuffers);
+
+    /** Set the number of times each stimulus is run through each processor (the processor is reset & prepared before each run). */
+    void setRuns (const int numberOfRuns);
+
+    /** Set the clock used to time the process calls. */
+    void setTimingSource (const BenchmarkTimer::Source source);
+
+    [[nodiscard]] const std::vector<Stimulus>& getStimuli() const;
+    [[nodiscard]] int getHostBuffers() const;
+    [[nodiscard]] int getRuns() const;
+
+    /** Runs each stimulus through each non null harness using the given block, which is overwritten with the stimulus. The harness
+     *  statistics are reset for each stimulus. The stimuli are generated with denormals enabled (so the subnormal noise isn't
+     *  flushed to zero), while the process calls run in the calling thread's floating point mode. Returns false if the run was
+     *  aborted by the progress callback.
+     */
+    bool run (const std::vector<ProcessorHarness*>& harnesses, const dsp::ProcessSpec& spec, dsp::AudioBlock<float>& block,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    [[nodiscard]] const std::vector<SlotResults>& getSlotResults() const;
+
+    [[nodiscard]] String getResultsAsText() const;
+    [[nodiscard]] var getResultsAsJson() const;
+    [[nodiscard]] String getResultsAsCsv() const;
+
+    /** Returns a description of a stimulus (e.g. "Denormal level noise"). */
+    static String getStimulusName (const Stimulus stimulus);
+
+    /** Returns a short name for a stimulus, as used in the results & the stimulus lists (e.g. "nan-inf"). */
+    static String getStimulusKey (const Stimulus stimulus);
+
+    /** Parses a comma or space separated list of stimulus keys (returns an empty list if any of them aren't recognised). */
+    static std::vector<Stimulus> parseStimuli (const String& list);
+
+    /** Returns all of the stimuli (the default set). */
+    static std::vector<Stimulus> getAllStimuli();
+
+private:
+
+    std::vector<Stimulus> stimuli {};
+    int hostBuffers = 1000;
+    int runs = 1;
+    BenchmarkTimer::Source timingSource = BenchmarkTimer::Source::juceHighResolution;
+
+    dsp::ProcessSpec spec {};
+    std::vector<SlotResults> slotResults {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkStimuli)
+};
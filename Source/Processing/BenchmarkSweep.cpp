@@ -0,0 +1,426 @@
+/*
+  ==============================================================================
+
+    BenchmarkSweep.cpp
+    Created: 18 Oct 2026 4:22:51pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkSweep.h"
+
+namespace
+{
+    /** Returns a cost metric as a var, which is void if it wasn't measured. */
+    var toCostValue (const double nanoseconds)
+    {
+        if (!std::isfinite (nanoseconds))
+            return {};
+        return nanoseconds;
+    }
+
+    String formatCost (const double nanoseconds, const int width)
+    {
+        return (std::isfinite (nanoseconds) ? String (nanoseconds, 2) : String ("-")).paddedLeft (' ', width);
+    }
+
+    /** Time of a process call (y, in nanoseconds) against the number of samples processed by it (x = block size * channels). */
+    struct ModelPoint
+    {
+        dsp::ProcessSpec spec {};
+        double x = 0.0;
+        double y = 0.0;
+    };
+
+    /** Fits y = c0 + c1 * x by least squares weighted by 1 / x^2, which minimises the error of the cost per sample rather than of
+     *  the time per call (otherwise the largest blocks would swamp the fixed cost). Returns false if the x values are all the same.
+     */
+    bool fitLinear (const std::vector<ModelPoint>& points, double& c0, double& c1)
+    {
+        auto sw = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        auto minX = std::numeric_limits<double>::max(), maxX = 0.0;
+        for (const auto& p : points)
+        {
+            const auto w = 1.0 / (p.x * p.x);
+            sw += w;
+            sx += w * p.x;
+            sy += w * p.y;
+            sxx += w * p.x * p.x;
+            sxy += w * p.x * p.y;
+            minX = jmin (minX, p.x);
+            maxX = jmax (maxX, p.x);
+        }
+        if (points.size() < 2 || maxX <= minX)
+            return false;
+
+        c1 = (sw * sxy - sx * sy) / (sw * sxx - sx * sx);
+        c0 = (sy - c1 * sx) / sw;
+        return true;
+    }
+}
+
+bool BenchmarkSweep::CostModel::isValid() const
+{
+    return numPoints > 0;
+}
+double BenchmarkSweep::CostModel::predictNs (const int blockSize, const int numChannels) const
+{
+    return fixedNs + perSampleNs * static_cast<double> (blockSize) * static_cast<double> (numChannels);
+}
+double BenchmarkSweep::CostModel::getFixedFraction (const int blockSize, const int numChannels) const
+{
+    const auto predicted = predictNs (blockSize, numChannels);
+    return predicted > 0.0 ? jlimit (0.0, 1.0, fixedNs / predicted) : std::numeric_limits<double>::quiet_NaN();
+}
+
+BenchmarkSweep::BenchmarkSweep()
+{
+    for (auto b = 16; b <= 8192; b *= 2)
+        blockSizes.add (b);
+    channelCounts = { 1, 2, 8, 64 };
+    sampleRates = { 44100.0, 96000.0, 384000.0 };
+}
+void BenchmarkSweep::setBlockSizes (const Array<int>& sizes)
+{
+    blockSizes = sizes;
+}
+void BenchmarkSweep::setChannelCounts (const Array<int>& counts)
+{
+    channelCounts = counts;
+}
+void BenchmarkSweep::setSampleRates (const Array<double>& rates)
+{
+    sampleRates = rates;
+}
+const Array<int>& BenchmarkSweep::getBlockSizes() const
+{
+    return blockSizes;
+}
+const Array<int>& BenchmarkSweep::getChannelCounts() const
+{
+    return channelCounts;
+}
+const Array<double>& BenchmarkSweep::getSampleRates() const
+{
+    return sampleRates;
+}
+int BenchmarkSweep::getNumCells() const
+{
+    return blockSizes.size() * channelCounts.size() * sampleRates.size();
+}
+bool BenchmarkSweep::run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const FillCallback& fillCallback,
+                          const BenchmarkRunner::ProgressCallback& progressCallback)
+{
+    cells.clear();
+    processorNames.clear();
+    for (auto* h : harnesses)
+        processorNames.add (h ? h->getProcessorName() : String());
+
+    const auto numCells = getNumCells();
+    auto cellIndex = 0;
+    for (const auto sampleRate : sampleRates)
+    {
+        for (const auto numChannels : channelCounts)
+        {
+            for (const auto blockSize : blockSizes)
+            {
+                const dsp::ProcessSpec spec { sampleRate, static_cast<uint32> (blockSize), static_cast<uint32> (numChannels) };
+                runner.setProcessSpec (spec);
+                if (fillCallback)
+                    fillCallback (runner.getAudioBlock(), spec);
+
+                for (auto* h : harnesses)
+                    if (h) h->resetStatistics();
+
+                const auto completed = runner.run (harnesses, [&] (const double progress)
+                {
+                    return progressCallback == nullptr || progressCallback ((static_cast<double> (cellIndex) + progress) / static_cast<double> (numCells));
+                });
+                if (!completed)
+                    return false;
+
+                Cell cell;
+                cell.spec = spec;
+                for (auto* h : harnesses)
+                    cell.costs.push_back (getCost (h, spec));
+                cells.push_back (cell);
+                cellIndex++;
+            }
+        }
+    }
+    return true;
+}
+BenchmarkSweep::Cost BenchmarkSweep::getCost (const ProcessorHarness* harness, const dsp::ProcessSpec& spec)
+{
+    Cost cost;
+    if (harness && harness->queryProcessingDurationNumSamples() > 0.0)
+    {
+        // Statistics are gathered in milliseconds per call
+        const auto samplesPerCall = static_cast<double> (spec.maximumBlockSize) * static_cast<double> (spec.numChannels);
+        const auto toNsPerSample = 1.0E6 / samplesPerCall;
+        cost.min = harness->queryProcessingDurationMin() * toNsPerSample;
+        cost.avg = harness->queryProcessingDurationAverage() * toNsPerSample;
+        cost.p50 = harness->queryProcessingDurationPercentile (50.0) * toNsPerSample;
+        cost.p99 = harness->queryProcessingDurationPercentile (99.0) * toNsPerSample;
+    }
+    return cost;
+}
+const std::vector<BenchmarkSweep::Cell>& BenchmarkSweep::getCells() const
+{
+    return cells;
+}
+BenchmarkSweep::CostModel BenchmarkSweep::getCostModel (const int harnessIndex) const
+{
+    CostModel model;
+    std::vector<ModelPoint> points;
+    for (const auto& cell : cells)
+    {
+        const auto cost = cell.costs[static_cast<size_t> (harnessIndex)].avg;
+        if (!std::isfinite (cost) || cost <= 0.0)
+            continue;
+
+        ModelPoint point;
+        point.spec = cell.spec;
+        point.x = static_cast<double> (cell.spec.maximumBlockSize) * static_cast<double> (cell.spec.numChannels);
+        point.y = cost * point.x;
+        points.push_back (point);
+    }
+
+    auto c0 = 0.0, c1 = 0.0;
+    if (points.size() < 3 || !fitLinear (points, c0, c1))
+        return model;
+
+    const auto getDeviation = [&c0, &c1] (const ModelPoint& p)
+    {
+        const auto predicted = c0 + c1 * p.x;
+        return predicted > 0.0 ? (p.y - predicted) / predicted : std::numeric_limits<double>::infinity();
+    };
+
+    // Refit once without the cells which don't fit, so that a non-linear region doesn't drag the model of the linear one
+    std::vector<ModelPoint> linearPoints;
+    for (const auto& p : points)
+        if (std::abs (getDeviation (p)) <= nonLinearThreshold)
+            linearPoints.push_back (p);
+    if (linearPoints.size() >= 3 && linearPoints.size() < points.size())
+    {
+        auto refitC0 = 0.0, refitC1 = 0.0;
+        if (fitLinear (linearPoints, refitC0, refitC1))
+        {
+            c0 = refitC0;
+            c1 = refitC1;
+        }
+    }
+
+    model.fixedNs = c0;
+    model.perSampleNs = c1;
+    auto sumY = 0.0, sumSquaredResiduals = 0.0, sumSquaredDeviations = 0.0;
+    std::vector<ModelPoint> fittedPoints;
+    for (const auto& p : points)
+    {
+        const auto deviation = getDeviation (p);
+        if (std::abs (deviation) > nonLinearThreshold)
+        {
+            model.nonLinearCells.push_back ({ p.spec, deviation });
+            continue;
+        }
+        fittedPoints.push_back (p);
+        sumY += p.y;
+        sumSquaredResiduals += square (p.y - (c0 + c1 * p.x));
+        sumSquaredDeviations += square (deviation);
+    }
+
+    model.numPoints = static_cast<int> (fittedPoints.size());
+    if (model.numPoints > 0)
+    {
+        const auto meanY = sumY / static_cast<double> (model.numPoints);
+        auto sumSquaredTotal = 0.0;
+        for (const auto& p : fittedPoints)
+            sumSquaredTotal += square (p.y - meanY);
+        model.rSquared = sumSquaredTotal > 0.0 ? 1.0 - sumSquaredResiduals / sumSquaredTotal : 1.0;
+        model.rmsDeviation = std::sqrt (sumSquaredDeviations / static_cast<double> (model.numPoints));
+    }
+    return model;
+}
+const StringArray& BenchmarkSweep::getProcessorNames() const
+{
+    return processorNames;
+}
+String BenchmarkSweep::getResultsAsText() const
+{
+    constexpr auto columnWidth = 10;
+    String txt;
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        // The minimum is shown as well as the average, as it is the most repeatable figure (e.g. for comparing runs)
+        const std::pair<const char*, double Cost::*> metrics[] = { { "average", &Cost::avg }, { "minimum", &Cost::min } };
+        for (const auto sampleRate : sampleRates)
+        {
+            for (const auto& [metricName, metric] : metrics)
+            {
+                txt << "Processor " << BenchmarkRunner::getSlotName (h) << " (" << processorNames[h] << ") at "
+                    << String (sampleRate, 0) << " Hz - " << metricName << " ns per sample per channel" << newLine;
+
+                txt << String ("Block").paddedRight (' ', 8);
+                for (const auto numChannels : channelCounts)
+                    txt << (String (numChannels) + "ch").paddedLeft (' ', columnWidth);
+                txt << newLine;
+
+                for (const auto blockSize : blockSizes)
+                {
+                    txt << String (blockSize).paddedRight (' ', 8);
+                    for (const auto numChannels : channelCounts)
+                    {
+                        auto cost = std::numeric_limits<double>::quiet_NaN();
+                        for (const auto& cell : cells)
+                            if (cell.spec.sampleRate == sampleRate && static_cast<int> (cell.spec.numChannels) == numChannels && static_cast<int> (cell.spec.maximumBlockSize) == blockSize)
+                                cost = cell.costs[static_cast<size_t> (h)].*metric;
+                        txt << formatCost (cost, columnWidth);
+                    }
+                    txt << newLine;
+                }
+                txt << newLine;
+            }
+        }
+
+        const auto model = getCostModel (h);
+        txt << "Processor " << BenchmarkRunner::getSlotName (h) << " (" << processorNames[h] << ") cost model - t = c0 + c1 x block size x channels" << newLine;
+        if (!model.isValid())
+        {
+            txt << "  Needs at least 3 cells with different numbers of samples per call" << newLine << newLine;
+            continue;
+        }
+
+        // 32 samples of stereo is a typical low latency setting, where the fixed cost matters most
+        const auto lowLatencyFixedFraction = model.getFixedFraction (32, 2);
+        txt << "  Fixed cost per call (c0)       " << String (model.fixedNs, 1) << " ns" << newLine
+            << "  Cost per sample/channel (c1)   " << String (model.perSampleNs, 3) << " ns" << newLine
+            << "  Fit                            R^2 " << String (model.rSquared, 4) << ", rms deviation "
+            << String (model.rmsDeviation * 100.0, 1) << "% over " << model.numPoints << " cells" << newLine
+            << "  At 32 samples x 2 channels     " << String (model.predictNs (32, 2) / 1000.0, 2) << " us per call, "
+            << String (lowLatencyFixedFraction * 100.0, 0) << "% of it fixed cost" << newLine
+            << "  " << (lowLatencyFixedFraction > 0.5 ? "The fixed cost dominates small blocks (optimise the per call setup code)"
+                                                      : "The per sample cost dominates (optimise the inner loops)") << newLine;
+
+        if (!model.nonLinearCells.empty())
+        {
+            constexpr size_t maxListed = 12;
+            txt << "  Non-linear cells (more than " << String (nonLinearThreshold * 100.0, 0) << "% from the model, e.g. a block no longer fitting in cache):" << newLine;
+            for (size_t i = 0; i < jmin (maxListed, model.nonLinearCells.size()); ++i)
+            {
+                const auto& cell = model.nonLinearCells[i];
+                txt << "    " << static_cast<int> (cell.spec.maximumBlockSize) << " x " << static_cast<int> (cell.spec.numChannels) << "ch at "
+                    << String (cell.spec.sampleRate, 0) << " Hz: " << (cell.deviation >= 0.0 ? "+" : "") << String (cell.deviation * 100.0, 0) << "%" << newLine;
+            }
+            if (model.nonLinearCells.size() > maxListed)
+                txt << "    ... and " << static_cast<int> (model.nonLinearCells.size() - maxListed) << " more" << newLine;
+        }
+        txt << newLine;
+    }
+    return txt;
+}
+var BenchmarkSweep::getResultsAsJson() const
+{
+    Array<var> processors;
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        Array<var> cellResults;
+        for (const auto& cell : cells)
+        {
+            const auto& cost = cell.costs[static_cast<size_t> (h)];
+            auto* cellObj = new DynamicObject();
+            cellObj->setProperty ("sampleRate", cell.spec.sampleRate);
+            cellObj->setProperty ("blockSize", static_cast<int> (cell.spec.maximumBlockSize));
+            cellObj->setProperty ("numChannels", static_cast<int> (cell.spec.numChannels));
+            cellObj->setProperty ("min_ns_per_sample", toCostValue (cost.min));
+            cellObj->setProperty ("avg_ns_per_sample", toCostValue (cost.avg));
+            cellObj->setProperty ("p50_ns_per_sample", toCostValue (cost.p50));
+            cellObj->setProperty ("p99_ns_per_sample", toCostValue (cost.p99));
+            cellResults.add (var (cellObj));
+        }
+
+        var modelResult;
+        const auto model = getCostModel (h);
+        if (model.isValid())
+        {
+            Array<var> nonLinearCells;
+            for (const auto& cell : model.nonLinearCells)
+            {
+                auto* cellObj = new DynamicObject();
+                cellObj->setProperty ("sampleRate", cell.spec.sampleRate);
+                cellObj->setProperty ("blockSize", static_cast<int> (cell.spec.maximumBlockSize));
+                cellObj->setProperty ("numChannels", static_cast<int> (cell.spec.numChannels));
+                cellObj->setProperty ("deviation", cell.deviation);
+                nonLinearCells.add (var (cellObj));
+            }
+
+            auto* modelObj = new DynamicObject();
+            modelObj->setProperty ("fixed_ns", model.fixedNs);
+            modelObj->setProperty ("per_sample_ns", model.perSampleNs);
+            modelObj->setProperty ("r_squared", model.rSquared);
+            modelObj->setProperty ("rms_deviation", model.rmsDeviation);
+            modelObj->setProperty ("points", model.numPoints);
+            modelObj->setProperty ("non_linear", nonLinearCells);
+            modelResult = var (modelObj);
+        }
+
+        auto* procObj = new DynamicObject();
+        procObj->setProperty ("slot", BenchmarkRunner::getSlotName (h));
+        procObj->setProperty ("name", processorNames[h]);
+        procObj->setProperty ("model", modelResult);
+        procObj->setProperty ("cells", cellResults);
+        processors.add (var (procObj));
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty ("processors", processors);
+    return var (root);
+}
+String BenchmarkSweep::getResultsAsCsv() const
+{
+    String csv ("slot,processor,sample_rate,block_size,channels,min_ns_per_sample,avg_ns_per_sample,p50_ns_per_sample,p99_ns_per_sample\n");
+    for (auto h = 0; h < processorNames.size(); ++h)
+    {
+        if (processorNames[h].isEmpty())
+            continue;
+
+        for (const auto& cell : cells)
+        {
+            const auto& cost = cell.costs[static_cast<size_t> (h)];
+            StringArray fields;
+            fields.add (BenchmarkRunner::getSlotName (h));
+            fields.add (processorNames[h].quoted());
+            fields.add (String (cell.spec.sampleRate));
+            fields.add (String (cell.spec.maximumBlockSize));
+            fields.add (String (cell.spec.numChannels));
+            fields.add (toCostValue (cost.min).toString());
+            fields.add (toCostValue (cost.avg).toString());
+            fields.add (toCostValue (cost.p50).toString());
+            fields.add (toCostValue (cost.p99).toString());
+            csv << fields.joinIntoString (",") << "\n";
+        }
+    }
+    return csv;
+}
+Array<int> BenchmarkSweep::parseIntList (const String& text, const int minimumValue)
+{
+    Array<int> list;
+    for (const auto& token : StringArray::fromTokens (text, ", ;", ""))
+        if (token.containsOnly ("+-0123456789") && token.getIntValue() >= minimumValue)
+            list.addIfNotAlreadyThere (token.getIntValue());
+    return list;
+}
+Array<double> BenchmarkSweep::parseDoubleList (const String& text)
+{
+    Array<double> list;
+    for (const auto& token : StringArray::fromTokens (text, ", ;", ""))
+        if (token.getDoubleValue() > 0.0)
+            list.addIfNotAlreadyThere (token.getDoubleValue());
+    return list;
+}
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    BenchmarkSweep.h
+    Created: 18 Oct 2026 4:22:51pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkRunner.h"
+
+/**
+ * Runs the benchmark cycles over a grid of block sizes, channel counts & sample rates, recording the processing cost of each
+ * harness in nanoseconds per sample per channel. This shows where a processor's scaling breaks down (e.g. cache cliffs,
+ * per call overhead dominating small blocks or channel loops which don't vectorise).
+ */
+class BenchmarkSweep
+{
+public:
+
+    /** Called to fill the runner's audio block with the test signal after the spec for a cell has been set. */
+    using FillCallback = std::function<void (dsp::AudioBlock<float>&, const dsp::ProcessSpec&)>;
+
+    /** Processing cost of a harness for one cell of the grid (in nanoseconds per sample per channel, NaN if not measured). */
+    struct Cost
+    {
+        double min = std::numeric_limits<double>::quiet_NaN();
+        double avg = std::numeric_limits<double>::quiet_NaN();
+        double p50 = std::numeric_limits<double>::quiet_NaN();
+        double p99 = std::numeric_limits<double>::quiet_NaN();
+    };
+
+    struct Cell
+    {
+        dsp::ProcessSpec spec {};
+        std::vector<Cost> costs {};     /**< One per harness (in the same order as the harnesses passed to run()). */
+    };
+
+    /** Linear model of the average time per process call, t = fixedNs + perSampleNs * blockSize * channels, fitted over the cells.
+     *  The fit minimises the relative error (so the small blocks, which determine the fixed cost, count as much as the large ones),
+     *  & cells which deviate from it by more than the threshold are excluded & refitted once, so that a non-linear region (e.g. a
+     *  block no longer fitting in cache) doesn't skew the model of the rest.
+     */
+    struct CostModel
+    {
+        struct Deviation
+        {
+            dsp::ProcessSpec spec {};
+            double deviation = 0.0;     /**< Relative difference between the measured & modelled time (e.g. 0.4 if 40% slower). */
+        };
+
+        int numPoints = 0;              /**< Number of cells the model was fitted to (0 if it couldn't be fitted). */
+        double fixedNs = 0.0;           /**< Fixed cost of each process call (c0). */
+        double perSampleNs = 0.0;       /**< Marginal cost of each sample of each channel (c1). */
+        double rSquared = 0.0;          /**< Coefficient of determination of the fitted cells. */
+        double rmsDeviation = 0.0;      /**< Root mean square relative deviation of the fitted cells. */
+        std::vector<Deviation> nonLinearCells {};
+
+        [[nodiscard]] bool isValid() const;
+
+        /** Returns the modelled time of a process call in nanoseconds. */
+        [[nodiscard]] double predictNs (const int blockSize, const int numChannels) const;
+
+        /** Returns the fraction of the modelled time of a process call which is the fixed cost. */
+        [[nodiscard]] double getFixedFraction (const int blockSize, const int numChannels) const;
+    };
+
+    /** Relative deviation from the cost model beyond which a cell is reported as non-linear. */
+    static constexpr double nonLinearThreshold = 0.2;
+
+    BenchmarkSweep();
+    ~BenchmarkSweep() = default;
+
+    void setBlockSizes (const Array<int>& sizes);
+    void setChannelCounts (const Array<int>& counts);
+    void setSampleRates (const Array<double>& rates);
+
+    [[nodiscard]] const Array<int>& getBlockSizes() const;
+    [[nodiscard]] const Array<int>& getChannelCounts() const;
+    [[nodiscard]] const Array<double>& getSampleRates() const;
+    [[nodiscard]] int getNumCells() const;
+
+    /** Runs the runner's test cycles for each cell of the grid (the runner's spec is changed for each cell, and the harness
+     *  statistics are reset). Returns false if the sweep was aborted by the progress callback.
+     */
+    bool run (BenchmarkRunner& runner, const std::vector<ProcessorHarness*>& harnesses, const FillCallback& fillCallback,
+              const BenchmarkRunner::ProgressCallback& progressCallback = nullptr);
+
+    /** Returns the processing cost of a harness from its current statistics (all NaN if it is null or hasn't been run). */
+    static Cost getCost (const ProcessorHarness* harness, const dsp::ProcessSpec& spec);
+
+    /** Returns the results of the last sweep (one cell per spec, ordered by sample rate, then channels, then block size). */
+    [[nodiscard]] const std::vector<Cell>& getCells() const;
+
+    /** Fits the cost model of a harness (by index) to the average cost of each cell of the last sweep. */
+    [[nodiscard]] CostModel getCostModel (const int harnessIndex) const;
+
+    /** Returns the names of the processors which were swept (empty for empty slots). */
+    [[nodiscard]] const StringArray& getProcessorNames() const;
+
+    /** Returns the results as text tables of average cost (block sizes down, channels across) for each processor & sample rate. */
+    [[nodiscard]] String getResultsAsText() const;
+
+    /** Returns the results as a JSON object (costs are in nanoseconds per sample per channel, & the cost model in nanoseconds). */
+    [[nodiscard]] var getResultsAsJson() const;
+
+    /** Returns the results as CSV text with a header row (costs are in nanoseconds per sample per channel). */
+    [[nodiscard]] String getResultsAsCsv() const;
+
+    /** Parses a comma (or space) separated list of numbers (e.g. "16, 32, 64"), ignoring anything which isn't a number of at
+     *  least the minimum value (or for doubles, which isn't positive).
+     */
+    static Array<int> parseIntList (const String& text, const int minimumValue = 1);
+    static Array<double> parseDoubleList (const String& text);
+
+private:
+
+    Array<int> blockSizes;
+    Array<int> channelCounts;
+    Array<double> sampleRates;
+    std::vector<Cell> cells {};
+    StringArray processorNames {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkSweep)
+};
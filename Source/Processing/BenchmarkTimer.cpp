@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    BenchmarkTimer.cpp
+    Created: 18 Oct 2026 1:41:07pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "BenchmarkTimer.h"
+
+#if JUCE_INTEL && ! JUCE_MSVC
+ #include <cpuid.h>
+#endif
+
+BenchmarkTimer::BenchmarkTimer()
+{
+    msPerTick = 1000.0 / getTicksPerSecond (source);
+    calibrateOverhead();
+}
+bool BenchmarkTimer::setSource (const Source newSource)
+{
+    if (!isSourceAvailable (newSource))
+        return false;
+
+    source = newSource;
+    msPerTick = 1000.0 / getTicksPerSecond (source);
+    calibrateOverhead();
+    return true;
+}
+BenchmarkTimer::Source BenchmarkTimer::getSource() const noexcept
+{
+    return source;
+}
+bool BenchmarkTimer::isSourceAvailable (const Source sourceToCheck)
+{
+    switch (sourceToCheck)
+    {
+        case Source::juceHighResolution:
+            return true;
+
+        case Source::tsc:
+        {
+           #if JUCE_INTEL
+            // Only use the TSC if it is invariant (i.e. it ticks at a constant rate regardless of frequency scaling & power states)
+            unsigned int regs[4] = {};
+           #if JUCE_MSVC
+            int info[4] = {};
+            __cpuid (info, static_cast<int> (0x80000000));
+            if (static_cast<unsigned int> (info[0]) < 0x80000007)
+                return false;
+            __cpuid (info, static_cast<int> (0x80000007));
+            regs[3] = static_cast<unsigned int> (info[3]);
+           #else
+            if (__get_cpuid (0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]) == 0)
+                return false;
+           #endif
+            return (regs[3] & (1u << 8)) != 0;
+           #else
+            return false;
+           #endif
+        }
+
+        case Source::monotonicRaw:
+           #if defined (CLOCK_MONOTONIC_RAW)
+            return true;
+           #else
+            return false;
+           #endif
+
+        default:
+            return false;
+    }
+}
+String BenchmarkTimer::getSourceName (const Source sourceToDescribe)
+{
+    switch (sourceToDescribe)
+    {
+        case Source::juceHighResolution:    return "JUCE high resolution";
+        case Source::tsc:                   return "TSC";
+        case Source::monotonicRaw:          return "CLOCK_MONOTONIC_RAW";
+        default:                            return "Unknown";
+    }
+}
+void BenchmarkTimer::calibrateOverhead()
+{
+    // Use the median of many empty readings so that the odd interruption doesn't skew the result
+    constexpr auto numReadings = 10000;
+    std::vector<int64> readings (static_cast<size_t> (numReadings));
+
+    overheadMs = 0.0;
+    for (auto& r : readings)
+    {
+        const auto startTicks = start();
+        const auto stopTicks = stop();
+        r = stopTicks - startTicks;
+    }
+
+    std::nth_element (readings.begin(), readings.begin() + numReadings / 2, readings.end());
+    overheadMs = static_cast<double> (readings[static_cast<size_t> (numReadings / 2)]) * msPerTick;
+}
+double BenchmarkTimer::getOverheadMs() const noexcept
+{
+    return overheadMs;
+}
+double BenchmarkTimer::getTscTicksPerSecond()
+{
+   #if JUCE_INTEL
+    // Measure once against the high resolution clock (over 100ms, to keep the error well below 0.1%)
+    static const double ticksPerSecond = []
+    {
+        const auto hiResTicksPerSecond = static_cast<double> (Time::getHighResolutionTicksPerSecond());
+        const auto hiResStart = Time::getHighResolutionTicks();
+        const auto tscStart = __rdtsc();
+        while (static_cast<double> (Time::getHighResolutionTicks() - hiResStart) < hiResTicksPerSecond * 0.1)
+        { }
+        const auto tscStop = __rdtsc();
+        const auto hiResStop = Time::getHighResolutionTicks();
+        return static_cast<double> (tscStop - tscStart) * hiResTicksPerSecond / static_cast<double> (hiResStop - hiResStart);
+    }();
+    return ticksPerSecond;
+   #else
+    jassertfalse; // The TSC is only available on x86
+    return 1.0;
+   #endif
+}
+double BenchmarkTimer::getTicksPerSecond (const Source clockSource)
+{
+    switch (clockSource)
+    {
+        case Source::tsc:           return getTscTicksPerSecond();
+        case Source::monotonicRaw:  return 1.0E9;
+        case Source::juceHighResolution:
+        default:                    return static_cast<double> (Time::getHighResolutionTicksPerSecond());
+    }
+}
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    BenchmarkTimer.h
+    Created: 18 Oct 2026 1:41:07pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <time.h>
+#endif
+
+/**
+ * Selectable clock used by the ProcessorHarness to time routines.
+ *
+ * The overhead of an empty start()/stop() pair is calibrated and subtracted from each elapsed time, so that
+ * very short routines (e.g. small block sizes) aren't dominated by the cost of reading the clock.
+ */
+class BenchmarkTimer
+{
+public:
+
+    enum class Source : int
+    {
+        juceHighResolution = 1, // Start from 1 because these are used for ComboBox itemIds and thus cannot be 0
+        tsc,                    // Invariant time stamp counter read with serialising fences (x86 only)
+        monotonicRaw            // clock_gettime (CLOCK_MONOTONIC_RAW) (Linux/macOS only)
+    };
+
+    BenchmarkTimer();
+    ~BenchmarkTimer() = default;
+
+    /** Selects the clock & recalibrates the timer overhead. Returns false (and leaves the source unchanged) if the clock isn't available.
+     *  Don't call this while the timer is in use on another thread.
+     */
+    bool setSource (const Source newSource);
+
+    [[nodiscard]] Source getSource() const noexcept;
+
+    /** Returns true if the given clock can be used on this machine. */
+    static bool isSourceAvailable (const Source sourceToCheck);
+
+    /** Returns a short description of the clock. */
+    static String getSourceName (const Source sourceToDescribe);
+
+    /** Measures the overhead of an empty start()/stop() pair, which is then subtracted from subsequent elapsed times. */
+    void calibrateOverhead();
+
+    /** Returns the calibrated overhead (in milliseconds) which is subtracted from each elapsed time. */
+    [[nodiscard]] double getOverheadMs() const noexcept;
+
+    /** Reads the clock at the start of a timed section. */
+    [[nodiscard]] inline int64 start() const noexcept
+    {
+        switch (source)
+        {
+           #if JUCE_INTEL
+            case Source::tsc:
+            {
+                // Prevent earlier instructions from executing after the counter is read, and later ones before it
+                _mm_lfence();
+                const auto ticks = static_cast<int64> (__rdtsc());
+                _mm_lfence();
+                return ticks;
+            }
+           #endif
+           #if defined (CLOCK_MONOTONIC_RAW)
+            case Source::monotonicRaw:
+                return readMonotonicRaw();
+           #endif
+            case Source::juceHighResolution:
+            default:
+                return Time::getHighResolutionTicks();
+        }
+    }
+
+    /** Reads the clock at the end of a timed section. */
+    [[nodiscard]] inline int64 stop() const noexcept
+    {
+        switch (source)
+        {
+           #if JUCE_INTEL
+            case Source::tsc:
+            {
+                // rdtscp waits for earlier instructions to complete and the fence stops later ones starting early
+                unsigned int aux = 0;
+                const auto ticks = static_cast<int64> (__rdtscp (&aux));
+                _mm_lfence();
+                return ticks;
+            }
+           #endif
+           #if defined (CLOCK_MONOTONIC_RAW)
+            case Source::monotonicRaw:
+                return readMonotonicRaw();
+           #endif
+            case Source::juceHighResolution:
+            default:
+                return Time::getHighResolutionTicks();
+        }
+    }
+
+    /** Returns the time between two readings in milliseconds, less the calibrated overhead (never negative). */
+    [[nodiscard]] inline double getElapsedMs (const int64 startTicks, const int64 stopTicks) const noexcept
+    {
+        return jmax (0.0, static_cast<double> (stopTicks - startTicks) * msPerTick - overheadMs);
+    }
+
+private:
+
+   #if defined (CLOCK_MONOTONIC_RAW)
+    static inline int64 readMonotonicRaw() noexcept
+    {
+        timespec t;
+        clock_gettime (CLOCK_MONOTONIC_RAW, &t);
+        return static_cast<int64> (t.tv_sec) * 1000000000 + static_cast<int64> (t.tv_nsec);
+    }
+   #endif
+
+    /** Returns the TSC frequency, which is measured against the high resolution clock the first time this is called. */
+    static double getTscTicksPerSecond();
+
+    static double getTicksPerSecond (const Source clockSource);
+
+    Source source = Source::juceHighResolution;
+    double msPerTick = 0.0;
+    double overheadMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkTimer)
+};
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    CacheEvictor.cpp
+    Created: 18 Oct 2026 8:31:52pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "CacheEvictor.h"
+#include <array>
+#include <utility>
+
+#if JUCE_MAC
+ #include <sys/sysctl.h>
+#endif
+
+namespace
+{
+    constexpr size_t cacheLineSize = 64;
+    constexpr size_t minBufferSize = 8 * 1024 * 1024;
+    constexpr size_t maxBufferSize = 512 * 1024 * 1024;
+    constexpr size_t defaultLastLevelCacheSize = 64 * 1024 * 1024;    // used if the cache size can't be determined
+    constexpr uint32 numPollutionFunctions = 2048;                      // roughly 150KB of code, several times the size of a typical L1 instruction cache
+
+    /** Each instantiation is a small function with different constants, so the linker can't fold them together. */
+    template <uint32 N>
+    uint32 pollutionStep (uint32 x) noexcept
+    {
+        x ^= x << ((N % 13) + 1);
+        x ^= x >> ((N % 17) + 1);
+        x *= (N * 2654435761u) | 1u;
+        return x + N;
+    }
+
+    using PollutionFunction = uint32 (*) (uint32);
+
+    template <uint32... Ns>
+    constexpr std::array<PollutionFunction, sizeof... (Ns)> makePollutionTable (std::integer_sequence<uint32, Ns...>)
+    {
+        return { { &pollutionStep<Ns>... } };
+    }
+
+    const auto pollutionTable = makePollutionTable (std::make_integer_sequence<uint32, numPollutionFunctions>());
+}
+
+void CacheEvictor::setInstructionCachePollution (const bool shouldPollute)
+{
+    pollutesInstructionCache = shouldPollute;
+}
+bool CacheEvictor::getInstructionCachePollution() const
+{
+    return pollutesInstructionCache;
+}
+void CacheEvictor::prepare()
+{
+    if (bufferSize > 0)
+        return;
+
+    const auto llcSize = getLastLevelCacheSize();
+    bufferSize = jlimit (minBufferSize, maxBufferSize, 2 * (llcSize > 0 ? llcSize : defaultLastLevelCacheSize));
+
+    // Clearing the buffer touches every page, so the page faults happen now rather than during the first eviction
+    buffer.allocate (bufferSize, true);
+}
+void CacheEvictor::evict()
+{
+    jassert (bufferSize > 0); // You need to call prepare() first!
+
+    // Writing (rather than just reading) leaves the lines dirty, as other plugins' buffers would be
+    for (size_t i = 0; i < bufferSize; i += cacheLineSize)
+        buffer[i]++;
+
+    if (pollutesInstructionCache)
+    {
+        auto x = instructionSink;
+        for (const auto fn : pollutionTable)
+            x = fn (x);
+        instructionSink = x;
+    }
+}
+size_t CacheEvictor::getBufferSize() const
+{
+    return bufferSize;
+}
+size_t CacheEvictor::getLastLevelCacheSize()
+{
+   #if JUCE_LINUX
+    // Find the highest level data (or unified) cache of the first CPU
+    auto highestLevel = 0;
+    size_t size = 0;
+    for (const auto& dir : File ("/sys/devices/system/cpu/cpu0/cache").findChildFiles (File::findDirectories, false, "index*"))
+    {
+        if (dir.getChildFile ("type").loadFileAsString().trim() == "Instruction")
+            continue;
+
+        const auto level = dir.getChildFile ("level").loadFileAsString().getIntValue();
+        const auto sizeText = dir.getChildFile ("size").loadFileAsString().trim();
+        auto levelSize = static_cast<size_t> (sizeText.getLargeIntValue());
+        if (sizeText.endsWithIgnoreCase ("K"))
+            levelSize *= 1024;
+        else if (sizeText.endsWithIgnoreCase ("M"))
+            levelSize *= 1024 * 1024;
+
+        if (level > highestLevel && levelSize > 0)
+        {
+            highestLevel = level;
+            size = levelSize;
+        }
+    }
+    return size;
+   #elif JUCE_MAC
+    // Apple silicon doesn't report an L3, in which case the L2 is the last level
+    for (const auto* name : { "hw.l3cachesize", "hw.l2cachesize" })
+    {
+        int64_t value = 0;
+        auto valueSize = sizeof (value);
+        if (sysctlbyname (name, &value, &valueSize, nullptr, 0) == 0 && value > 0)
+            return static_cast<size_t> (value);
+    }
+    return 0;
+   #else
+    return 0;
+   #endif
+}
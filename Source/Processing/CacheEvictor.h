@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    CacheEvictor.h
+    Created: 18 Oct 2026 8:31:52pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/**
+ * Evicts the processor's code & data from the CPU caches between process calls, to approximate a DAW where other plugins
+ * run between our callbacks.
+ *
+ * Data is evicted by streaming through (reading & writing one byte per cache line of) a buffer twice the size of the last
+ * level cache. Optionally, the instruction cache (& branch predictors) can also be polluted by calling a large table of small
+ * distinct functions.
+ */
+class CacheEvictor
+{
+public:
+
+    CacheEvictor() = default;
+    ~CacheEvictor() = default;
+
+    /** Also pollute the instruction cache when evicting. */
+    void setInstructionCachePollution (const bool shouldPollute);
+    [[nodiscard]] bool getInstructionCachePollution() const;
+
+    /** Allocates & touches the eviction buffer if it hasn't been already (this is slow, so call it before timing anything). */
+    void prepare();
+
+    /** Evicts the caches. Call prepare() first. */
+    void evict();
+
+    /** Returns the size of the eviction buffer in bytes (0 until prepare() has been called). */
+    [[nodiscard]] size_t getBufferSize() const;
+
+    /** Returns the size of the last level cache in bytes, or 0 if it couldn't be determined. */
+    static size_t getLastLevelCacheSize();
+
+private:
+
+    HeapBlock<uint8> buffer {};
+    size_t bufferSize = 0;
+    bool pollutesInstructionCache = false;
+    uint32 instructionSink = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CacheEvictor)
+};
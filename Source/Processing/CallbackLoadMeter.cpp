@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    CallbackLoadMeter.cpp
+    Created: 19 Oct 2026 2:04:52am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "CallbackLoadMeter.h"
+
+void CallbackLoadMeter::prepare (const double sampleRate)
+{
+    jassert (sampleRate > 0.0);
+    msPerSample = sampleRate > 0.0 ? 1000.0 / sampleRate : 0.0;
+    samplesPerWindow = jmax (1, roundToInt (sampleRate * windowSeconds));
+    previousStartTicks = -1;
+    callbackPeriodMs = 0.0;
+    lastDeviceXrunCount = -1;
+    windowSamples = 0;
+    windowPeriodMs = 0.0;
+    windowStageMs.fill (0.0);
+    windowPeakLoad.fill (0.0);
+    windowPeakTotalLoad = 0.0;
+    windowIntervals = 0;
+    windowIntervalSum = 0.0;
+    windowIntervalSquares = 0.0;
+    windowMaxIntervalError = 0.0;
+
+    frame = {};
+    probe.writeFrame (&frame);
+}
+void CallbackLoadMeter::beginCallback (const int numSamples, const int deviceXrunCount) noexcept
+{
+    lapTicks = timer.start();
+
+    // The interval is compared with the period of the previous block (callbackPeriodMs isn't updated until below)
+    if (previousStartTicks >= 0)
+    {
+        const auto intervalMs = timer.getElapsedMs (previousStartTicks, lapTicks);
+        windowIntervals++;
+        windowIntervalSum += intervalMs;
+        windowIntervalSquares += intervalMs * intervalMs;
+        windowMaxIntervalError = jmax (windowMaxIntervalError, std::abs (intervalMs - callbackPeriodMs));
+        if (intervalMs > callbackPeriodMs * lateFactor)
+        {
+            frame.numLateCallbacks++;
+            frame.windowLateCallbacks++;
+        }
+    }
+    previousStartTicks = lapTicks;
+
+    callbackPeriodMs = numSamples * msPerSample;
+    windowSamples += numSamples;
+    stageMs.fill (0.0);
+
+    // The device's count may not start from zero & may be reset by the driver (e.g. when it restarts), so the increments are
+    // accumulated (after a reset, the whole new count is new xruns)
+    if (deviceXrunCount >= 0)
+    {
+        if (lastDeviceXrunCount >= 0)
+        {
+            const auto newXruns = deviceXrunCount >= lastDeviceXrunCount ? deviceXrunCount - lastDeviceXrunCount : deviceXrunCount;
+            frame.deviceXruns += newXruns;
+            frame.windowXruns += newXruns;
+        }
+        else
+        {
+            frame.deviceXruns = jmax<int64> (0, frame.deviceXruns);
+        }
+    }
+    lastDeviceXrunCount = deviceXrunCount;
+}
+void CallbackLoadMeter::endStage (const Stage stage) noexcept
+{
+    const auto ticks = timer.stop();
+    stageMs[static_cast<size_t> (stage)] += timer.getElapsedMs (lapTicks, ticks);
+    lapTicks = ticks;
+}
+void CallbackLoadMeter::endCallback() noexcept
+{
+    if (callbackPeriodMs <= 0.0)
+        return;
+
+    auto totalMs = 0.0;
+    for (size_t s = 0; s < stageMs.size(); ++s)
+    {
+        windowStageMs[s] += stageMs[s];
+        windowPeakLoad[s] = jmax (windowPeakLoad[s], stageMs[s] / callbackPeriodMs);
+        totalMs += stageMs[s];
+    }
+    windowPeakTotalLoad = jmax (windowPeakTotalLoad, totalMs / callbackPeriodMs);
+    windowPeriodMs += callbackPeriodMs;
+    frame.numCallbacks++;
+    frame.windowCallbacks++;
+    if (totalMs > callbackPeriodMs)
+    {
+        frame.numDeadlineMisses++;
+        frame.windowDeadlineMisses++;
+    }
+
+    if (windowSamples >= samplesPerWindow)
+        publish();
+}
+bool CallbackLoadMeter::update()
+{
+    Frame received;
+    probe.copyFrame (&received);
+    if (received.sequence == 0 || (received.sequence == latest.sequence && received.numCallbacks == latest.numCallbacks))
+        return false;
+
+    latest = received;
+    history.add (received);
+    if (history.size() > historyLength)
+        history.removeRange (0, history.size() - historyLength);
+    return true;
+}
+const CallbackLoadMeter::Frame& CallbackLoadMeter::getLatestFrame() const noexcept
+{
+    return latest;
+}
+const Array<CallbackLoadMeter::Frame>& CallbackLoadMeter::getHistory() const noexcept
+{
+    return history;
+}
+String CallbackLoadMeter::getSummaryText() const
+{
+    const auto ms = [] (const float value) { return String (value, 2) + " ms"; };
+
+    String txt;
+    txt << latest.numCallbacks << " callbacks of " << ms (latest.callbackPeriodMs)
+        << ", jitter " << ms (latest.jitterMs) << " (max error " << ms (latest.maxIntervalErrorMs) << ")"
+        << ", load " << roundToInt (latest.averageTotalLoad * 100.0f) << "% (max " << roundToInt (latest.peakTotalLoad * 100.0f) << "%)"
+        << ", late callbacks " << latest.numLateCallbacks
+        << ", deadline misses " << latest.numDeadlineMisses
+        << ", device xruns " << (latest.deviceXruns >= 0 ? String (latest.deviceXruns) : String ("n/a"));
+    return txt;
+}
+String CallbackLoadMeter::getDiagnosisText() const
+{
+    const auto scheduling = latest.numLateCallbacks > 0 || latest.deviceXruns > 0;
+    const auto processing = latest.numDeadlineMisses > 0;
+
+    if (processing && scheduling)
+        return TRANS("Some callbacks took longer than their period to process, and the device also reported late callbacks or xruns");
+    if (processing)
+        return TRANS("Some callbacks took longer than their period to process, so glitches are likely to be caused by the processing cost");
+    if (scheduling)
+        return TRANS("The processing finished within the period, so late callbacks or xruns are likely to be caused by device/driver scheduling");
+    return TRANS("No late callbacks, deadline misses or xruns");
+}
+String CallbackLoadMeter::getStageName (const Stage stage)
+{
+    switch (stage)
+    {
+        case sources: return "Sources";
+        case processorA: return "Processor A";
+        case processorB: return "Processor B";
+        case analyser: return "Analyser";
+        case monitoring: return "Monitoring";
+        default: return {};
+    }
+}
+void CallbackLoadMeter::publish() noexcept
+{
+    auto totalMs = 0.0;
+    for (size_t s = 0; s < windowStageMs.size(); ++s)
+    {
+        frame.averageLoad[s] = static_cast<float> (windowStageMs[s] / windowPeriodMs);
+        frame.peakLoad[s] = static_cast<float> (windowPeakLoad[s]);
+        totalMs += windowStageMs[s];
+    }
+    frame.averageTotalLoad = static_cast<float> (totalMs / windowPeriodMs);
+    frame.peakTotalLoad = static_cast<float> (windowPeakTotalLoad);
+    frame.callbackPeriodMs = static_cast<float> (callbackPeriodMs);
+    if (windowIntervals > 0)
+    {
+        const auto mean = windowIntervalSum / windowIntervals;
+        frame.meanIntervalMs = static_cast<float> (mean);
+        frame.jitterMs = static_cast<float> (std::sqrt (jmax (0.0, windowIntervalSquares / windowIntervals - mean * mean)));
+        frame.maxIntervalErrorMs = static_cast<float> (windowMaxIntervalError);
+    }
+    frame.sequence++;
+    probe.writeFrame (&frame);
+
+    // Start the next window (the totals carry on)
+    windowSamples = 0;
+    windowPeriodMs = 0.0;
+    windowStageMs.fill (0.0);
+    windowPeakLoad.fill (0.0);
+    windowPeakTotalLoad = 0.0;
+    windowIntervals = 0;
+    windowIntervalSum = 0.0;
+    windowIntervalSquares = 0.0;
+    windowMaxIntervalError = 0.0;
+    frame.meanIntervalMs = 0.0f;
+    frame.jitterMs = 0.0f;
+    frame.maxIntervalErrorMs = 0.0f;
+    frame.windowCallbacks = 0;
+    frame.windowLateCallbacks = 0;
+    frame.windowDeadlineMisses = 0;
+    frame.windowXruns = 0;
+}
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    CallbackLoadMeter.h
+    Created: 19 Oct 2026 2:04:52am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AudioDataTransfer.h"
+#include "BenchmarkTimer.h"
+#include <array>
+
+/**
+ * Times each stage of the live audio callback (sources, processors, analyser & monitoring) as a fraction of the callback period,
+ * i.e. the number of samples in the block divided by the sample rate, so the load of the real device callback can be seen while
+ * listening, rather than only in the offline benchmark.
+ *
+ * The same timestamps measure the jitter of the interval between callbacks, callbacks which arrive late, callbacks whose processing
+ * took longer than their block period (deadline misses), and the xruns reported by the device. When glitches are reported, this
+ * separates device or driver scheduling problems (late callbacks & xruns without deadline misses) from our own processing cost
+ * (deadline misses).
+ *
+ * The audio thread calls beginCallback(), then endStage() after each stage (the time since the previous call is attributed to the
+ * stage), then endCallback(). Nothing on that path allocates or locks: the statistics are accumulated over a short window, then
+ * published to observers as a Frame through an AudioProbe. The observer calls update() regularly (e.g. from a GUI timer) to receive
+ * the latest frame & append it to a rolling history for display as a timeline.
+ */
+class CallbackLoadMeter
+{
+public:
+
+    enum Stage
+    {
+        sources = 0,        /**< Copying the input & generating the source signals. */
+        processorA,
+        processorB,
+        analyser,
+        monitoring,
+        numStages
+    };
+
+    /** Statistics of a window of callbacks (loads are fractions of the callback period, so 1.0 means the whole period was used),
+     *  along with totals since prepare().
+     */
+    struct Frame
+    {
+        std::array<float, numStages> averageLoad {};    /**< Time used by each stage divided by the audio time over the window. */
+        std::array<float, numStages> peakLoad {};       /**< Highest load of each stage in a single callback of the window. */
+        float averageTotalLoad = 0.0f;
+        float peakTotalLoad = 0.0f;                     /**< Highest load of all of the stages together in a single callback. */
+        float callbackPeriodMs = 0.0f;                  /**< Period of the most recent callback. */
+
+        float meanIntervalMs = 0.0f;                    /**< Mean interval between the start of consecutive callbacks in the window. */
+        float jitterMs = 0.0f;                          /**< Standard deviation of the interval between callbacks in the window. */
+        float maxIntervalErrorMs = 0.0f;                /**< Largest difference between an interval & the period of the preceding block. */
+        int windowCallbacks = 0;
+        int windowLateCallbacks = 0;
+        int windowDeadlineMisses = 0;
+        int windowXruns = 0;
+
+        int64 sequence = 0;                             /**< Number of windows published since prepare() (0 until the first is published). */
+        int64 numCallbacks = 0;                         /**< Total since prepare(). */
+        int64 numLateCallbacks = 0;                     /**< Total since prepare(). */
+        int64 numDeadlineMisses = 0;                    /**< Total since prepare(). */
+        int64 deviceXruns = -1;                         /**< Xruns reported by the device since prepare() (-1 if the device doesn't report them). */
+    };
+
+    /** Length of audio over which the statistics are accumulated before each frame is published. */
+    static constexpr double windowSeconds = 0.1;
+
+    /** A callback is late if the interval since the previous one is longer than this factor of the previous block's period. */
+    static constexpr double lateFactor = 1.5;
+
+    /** Number of frames kept in the history (i.e. a minute). */
+    static constexpr int historyLength = 600;
+
+    CallbackLoadMeter() = default;
+
+    /** Call this before the callbacks start (e.g. from prepareToPlay()). */
+    void prepare (const double sampleRate);
+
+    /** Call this at the start of each callback, with the xrun count reported by the device (-1 if it doesn't report them). */
+    void beginCallback (const int numSamples, const int deviceXrunCount) noexcept;
+
+    /** Attributes the time since the previous call (or beginCallback()) to a stage. */
+    void endStage (const Stage stage) noexcept;
+
+    /** Call this at the end of each callback. */
+    void endCallback() noexcept;
+
+    /** Receives any newly published frame & appends it to the history (call this regularly from the observer, not the audio
+     *  thread). Returns true if a frame was received.
+     */
+    bool update();
+
+    /** Returns the most recent frame received by update(). */
+    [[nodiscard]] const Frame& getLatestFrame() const noexcept;
+
+    /** Returns the history of frames (oldest first, updated by update()). */
+    [[nodiscard]] const Array<Frame>& getHistory() const noexcept;
+
+    /** Returns a summary of the totals & the latest window (e.g. "4096 callbacks of 5.33 ms, jitter 0.04 ms (max error 1.20 ms), ..."). */
+    [[nodiscard]] String getSummaryText() const;
+
+    /** Returns a hint as to whether any glitches were caused by device/driver scheduling or by the processing cost. */
+    [[nodiscard]] String getDiagnosisText() const;
+
+    static String getStageName (const Stage stage);
+
+private:
+
+    void publish() noexcept;
+
+    // Audio thread
+    BenchmarkTimer timer;
+    AudioProbe<Frame> probe;
+    double msPerSample = 0.0;
+    int samplesPerWindow = 0;
+
+    // Current callback
+    int64 lapTicks = 0;
+    int64 previousStartTicks = -1;
+    double callbackPeriodMs = 0.0;
+    std::array<double, numStages> stageMs {};
+    int lastDeviceXrunCount = -1;
+
+    // Current window
+    int windowSamples = 0;
+    double windowPeriodMs = 0.0;
+    std::array<double, numStages> windowStageMs {};
+    std::array<double, numStages> windowPeakLoad {};
+    double windowPeakTotalLoad = 0.0;
+    int windowIntervals = 0;
+    double windowIntervalSum = 0.0;
+    double windowIntervalSquares = 0.0;
+    double windowMaxIntervalError = 0.0;
+
+    Frame frame {};
+
+    // Observer
+    Frame latest {};
+    Array<Frame> history;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackLoadMeter)
+};
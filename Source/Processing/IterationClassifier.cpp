@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    IterationClassifier.cpp
+    Created: 19 Oct 2026 3:02:11am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "IterationClassifier.h"
+
+void IterationClassifier::setWarmup (const int numCalls) noexcept
+{
+    jassert (numCalls >= autoWarmup);
+    warmup = jmax (autoWarmup, numCalls);
+}
+int IterationClassifier::getWarmup() const noexcept
+{
+    return warmup;
+}
+void IterationClassifier::setOutlierFactor (const double factor) noexcept
+{
+    jassert (factor > 1.0);
+    outlierFactor = jmax (1.0, factor);
+}
+double IterationClassifier::getOutlierFactor() const noexcept
+{
+    return outlierFactor;
+}
+bool IterationClassifier::isWarmingUp() const noexcept
+{
+    return warmingUp;
+}
+void IterationClassifier::reset() noexcept
+{
+    warmupStatistics = {};
+    numOutliers = 0;
+    numCycles = 0;
+    callInCycle = 0;
+    warmingUp = false;
+}
+void IterationClassifier::startCycle() noexcept
+{
+    numCycles++;
+    callInCycle = 0;
+    warmingUp = warmup != 0;
+    stableCalls = 0;
+    fastestCallMs = std::numeric_limits<double>::max();
+}
+bool IterationClassifier::classify (const double durationMs, const double referenceMs) noexcept
+{
+    const auto call = callInCycle++;
+    if (warmingUp)
+    {
+        if (call == 0)
+        {
+            warmupStatistics.numCycles++;
+            warmupStatistics.firstCallSum += durationMs;
+            warmupStatistics.firstCallMax = jmax (warmupStatistics.firstCallMax, durationMs);
+        }
+        warmupStatistics.numCalls++;
+        warmupStatistics.durationSum += durationMs;
+        warmupStatistics.durationMax = jmax (warmupStatistics.durationMax, durationMs);
+
+        if (warmup == autoWarmup)
+        {
+            fastestCallMs = jmin (fastestCallMs, durationMs);
+            stableCalls = durationMs <= fastestCallMs * autoWarmupTolerance ? stableCalls + 1 : 0;
+            warmingUp = stableCalls < autoWarmupStableCalls && call + 1 < maxAutoWarmupCalls;
+        }
+        else
+        {
+            warmingUp = call + 1 < warmup;
+        }
+        return true;
+    }
+
+    if (std::isfinite (referenceMs) && durationMs > referenceMs * outlierFactor)
+    {
+        if (numOutliers < maxOutliers)
+            outliers[static_cast<size_t> (numOutliers)] = { numCycles - 1, static_cast<int64> (call), durationMs };
+        numOutliers++;
+    }
+    return false;
+}
+const IterationClassifier::WarmupStatistics& IterationClassifier::getWarmupStatistics() const noexcept
+{
+    return warmupStatistics;
+}
+int IterationClassifier::getNumOutliers (const double medianMs) const noexcept
+{
+    auto count = 0;
+    for (auto i = 0; i < getNumRecorded(); ++i)
+        if (isOutlier (outliers[static_cast<size_t> (i)], medianMs))
+            count++;
+    return count;
+}
+IterationClassifier::Outlier IterationClassifier::getOutlier (const int index, const double medianMs) const noexcept
+{
+    auto count = 0;
+    for (auto i = 0; i < getNumRecorded(); ++i)
+        if (isOutlier (outliers[static_cast<size_t> (i)], medianMs) && count++ == index)
+            return outliers[static_cast<size_t> (i)];
+    jassertfalse;
+    return {};
+}
+int64 IterationClassifier::getNumOutliersNotRecorded() const noexcept
+{
+    return jmax (static_cast<int64> (0), numOutliers - maxOutliers);
+}
+int64 IterationClassifier::getOutlierPeriod (const double medianMs) const noexcept
+{
+    // One pass over the recorded candidates, taking the interval from each outlier to the previous one in the same cycle
+    std::array<int64, maxOutliers> intervals {};
+    auto numIntervals = 0;
+    const Outlier* previous = nullptr;
+    for (auto i = 0; i < getNumRecorded(); ++i)
+    {
+        const auto& current = outliers[static_cast<size_t> (i)];
+        if (!isOutlier (current, medianMs))
+            continue;
+        if (previous != nullptr && current.cycle == previous->cycle)
+            intervals[static_cast<size_t> (numIntervals++)] = current.call - previous->call;
+        previous = &current;
+    }
+    if (numIntervals < 2)
+        return 0;
+
+    // Find the interval with the most other intervals within one call of it
+    int64 bestInterval = 0;
+    auto bestCount = 0;
+    for (auto i = 0; i < numIntervals; ++i)
+    {
+        auto count = 0;
+        for (auto j = 0; j < numIntervals; ++j)
+            if (std::abs (intervals[static_cast<size_t> (j)] - intervals[static_cast<size_t> (i)]) <= 1)
+                count++;
+        if (count > bestCount)
+        {
+            bestCount = count;
+            bestInterval = intervals[static_cast<size_t> (i)];
+        }
+    }
+    return bestCount * 4 >= numIntervals * 3 ? bestInterval : 0;
+}
+String IterationClassifier::getSummaryText (const double medianMs) const
+{
+    constexpr auto maxListed = 8;
+    const auto us = [] (const double ms) { return String (ms * 1000.0, 1) + " us"; };
+
+    StringArray parts;
+    if (warmupStatistics.numCalls > 0.0)
+        parts.add ("Warm-up " + String (warmupStatistics.getCallsPerCycle(), 1) + " calls" + (warmup == autoWarmup ? " (auto)" : "")
+                   + ", first call " + us (warmupStatistics.getFirstCallAverage()) + " (max " + us (warmupStatistics.firstCallMax) + ")"
+                   + ", avg " + us (warmupStatistics.getAverage()));
+
+    const auto num = getNumOutliers (medianMs);
+    if (num > 0)
+    {
+        String txt;
+        txt << num << (getNumOutliersNotRecorded() > 0 ? "+" : "") << " outliers (> " << String (outlierFactor, 1).trimCharactersAtEnd ("0").trimCharactersAtEnd (".")
+            << "x median) at cycle:call";
+        auto numListed = 0;
+        for (auto i = 0; i < getNumRecorded() && numListed < maxListed; ++i)
+        {
+            const auto& o = outliers[static_cast<size_t> (i)];
+            if (isOutlier (o, medianMs))
+                txt << (numListed++ > 0 ? ", " : " ") << o.cycle << ":" << o.call;
+        }
+        if (num > maxListed)
+            txt << ", ...";
+        if (const auto period = getOutlierPeriod (medianMs))
+            txt << ", every " << period << " calls";
+        parts.add (txt);
+    }
+    return parts.joinIntoString ("; ");
+}
+int IterationClassifier::getNumRecorded() const noexcept
+{
+    return static_cast<int> (jmin (numOutliers, static_cast<int64> (maxOutliers)));
+}
+bool IterationClassifier::isOutlier (const Outlier& outlier, const double medianMs) const noexcept
+{
+    return !std::isfinite (medianMs) || outlier.durationMs > medianMs * outlierFactor;
+}
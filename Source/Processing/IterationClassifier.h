@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    IterationClassifier.h
+    Created: 19 Oct 2026 1:41:18am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+
+/**
+ * Separates the warm-up calls of process() after each prepare() (cold caches, branch predictors, lazily allocated or first touched
+ * memory) from the steady state, and records steady state calls which are outliers (much slower than the median), along with
+ * where they happened, so that first call costs & periodic spikes can be told apart from the typical cost.
+ *
+ * The warm-up is either a fixed number of calls, or detected automatically as ending once a run of consecutive calls are all close
+ * to the fastest call so far. Nothing here allocates or locks, so it can be used on the benchmark thread between timed calls.
+ */
+class IterationClassifier
+{
+public:
+
+    /** Warm-up setting which detects the end of the warm-up automatically. */
+    static constexpr int autoWarmup = -1;
+
+    /** Number of consecutive calls within autoWarmupTolerance of the fastest call which end an automatic warm-up. */
+    static constexpr int autoWarmupStableCalls = 8;
+
+    /** Factor of the fastest call so far within which a call is considered to be warmed up. */
+    static constexpr double autoWarmupTolerance = 1.2;
+
+    /** Maximum length of an automatic warm-up (for processors whose time never settles). */
+    static constexpr int maxAutoWarmupCalls = 256;
+
+    /** Calls slower than this factor of the median are outliers by default. */
+    static constexpr double defaultOutlierFactor = 10.0;
+
+    /** Maximum number of outliers recorded (any further outliers are only counted). */
+    static constexpr int maxOutliers = 256;
+
+    /** A steady state call which was slower than the outlier factor times the reference duration at the time. */
+    struct Outlier
+    {
+        int64 cycle = 0;            /**< Index of the prepare() call preceding this call (since the statistics were reset). */
+        int64 call = 0;             /**< Index of the call since that prepare() call (including the warm-up calls). */
+        double durationMs = 0.0;
+    };
+
+    /** Durations of the warm-up calls. */
+    struct WarmupStatistics
+    {
+        double numCycles = 0.0;     /**< Number of warm-ups (i.e. prepare() calls followed by at least one process call). */
+        double numCalls = 0.0;
+        double durationSum = 0.0;
+        double durationMax = 0.0;
+        double firstCallSum = 0.0;  /**< Sum of the durations of the first call after each prepare(). */
+        double firstCallMax = 0.0;
+
+        /** Returns the average number of warm-up calls after each prepare(). */
+        [[nodiscard]] double getCallsPerCycle() const noexcept
+        {
+            return numCycles > 0.0 ? numCalls / numCycles : 0.0;
+        }
+
+        [[nodiscard]] double getAverage() const noexcept
+        {
+            return numCalls > 0.0 ? durationSum / numCalls : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        [[nodiscard]] double getFirstCallAverage() const noexcept
+        {
+            return numCycles > 0.0 ? firstCallSum / numCycles : std::numeric_limits<double>::quiet_NaN();
+        }
+    };
+
+    IterationClassifier() = default;
+
+    /** Set the number of warm-up calls after each prepare() (0 for none, or autoWarmup to detect it). */
+    void setWarmup (const int numCalls) noexcept;
+
+    [[nodiscard]] int getWarmup() const noexcept;
+
+    /** Set the factor of the median above which a steady state call is an outlier. */
+    void setOutlierFactor (const double factor) noexcept;
+
+    [[nodiscard]] double getOutlierFactor() const noexcept;
+
+    /** Returns true if the calls are still part of the warm-up after the last prepare(). */
+    [[nodiscard]] bool isWarmingUp() const noexcept;
+
+    /** Clears the warm-up statistics & outliers (but not the settings). */
+    void reset() noexcept;
+
+    /** Starts a new warm-up (call this after each prepare()). */
+    void startCycle() noexcept;
+
+    /** Classifies a process call, returning true if it is part of the warm-up, in which case it is recorded here & should be left
+     *  out of the steady state statistics. Steady state calls slower than the outlier factor times the reference duration (e.g.
+     *  the median so far) are recorded as outlier candidates, which getNumOutliers() filters against the final median.
+     */
+    bool classify (const double durationMs, const double referenceMs) noexcept;
+
+    [[nodiscard]] const WarmupStatistics& getWarmupStatistics() const noexcept;
+
+    /** Returns the number of recorded outliers which are slower than the outlier factor times the median (the candidates were
+     *  compared against the median at the time, which settles as the run goes on). Use getOutlier() to get each of them.
+     */
+    [[nodiscard]] int getNumOutliers (const double medianMs) const noexcept;
+
+    /** Returns the nth outlier slower than the outlier factor times the median (in the order they happened). */
+    [[nodiscard]] Outlier getOutlier (const int index, const double medianMs) const noexcept;
+
+    /** Returns the number of outlier candidates which weren't recorded because the list was full. */
+    [[nodiscard]] int64 getNumOutliersNotRecorded() const noexcept;
+
+    /** Returns the number of calls between outliers if they are periodic (at least 3 outliers within a cycle, with 3/4 of the
+     *  intervals between them within one call of the most common interval), or 0 if they aren't.
+     */
+    [[nodiscard]] int64 getOutlierPeriod (const double medianMs) const noexcept;
+
+    /** Returns a summary of the warm-up & outliers (e.g. "Warm-up 8.0 calls, first call 120.3 us ... 3 outliers (> 10x median)
+     *  at cycle:call 0:515, 1:515, 2:515, every 512 calls"), or an empty string if there was no warm-up & there are no outliers.
+     */
+    [[nodiscard]] String getSummaryText (const double medianMs) const;
+
+private:
+
+    [[nodiscard]] int getNumRecorded() const noexcept;
+    [[nodiscard]] bool isOutlier (const Outlier& outlier, const double medianMs) const noexcept;
+
+    int warmup = 0;
+    double outlierFactor = defaultOutlierFactor;
+
+    WarmupStatistics warmupStatistics {};
+    std::array<Outlier, maxOutliers> outliers {};
+    int64 numOutliers = 0;
+    int64 numCycles = 0;
+    int callInCycle = 0;
+    bool warmingUp = false;
+    int stableCalls = 0;
+    double fastestCallMs = 0.0;
+};
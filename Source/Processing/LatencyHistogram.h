@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    LatencyHistogram.h
+    Created: 18 Oct 2026 11:20:52am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+
+/**
+ * Fixed memory histogram of durations with logarithmically spaced buckets.
+ *
+ * Each octave (from 1ns upwards) is split into 64 buckets, so percentiles are resolved to within about 1%.
+ * Recording a duration doesn't allocate or lock, so this can be left running on the audio thread.
+ */
+class LatencyHistogram
+{
+public:
+
+    LatencyHistogram()
+    {
+        reset();
+    }
+
+    /** Clears all recorded durations. */
+    void reset() noexcept
+    {
+        counts.fill (0);
+        numSamples = 0;
+    }
+
+    /** Records a duration (in milliseconds). */
+    void record (const double durationMs) noexcept
+    {
+        counts[static_cast<size_t> (getBucketIndex (durationMs * nanosecondsPerMs))]++;
+        numSamples++;
+    }
+
+    /** Returns the number of durations recorded since the last reset. */
+    [[nodiscard]] uint64 getNumSamples() const noexcept
+    {
+        return numSamples;
+    }
+
+    /** Returns the duration (in milliseconds) at or below which the given percentage (0..100) of the
+     *  recorded durations fall, or NaN if nothing has been recorded.
+     */
+    [[nodiscard]] double getPercentile (const double percentile) const noexcept
+    {
+        if (numSamples == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        const auto rank = jmax (static_cast<uint64> (1), static_cast<uint64> (std::ceil (jlimit (0.0, 100.0, percentile) * 0.01 * static_cast<double> (numSamples))));
+        uint64 cumulative = 0;
+        for (auto i = 0; i < numBuckets; ++i)
+        {
+            cumulative += counts[static_cast<size_t> (i)];
+            if (cumulative >= rank)
+                return getBucketMidpoint (i) / nanosecondsPerMs;
+        }
+        return getBucketMidpoint (numBuckets - 1) / nanosecondsPerMs;
+    }
+
+private:
+
+    static constexpr int bucketsPerOctave = 64;
+    static constexpr int numOctaves = 44; // 1ns up to about 4.9 hours
+    static constexpr int numBuckets = bucketsPerOctave * numOctaves;
+    static constexpr double nanosecondsPerMs = 1.0E6;
+
+    static int getBucketIndex (const double nanoseconds) noexcept
+    {
+        if (!(nanoseconds >= 1.0)) // also catches NaN
+            return 0;
+
+        // nanoseconds = mantissa * 2^exponent, where mantissa is in the range [0.5, 1)
+        auto exponent = 0;
+        const auto mantissa = std::frexp (nanoseconds, &exponent);
+        const auto octave = exponent - 1;
+        const auto subBucket = static_cast<int> ((mantissa * 2.0 - 1.0) * bucketsPerOctave);
+        return jmin (octave * bucketsPerOctave + subBucket, numBuckets - 1);
+    }
+
+    static double getBucketMidpoint (const int index) noexcept
+    {
+        const auto octave = index / bucketsPerOctave;
+        const auto subBucket = index % bucketsPerOctave;
+        return std::ldexp (1.0 + (subBucket + 0.5) / bucketsPerOctave, octave);
+    }
+
+    std::array<uint64, numBuckets> counts {};
+    uint64 numSamples = 0;
+};
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    PerformanceCounters.cpp
+    Created: 18 Oct 2026 3:05:33pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "PerformanceCounters.h"
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #include <cerrno>
+ #include <cstring>
+
+namespace
+{
+    int openPerfEvent (const uint32 type, const uint64 config, const int groupFd)
+    {
+        perf_event_attr attr;
+        std::memset (&attr, 0, sizeof (attr));
+        attr.size = sizeof (attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = groupFd == -1 ? 1 : 0; // the group is enabled & disabled via the leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Count the calling thread on any CPU
+        return static_cast<int> (syscall (__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+
+    uint64 getHardwareCacheConfig (const uint64 cache, const uint64 op, const uint64 result)
+    {
+        return cache | (op << 8) | (result << 16);
+    }
+}
+#endif
+
+PerformanceCounters::~PerformanceCounters()
+{
+    close();
+}
+bool PerformanceCounters::isSupported()
+{
+   #if JUCE_LINUX
+    return true;
+   #else
+    return false;
+   #endif
+}
+bool PerformanceCounters::open()
+{
+    close();
+    lastError.clear();
+
+   #if JUCE_LINUX
+    struct EventConfig { Counter counter; uint32 type; uint64 config; };
+    const EventConfig events[] = {
+        { cycles,           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { instructions,     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { l1dReadMisses,    PERF_TYPE_HW_CACHE, getHardwareCacheConfig (PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+        { llcMisses,        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { branchMisses,     PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+    };
+
+    StringArray missingCounters;
+    String reason;
+    for (const auto& e : events)
+    {
+        const auto fd = openPerfEvent (e.type, e.config, leaderFd);
+        if (fd < 0)
+        {
+            // Keep going without this counter if it isn't supported (e.g. some VMs don't expose cache events)
+            if (reason.isEmpty())
+            {
+                const auto error = errno;
+                reason = String (std::strerror (error));
+                if (error == EACCES || error == EPERM)
+                    reason += " (check /proc/sys/kernel/perf_event_paranoid)";
+            }
+            missingCounters.add (getCounterName (e.counter));
+            continue;
+        }
+        if (leaderFd == -1)
+            leaderFd = fd;
+        fileDescriptors[e.counter] = fd;
+        groupIndices[e.counter] = numOpenCounters++;
+    }
+
+    // The error is kept when only some of the counters opened, so the missing ones can be reported
+    if (!missingCounters.isEmpty())
+        lastError = "Unable to open the " + missingCounters.joinIntoString (", ") + (missingCounters.size() > 1 ? " counters: " : " counter: ") + reason;
+    return numOpenCounters > 0;
+   #else
+    lastError = "Performance counters are only supported on Linux";
+    return false;
+   #endif
+}
+void PerformanceCounters::close()
+{
+   #if JUCE_LINUX
+    // Close the group members before the leader
+    for (auto c = static_cast<int> (numCounters) - 1; c >= 0; --c)
+        if (fileDescriptors[static_cast<size_t> (c)] >= 0)
+            ::close (fileDescriptors[static_cast<size_t> (c)]);
+   #endif
+    fileDescriptors.fill (-1);
+    groupIndices.fill (-1);
+    numOpenCounters = 0;
+    leaderFd = -1;
+}
+bool PerformanceCounters::isOpen() const noexcept
+{
+    return numOpenCounters > 0;
+}
+void PerformanceCounters::start() noexcept
+{
+   #if JUCE_LINUX
+    if (!isOpen())
+        return;
+    ioctl (leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl (leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   #endif
+}
+void PerformanceCounters::pause() noexcept
+{
+   #if JUCE_LINUX
+    if (isOpen())
+        ioctl (leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+   #endif
+}
+void PerformanceCounters::resume() noexcept
+{
+   #if JUCE_LINUX
+    if (isOpen())
+        ioctl (leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   #endif
+}
+void PerformanceCounters::stop (Totals& totals) noexcept
+{
+   #if JUCE_LINUX
+    if (!isOpen())
+        return;
+    ioctl (leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Layout for PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+    struct { uint64 nr; uint64 timeEnabled; uint64 timeRunning; uint64 values[numCounters]; } data {};
+    if (read (leaderFd, &data, sizeof (data)) <= 0 || data.timeRunning == 0)
+        return;
+
+    // Scale up if the counters were multiplexed with other events
+    const auto scale = static_cast<double> (data.timeEnabled) / static_cast<double> (data.timeRunning);
+    for (auto c = 0; c < numCounters; ++c)
+    {
+        const auto idx = groupIndices[static_cast<size_t> (c)];
+        if (idx >= 0 && static_cast<uint64> (idx) < data.nr)
+        {
+            totals.counts[static_cast<size_t> (c)] += static_cast<double> (data.values[idx]) * scale;
+            totals.available[static_cast<size_t> (c)] = true;
+        }
+    }
+   #else
+    ignoreUnused (totals);
+   #endif
+}
+String PerformanceCounters::getLastError() const
+{
+    return lastError;
+}
+String PerformanceCounters::getCounterName (const Counter counter)
+{
+    switch (counter)
+    {
+        case cycles:        return "Cycles";
+        case instructions:  return "Instructions";
+        case l1dReadMisses: return "L1D read misses";
+        case llcMisses:     return "LLC misses";
+        case branchMisses:  return "Branch misses";
+        case numCounters:
+        default:            return {};
+    }
+}
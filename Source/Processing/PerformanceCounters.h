@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    PerformanceCounters.h
+    Created: 18 Oct 2026 3:05:33pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+
+/**
+ * Group of hardware performance counters for the calling thread (Linux only, using perf_event_open).
+ *
+ * The counters are only counted between start() and stop(), and are only read in stop(), so a whole batch of
+ * process calls can be measured with a single read. Counting can be paused & resumed within the batch to leave out
+ * the work between the calls. Counts are scaled if the kernel had to multiplex the counters.
+ */
+class PerformanceCounters
+{
+public:
+
+    enum Counter
+    {
+        cycles = 0,
+        instructions,
+        l1dReadMisses,
+        llcMisses,
+        branchMisses,
+        numCounters
+    };
+
+    /** Accumulated counts, along with the number of samples processed while counting (i.e. the block length, not multiplied by the number of channels). */
+    struct Totals
+    {
+        std::array<double, numCounters> counts {};
+        std::array<bool, numCounters> available {};
+        double numSamples = 0.0;    /**< Samples processed while counting, summed over all channels. */
+
+        void reset() noexcept
+        {
+            counts.fill (0.0);
+            available.fill (false);
+            numSamples = 0.0;
+        }
+
+        /** Returns the count per sample per channel (like the other costs per sample), or NaN if the counter wasn't available. */
+        [[nodiscard]] double getPerSample (const Counter counter) const noexcept
+        {
+            if (!available[counter] || numSamples <= 0.0)
+                return std::numeric_limits<double>::quiet_NaN();
+            return counts[counter] / numSamples;
+        }
+
+        /** Returns instructions per cycle, or NaN if either counter wasn't available. */
+        [[nodiscard]] double getInstructionsPerCycle() const noexcept
+        {
+            if (!available[cycles] || !available[instructions] || counts[cycles] <= 0.0)
+                return std::numeric_limits<double>::quiet_NaN();
+            return counts[instructions] / counts[cycles];
+        }
+    };
+
+    PerformanceCounters() = default;
+    ~PerformanceCounters();
+
+    /** Returns true if performance counters are supported on this platform (they may still fail to open, e.g. due to permissions). */
+    static bool isSupported();
+
+    /** Opens the counter group for the calling thread. Any counters which aren't supported by the CPU are skipped, in which
+     *  case getLastError() lists them. Returns false if none of the counters could be opened.
+     */
+    bool open();
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const noexcept;
+
+    /** Resets & enables the counters. */
+    void start() noexcept;
+
+    /** Disables the counters without reading them (use resume() to carry on counting). */
+    void pause() noexcept;
+
+    /** Enables the counters again after pause(), keeping the counts so far. */
+    void resume() noexcept;
+
+    /** Disables the counters and adds the counts since start() to the totals. */
+    void stop (Totals& totals) noexcept;
+
+    /** Returns why the counters (or some of them) couldn't be opened, or an empty string if they all were. */
+    [[nodiscard]] String getLastError() const;
+
+    static String getCounterName (const Counter counter);
+
+private:
+
+    std::array<int, numCounters> fileDescriptors { -1, -1, -1, -1, -1 };
+    std::array<int, numCounters> groupIndices { -1, -1, -1, -1, -1 };
+    int numOpenCounters = 0;
+    int leaderFd = -1;
+    String lastError {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PerformanceCounters)
+};
@@ -26,8 +26,12 @@ void LpfExample::process (const dsp::ProcessContextReplacing<float>& context)
 {
     jassert (context.getInputBlock().getNumChannels() == context.getOutputBlock().getNumChannels());
 
-    calculateCoefficients();
+    {
+        DSP_TESTBENCH_SECTION ("coefficients");
+        calculateCoefficients();
+    }
 
+    DSP_TESTBENCH_SECTION ("filter");
     for (size_t ch = 0; ch <context.getOutputBlock().getNumChannels(); ++ch)
     {
         auto* in = context.getInputBlock().getChannelPointer (ch);
@@ -68,6 +72,10 @@ double LpfExample::getDefaultControlValue (const int index)
         default: return 0.0;
     }
 }
+std::unique_ptr<ProcessorHarness> LpfExample::createInstance()
+{
+    return std::make_unique<LpfExample>();
+}
 void LpfExample::init()
 {
     a0 = 1.0;
@@ -120,4 +128,8 @@ String ThruExample::getControlName (const int /*index*/)
 double ThruExample::getDefaultControlValue (const int /*index*/)
 {
     return 0.0;
+}
+std::unique_ptr<ProcessorHarness> ThruExample::createInstance()
+{
+    return std::make_unique<ThruExample>();
 }
\ No newline at end of file
@@ -10,11 +10,21 @@
 
 #include "ProcessorHarness.h"
 
+namespace
+{
+    /** Number of steady state process calls before the median is first estimated as the reference for outliers. */
+    constexpr int64 minCallsForOutlierReference = 16;
+
+    /** Number of steady state process calls between updates of the outlier reference (reading the median scans the histogram). */
+    constexpr int64 outlierReferenceInterval = 256;
+}
+
 ProcessorHarness::ProcessorHarness (const int numberOfControlValues)
     : currentSpec ()
 {
     for (auto i = 0; i < numberOfControlValues; ++i)
         controlValues.emplace_back (0.0f);
+    sectionProfiler.setTimer (&timer);
 }
 void ProcessorHarness::prepareHarness (const dsp::ProcessSpec& spec)
 {
@@ -24,52 +34,195 @@ void ProcessorHarness::prepareHarness (const dsp::ProcessSpec& spec)
     if ( numChannelsAreDifferent || sampleRatesAreDifferent || blockSizesAreDifferent)
     {
         // Reset process duration statistics as these will not be valid if the spec has changed
-        procDurationMin = 0.0;
-        procDurationMax = 0.0;
-        procDurationSum = 0.0;
-        procDurationCount = 0.0;
+        resetProcessStatistics();
     }
     currentSpec = spec;
+    msPerSample = spec.sampleRate > 0.0 ? 1000.0 / spec.sampleRate : 0.0;
 
-    const auto start = Time::getMillisecondCounterHiRes();
+    const auto sampleUsage = resourceUsageEnabled.get();
+    const auto usageBefore = sampleUsage ? ResourceUsage::sample() : ResourceUsage::Sample();
+    const auto start = timer.start();
 
 // =====================
     prepare (spec);
 // =====================
 
-    const auto duration = Time::getMillisecondCounterHiRes() - start;
+    const auto duration = timer.getElapsedMs (start, timer.stop());
+    if (sampleUsage)
+        prepUsage.add (usageBefore, ResourceUsage::sample());
+    iterationClassifier.startCycle();
     if (duration<prepDurationMin) prepDurationMin = duration;
     if (duration>prepDurationMax) prepDurationMax = duration;
     prepDurationSum += duration;
     prepDurationCount++;
+    prepDurationHistogram.record (duration);
 }
 void ProcessorHarness::processHarness (const dsp::ProcessContextReplacing<float>& context)
 {
-    const auto start = Time::getMillisecondCounterHiRes();
-    
+    // The resource usage is sampled outside of the timed region (a system call either side of each call)
+    const auto sampleUsage = resourceUsageEnabled.get();
+    const auto usageBefore = sampleUsage ? ResourceUsage::sample() : ResourceUsage::Sample();
+    const auto profileSections = sectionProfilingEnabled.get();
+    auto duration = 0.0;
+    {
+        // The guard is armed outside of the timed region (and does nothing if it isn't enabled)
+        const RealtimeGuard::ScopedGuard guard (realtimeGuardEnabled.get() ? &procViolations : nullptr);
+        if (profileSections)
+            sectionProfiler.beginCall();
+
+        // The counters (see processHarnessWithCounters()) only count the process call, not the harness around it
+        if (activeCounters != nullptr)
+            activeCounters->resume();
+        const auto start = timer.start();
+
 // =====================
-    process (context);
+        process (context);
 // =====================
 
-    const auto duration = Time::getMillisecondCounterHiRes() - start;
+        const auto stop = timer.stop();
+        if (activeCounters != nullptr)
+            activeCounters->pause();
+        duration = timer.getElapsedMs (start, stop);
+        if (profileSections)
+            sectionProfiler.endCall();
+    }
+    if (sampleUsage)
+        procUsage.add (usageBefore, ResourceUsage::sample());
+    procDurationLast = duration;
+
+    // Warm-up calls are kept out of the steady state statistics
+    const auto isWarmup = iterationClassifier.classify (duration, outlierReferenceMs);
+    if (profileSections)
+        sectionProfiler.commitCall (!isWarmup);
+    if (isWarmup)
+        return;
+
     if (duration<procDurationMin) procDurationMin = duration;
     if (duration>procDurationMax) procDurationMax = duration;
     procDurationSum += duration;
     procDurationCount++;
+    procDurationHistogram.record (duration);
+    if (duration > static_cast<double> (context.getOutputBlock().getNumSamples()) * msPerSample)
+        procDeadlineMisses++;
+
+    const auto count = static_cast<int64> (procDurationCount);
+    if (count == minCallsForOutlierReference || count % outlierReferenceInterval == 0)
+        outlierReferenceMs = procDurationHistogram.getPercentile (50.0);
+}
+void ProcessorHarness::processHarnessWithCounters (const dsp::ProcessContextReplacing<float>& context, const int numIterations, PerformanceCounters& counters)
+{
+    counters.start();
+    counters.pause();
+    activeCounters = &counters;
+    for (auto i = 0; i < numIterations; ++i)
+        processHarness (context);
+    activeCounters = nullptr;
+    counters.stop (procCounterTotals);
+    const auto& block = context.getOutputBlock();
+    procCounterTotals.numSamples += static_cast<double> (numIterations) * static_cast<double> (block.getNumSamples() * block.getNumChannels());
 }
 void ProcessorHarness::resetHarness ()
 {
-    const auto start = Time::getMillisecondCounterHiRes();
+    const auto sampleUsage = resourceUsageEnabled.get();
+    const auto usageBefore = sampleUsage ? ResourceUsage::sample() : ResourceUsage::Sample();
+    auto duration = 0.0;
+    {
+        const RealtimeGuard::ScopedGuard guard (realtimeGuardEnabled.get() ? &resetViolations : nullptr);
+        const auto start = timer.start();
 
 // =====================
-    reset();
+        reset();
 // =====================
 
-    const auto duration = Time::getMillisecondCounterHiRes() - start;
+        duration = timer.getElapsedMs (start, timer.stop());
+    }
+    if (sampleUsage)
+        resetUsage.add (usageBefore, ResourceUsage::sample());
     if (duration<resetDurationMin) resetDurationMin = duration;
     if (duration>resetDurationMax) resetDurationMax = duration;
     resetDurationSum += duration;
     resetDurationCount++;
+    resetDurationHistogram.record (duration);
+}
+void ProcessorHarness::setRealtimeGuardEnabled (const bool shouldBeEnabled, const bool captureStackTraces)
+{
+    procViolations.captureStackTraces = captureStackTraces;
+    resetViolations.captureStackTraces = captureStackTraces;
+    // Violations still held from an earlier time the guard was enabled are cleared by the next resetStatistics(), so leave them out
+    previousViolations = -(procViolations.getTotal() + resetViolations.getTotal());
+    realtimeGuardEnabled = shouldBeEnabled;
+}
+bool ProcessorHarness::isRealtimeGuardEnabled() const
+{
+    return realtimeGuardEnabled.get();
+}
+const RealtimeGuard::Violations* ProcessorHarness::getRealtimeViolations (const int routineIndex) const
+{
+    jassert (routineIndex >= 0 && routineIndex < 3);
+    if (!realtimeGuardEnabled.get())
+        return nullptr;
+    if (routineIndex == 1)
+        return &procViolations;
+    if (routineIndex == 2)
+        return &resetViolations;
+    return nullptr;
+}
+int64 ProcessorHarness::getRealtimeViolationsSinceEnabled() const
+{
+    if (!realtimeGuardEnabled.get())
+        return 0;
+    return previousViolations + procViolations.getTotal() + resetViolations.getTotal();
+}
+void ProcessorHarness::mergeRealtimeViolations (const ProcessorHarness& other)
+{
+    previousViolations += other.getRealtimeViolationsSinceEnabled();
+}
+void ProcessorHarness::setResourceUsageEnabled (const bool shouldBeEnabled)
+{
+    resourceUsageEnabled = shouldBeEnabled;
+}
+bool ProcessorHarness::isResourceUsageEnabled() const
+{
+    return resourceUsageEnabled.get();
+}
+const ResourceUsage::Totals* ProcessorHarness::getResourceUsage (const int routineIndex) const
+{
+    jassert (routineIndex >= 0 && routineIndex < 3);
+    if (!resourceUsageEnabled.get())
+        return nullptr;
+    if (routineIndex == 0)
+        return &prepUsage;
+    if (routineIndex == 1)
+        return &procUsage;
+    return &resetUsage;
+}
+void ProcessorHarness::setWarmup (const int numCalls)
+{
+    iterationClassifier.setWarmup (numCalls);
+}
+void ProcessorHarness::setOutlierFactor (const double factor)
+{
+    iterationClassifier.setOutlierFactor (factor);
+}
+const IterationClassifier& ProcessorHarness::getIterationClassifier() const
+{
+    return iterationClassifier;
+}
+void ProcessorHarness::setSectionProfilingEnabled (const bool shouldBeEnabled)
+{
+    sectionProfilingEnabled = shouldBeEnabled;
+}
+bool ProcessorHarness::isSectionProfilingEnabled() const
+{
+    return sectionProfilingEnabled.get();
+}
+const SectionProfiler* ProcessorHarness::getSectionProfiler() const
+{
+    return sectionProfilingEnabled.get() ? &sectionProfiler : nullptr;
+}
+const PerformanceCounters::Totals& ProcessorHarness::getPerformanceCounterTotals() const
+{
+    return procCounterTotals;
 }
 int ProcessorHarness::getNumControls() const
 {
@@ -93,6 +246,21 @@ dsp::ProcessSpec ProcessorHarness::getCurrentProcessSpec () const
 {
     return currentSpec;
 }
+bool ProcessorHarness::setTimingSource (const BenchmarkTimer::Source source)
+{
+    const auto previousSource = timer.getSource();
+    if (!timer.setSource (source))
+        return false;
+
+    // Statistics gathered with different clocks aren't comparable
+    if (source != previousSource)
+        resetStatistics();
+    return true;
+}
+const BenchmarkTimer& ProcessorHarness::getTimer() const
+{
+    return timer;
+}
 double ProcessorHarness::queryPrepareDurationAverage () const
 {
     return prepDurationSum / prepDurationCount;
@@ -109,6 +277,12 @@ double ProcessorHarness::queryPrepareDurationNumSamples () const
 {
     return prepDurationCount;
 }
+double ProcessorHarness::queryPrepareDurationPercentile (const double percentile) const
+{
+    if (prepDurationCount <= 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return jlimit (prepDurationMin, prepDurationMax, prepDurationHistogram.getPercentile (percentile));
+}
 double ProcessorHarness::queryProcessingDurationAverage () const
 {
     return procDurationSum / procDurationCount;
@@ -125,6 +299,20 @@ double ProcessorHarness::queryProcessingDurationNumSamples () const
 {
     return procDurationCount;
 }
+double ProcessorHarness::queryProcessingDurationPercentile (const double percentile) const
+{
+    if (procDurationCount <= 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return jlimit (procDurationMin, procDurationMax, procDurationHistogram.getPercentile (percentile));
+}
+double ProcessorHarness::queryProcessingDeadlineMisses() const
+{
+    return procDeadlineMisses;
+}
+double ProcessorHarness::queryProcessingDurationLast() const
+{
+    return procDurationLast;
+}
 double ProcessorHarness::queryResetDurationAverage () const
 {
     return resetDurationSum / resetDurationCount;
@@ -141,10 +329,16 @@ double ProcessorHarness::queryResetDurationNumSamples () const
 {
     return resetDurationCount;
 }
+double ProcessorHarness::queryResetDurationPercentile (const double percentile) const
+{
+    if (resetDurationCount <= 0.0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return jlimit (resetDurationMin, resetDurationMax, resetDurationHistogram.getPercentile (percentile));
+}
 double ProcessorHarness::queryByIndex (const int routineIndex, const int valueIndex) const
 {
     jassert (routineIndex >= 0 && routineIndex < 3);
-    jassert (valueIndex >= 0 && valueIndex < 4);
+    jassert (valueIndex >= 0 && valueIndex < numQueryValues);
     switch (routineIndex)
     {
         case 0:
@@ -154,7 +348,7 @@ double ProcessorHarness::queryByIndex (const int routineIndex, const int valueIn
                 case 1: return queryPrepareDurationAverage();
                 case 2: return queryPrepareDurationMax();
                 case 3: return queryPrepareDurationNumSamples();
-                default: return 0.0;
+                default: return queryPrepareDurationPercentile (queryPercentiles[static_cast<size_t> (valueIndex - 4)]);
             }
         case 1:
             switch (valueIndex)
@@ -163,7 +357,7 @@ double ProcessorHarness::queryByIndex (const int routineIndex, const int valueIn
                 case 1: return queryProcessingDurationAverage();
                 case 2: return queryProcessingDurationMax();
                 case 3: return queryProcessingDurationNumSamples();
-                default: return 0.0;
+                default: return queryProcessingDurationPercentile (queryPercentiles[static_cast<size_t> (valueIndex - 4)]);
             }
         case 2:
             switch (valueIndex)
@@ -172,16 +366,33 @@ double ProcessorHarness::queryByIndex (const int routineIndex, const int valueIn
                 case 1: return queryResetDurationAverage();
                 case 2: return queryResetDurationMax();
                 case 3: return queryResetDurationNumSamples();
-                default: return 0.0;
+                default: return queryResetDurationPercentile (queryPercentiles[static_cast<size_t> (valueIndex - 4)]);
             }
         default: return 0.0;
     }
 }
+String ProcessorHarness::getQueryValueName (const int valueIndex)
+{
+    jassert (valueIndex >= 0 && valueIndex < numQueryValues);
+    switch (valueIndex)
+    {
+        case 0: return "Min";
+        case 1: return "Avg";
+        case 2: return "Max";
+        case 3: return "#";
+        default:
+        {
+            // Strip trailing zeros so we get p50, p99.9, etc.
+            const auto percentile = String (queryPercentiles[static_cast<size_t> (valueIndex - 4)], 2);
+            return "p" + percentile.trimCharactersAtEnd ("0").trimCharactersAtEnd (".");
+        }
+    }
+}
 int ProcessorHarness::getQueryIndex (const int routineIndex, const int valueIndex)
 {
     jassert (routineIndex >= 0 && routineIndex < 3);
-    jassert (valueIndex >= 0 && valueIndex < 4);
-    return routineIndex * 4 + valueIndex ;
+    jassert (valueIndex >= 0 && valueIndex < numQueryValues);
+    return routineIndex * numQueryValues + valueIndex ;
 }
 void ProcessorHarness::resetStatistics()
 {
@@ -189,14 +400,54 @@ void ProcessorHarness::resetStatistics()
     prepDurationMax = -1.0;
     prepDurationSum = 0.0;
     prepDurationCount = 0.0;
+    prepDurationHistogram.reset();
     
-    procDurationMin = 1.0E100;
-    procDurationMax = -1.0;
-    procDurationSum = 0.0;
-    procDurationCount = 0.0;
+    resetProcessStatistics();
 
     resetDurationMin = 1.0E100;
     resetDurationMax = -1.0;
     resetDurationSum = 0.0;
     resetDurationCount = 0.0;
+    resetDurationHistogram.reset();
+
+    previousViolations += procViolations.getTotal() + resetViolations.getTotal();
+    procViolations.reset();
+    resetViolations.reset();
+    prepUsage.reset();
+    resetUsage.reset();
+}
+void ProcessorHarness::resetProcessStatistics()
+{
+    procDurationMin = 1.0E100;
+    procDurationMax = -1.0;
+    procDurationSum = 0.0;
+    procDurationCount = 0.0;
+    procDurationHistogram.reset();
+    procDeadlineMisses = 0.0;
+    procDurationLast = 0.0;
+
+    procCounterTotals.reset();
+    procUsage.reset();
+    iterationClassifier.reset();
+    outlierReferenceMs = std::numeric_limits<double>::quiet_NaN();
+    sectionProfiler.reset();
+}
+int64 ProcessorHarness::countSubnormals (const dsp::AudioBlock<const float>& block)
+{
+    constexpr uint32 exponentMask = 0x7f800000;
+    constexpr uint32 mantissaMask = 0x007fffff;
+
+    int64 count = 0;
+    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+    {
+        const auto* data = block.getChannelPointer (ch);
+        for (size_t i = 0; i < block.getNumSamples(); ++i)
+        {
+            uint32 bits;
+            std::memcpy (&bits, data + i, sizeof (bits));
+            if ((bits & exponentMask) == 0 && (bits & mantissaMask) != 0)
+                count++;
+        }
+    }
+    return count;
 }
\ No newline at end of file
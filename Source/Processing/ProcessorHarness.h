@@ -11,6 +11,13 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "LatencyHistogram.h"
+#include "BenchmarkTimer.h"
+#include "PerformanceCounters.h"
+#include "RealtimeGuard.h"
+#include "ResourceUsage.h"
+#include "IterationClassifier.h"
+#include "SectionProfiler.h"
 
 /** 
  * Inherit from this and implement the virtual methods in order to create a customised ProcessorHarness.
@@ -43,6 +50,11 @@ public:
      *  NOTE - the controls are floats in the range 0..1.
      */
     virtual double getDefaultControlValue (const int index) = 0;
+
+    /** Override this to return a new instance of your processor, which allows it to be used in the multi-instance benchmark
+     *  (the default returns nullptr, meaning the processor can't be instantiated more than once).
+     */
+    virtual std::unique_ptr<ProcessorHarness> createInstance() { return nullptr; }
     
     // =================================================================================================================================
 
@@ -52,10 +64,78 @@ public:
     /** Harness which wraps your process() method. */
     void processHarness (const dsp::ProcessContextReplacing<float>& context);
 
+    /** Runs processHarness() a number of times with the performance counters only enabled around each call of your process()
+     *  method, so the harness's own work (statistics, guards, profiling etc.) isn't counted, and the counters are only read once
+     *  for the whole batch. The counts are accumulated into the totals returned by getPerformanceCounterTotals(). Note that the
+     *  counts include the timer reads & the few instructions either side of the calls which enable & disable the counters.
+     */
+    void processHarnessWithCounters (const dsp::ProcessContextReplacing<float>& context, const int numIterations, PerformanceCounters& counters);
+
     /** Harness which wraps your reset() method. */
     void resetHarness();
 
 
+    /** Returns the hardware performance counts accumulated by processHarness() since statistics were reset. */
+    [[nodiscard]] const PerformanceCounters::Totals& getPerformanceCounterTotals() const;
+
+
+    /** Runs your process() & reset() methods inside a RealtimeGuard, which counts any allocations, deallocations & blocking
+     *  locks they make (and optionally captures their stack traces). The violations are cleared along with the statistics.
+     */
+    void setRealtimeGuardEnabled (const bool shouldBeEnabled, const bool captureStackTraces = false);
+
+    [[nodiscard]] bool isRealtimeGuardEnabled() const;
+
+    /** Returns the violations recorded for a routine (using the routine indices of queryByIndex()), or nullptr if the routine
+     *  isn't guarded (i.e. prepare, which is allowed to allocate, or if the guard isn't enabled).
+     */
+    [[nodiscard]] const RealtimeGuard::Violations* getRealtimeViolations (const int routineIndex) const;
+
+    /** Returns the number of violations recorded since the guard was enabled. Unlike getRealtimeViolations(), this isn't cleared
+     *  by resetStatistics(), so it covers every cell of a sweep (and any instances merged with mergeRealtimeViolations()).
+     */
+    [[nodiscard]] int64 getRealtimeViolationsSinceEnabled() const;
+
+    /** Adds the violations of another harness (e.g. an instance created by createInstance() & run on another thread). */
+    void mergeRealtimeViolations (const ProcessorHarness& other);
+
+
+    /** Samples the page faults, context switches & peak RSS (see ResourceUsage) around each call of your prepare(), process() &
+     *  reset() methods, outside of the timed region. The totals are cleared along with the statistics.
+     */
+    void setResourceUsageEnabled (const bool shouldBeEnabled);
+
+    [[nodiscard]] bool isResourceUsageEnabled() const;
+
+    /** Returns the resource usage accumulated by a routine (using the routine indices of queryByIndex()), or nullptr if it isn't enabled. */
+    [[nodiscard]] const ResourceUsage::Totals* getResourceUsage (const int routineIndex) const;
+
+
+    /** Set the number of process calls after each prepare() which are a warm-up (0 for none, or IterationClassifier::autoWarmup
+     *  to detect the end of it). Warm-up calls are left out of the process statistics & reported by getIterationClassifier().
+     */
+    void setWarmup (const int numCalls);
+
+    /** Set the factor of the median above which a process call is recorded as an outlier (see IterationClassifier). */
+    void setOutlierFactor (const double factor);
+
+    /** Returns the warm-up statistics & outliers of the process routine. Outliers are only looked for once the median can be
+     *  estimated (from the 16th steady state call after the statistics were reset), so pass the median process duration to it.
+     */
+    [[nodiscard]] const IterationClassifier& getIterationClassifier() const;
+
+
+    /** Records the times of the sections your process() method marks with DSP_TESTBENCH_SECTION (see SectionProfiler). Only the
+     *  steady state calls are recorded, and the times are cleared along with the statistics.
+     */
+    void setSectionProfilingEnabled (const bool shouldBeEnabled);
+
+    [[nodiscard]] bool isSectionProfilingEnabled() const;
+
+    /** Returns the section times of the process routine, or nullptr if section profiling isn't enabled. */
+    [[nodiscard]] const SectionProfiler* getSectionProfiler() const;
+
+
     /** Returns the number of control values for this processor. */
     [[nodiscard]] int getNumControls() const;
 
@@ -72,6 +152,15 @@ public:
     [[nodiscard]] dsp::ProcessSpec getCurrentProcessSpec() const;
 
 
+    /** Selects the clock used to time the harness routines (returns false if it isn't available, leaving the statistics as
+     *  they were). Statistics are reset if the clock changes and the timer overhead is recalibrated, so don't call this while the harness is running on another thread.
+     */
+    bool setTimingSource (const BenchmarkTimer::Source source);
+
+    /** Returns the timer used for the statistics (e.g. to report the clock and the overhead being compensated). */
+    [[nodiscard]] const BenchmarkTimer& getTimer() const;
+
+
     /** Returns the average time it takes to run processToBeTested() at the current ProcessSpec (in milliseconds). */
     [[nodiscard]] double queryPrepareDurationAverage() const;
 
@@ -84,6 +173,9 @@ public:
     /** Returns the number of times processToBeTested() has been called since statistics were reset. */
     [[nodiscard]] double queryPrepareDurationNumSamples() const;
 
+    /** Returns the time (in milliseconds) within which the given percentage (0..100) of calls completed. */
+    [[nodiscard]] double queryPrepareDurationPercentile (const double percentile) const;
+
 
     /** Returns the average time it takes to run processToBeTested() at the current ProcessSpec (in milliseconds). */
     [[nodiscard]] double queryProcessingDurationAverage() const;
@@ -97,6 +189,17 @@ public:
     /** Returns the number of times processToBeTested() has been called since statistics were reset. */
     [[nodiscard]] double queryProcessingDurationNumSamples() const;
 
+    /** Returns the time (in milliseconds) within which the given percentage (0..100) of calls completed. */
+    [[nodiscard]] double queryProcessingDurationPercentile (const double percentile) const;
+
+    /** Returns the number of process calls which took longer than the real-time budget for their block (i.e. the number of
+     *  samples in the block divided by the sample rate), so would have caused an xrun if they were running on the audio thread.
+     */
+    [[nodiscard]] double queryProcessingDeadlineMisses() const;
+
+    /** Returns the time the most recent call to processToBeTested() took (in milliseconds, or 0 if it hasn't been called). */
+    [[nodiscard]] double queryProcessingDurationLast() const;
+
     
     /** Returns the average time it takes to run processToBeTested() at the current ProcessSpec (in milliseconds). */
     [[nodiscard]] double queryResetDurationAverage() const;
@@ -110,10 +213,22 @@ public:
     /** Returns the number of times processToBeTested() has been called since statistics were reset. */
     [[nodiscard]] double queryResetDurationNumSamples() const;
 
+    /** Returns the time (in milliseconds) within which the given percentage (0..100) of calls completed. */
+    [[nodiscard]] double queryResetDurationPercentile (const double percentile) const;
+
     
+    /** Number of values which can be queried for each routine (min, avg, max, count, then each of the queryPercentiles). */
+    static constexpr int numQueryValues = 9;
+
+    /** Percentiles returned by queryByIndex() for value indices 4 and above. */
+    static constexpr std::array<double, 5> queryPercentiles { 50.0, 90.0, 99.0, 99.9, 99.99 };
+
     /** Utility function to query performance by routine & value indices (returns time statistics in milliseconds). */
     [[nodiscard]] double queryByIndex (const int routineIndex, const int valueIndex) const;
 
+    /** Returns a short name for a value index used by queryByIndex() (e.g. "Min", "#" or "p99.9"). */
+    static String getQueryValueName (const int valueIndex);
+
     /** Utility function to determine query index according to routine & value indices (returns time statistics in milliseconds). */
     static int getQueryIndex (const int routineIndex, const int valueIndex);
 
@@ -121,12 +236,35 @@ public:
     /** Reset statistics */
     void resetStatistics();
 
+
+    /** Returns the number of subnormal (denormal) samples in the block. This tests the bit patterns rather than comparing
+     *  values, so it still works when denormals-are-zero is enabled (which makes subnormals compare equal to zero).
+     */
+    static int64 countSubnormals (const dsp::AudioBlock<const float>& block);
+
 private:
     	
+    /** Resets the process statistics (and everything gathered from the process calls), e.g. when the spec changes. */
+    void resetProcessStatistics();
+
     dsp::ProcessSpec currentSpec;
+    BenchmarkTimer timer;
     double prepDurationMin = 1.0E100, prepDurationMax = -1.0, prepDurationSum = 0.0, prepDurationCount = 0.0;
     double procDurationMin = 1.0E100, procDurationMax = -1.0, procDurationSum = 0.0, procDurationCount = 0.0;
     double resetDurationMin = 1.0E100, resetDurationMax = -1.0, resetDurationSum = 0.0, resetDurationCount = 0.0;
+    double procDeadlineMisses = 0.0, procDurationLast = 0.0, msPerSample = 0.0;
+    LatencyHistogram prepDurationHistogram, procDurationHistogram, resetDurationHistogram;
+    PerformanceCounters::Totals procCounterTotals {};
+    PerformanceCounters* activeCounters = nullptr;
+    Atomic<bool> realtimeGuardEnabled = false;
+    RealtimeGuard::Violations procViolations {}, resetViolations {};
+    int64 previousViolations = 0;
+    Atomic<bool> resourceUsageEnabled = false;
+    ResourceUsage::Totals prepUsage {}, procUsage {}, resetUsage {};
+    IterationClassifier iterationClassifier {};
+    double outlierReferenceMs = std::numeric_limits<double>::quiet_NaN();
+    Atomic<bool> sectionProfilingEnabled = false;
+    SectionProfiler sectionProfiler;
 
     std::vector <Atomic<double>> controlValues;
 
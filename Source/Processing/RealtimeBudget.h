@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    RealtimeBudget.h
+    Created: 18 Oct 2026 7:02:44pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ProcessorHarness.h"
+
+/**
+ * Relates the processing statistics of a harness to the real-time budget of its ProcessSpec (i.e. the time between audio
+ * callbacks, which is the block size divided by the sample rate), so that capacity planning can use the same numbers as the
+ * benchmark.
+ */
+struct RealtimeBudget
+{
+    double budgetMs = 0.0;              /**< Callback period for the harness's current ProcessSpec (milliseconds). */
+    double meanFraction = 0.0;          /**< Fraction of the budget used on average (1.0 = 100%). */
+    double p99Fraction = 0.0;           /**< Fraction of the budget used by the 99th percentile call. */
+    double p99_9Fraction = 0.0;         /**< Fraction of the budget used by the 99.9th percentile call. */
+    double maxFraction = 0.0;           /**< Fraction of the budget used by the slowest call. */
+    double deadlineMisses = 0.0;        /**< Number of calls which took longer than the budget for their block. */
+    double numCalls = 0.0;
+    int maxInstancesAtMean = 0;         /**< Number of instances which would fit in one callback, based on the average time. */
+    int maxInstancesAtP99 = 0;          /**< Number of instances which would fit in one callback, based on the 99th percentile time. */
+
+    /** Returns true if there are statistics to report. */
+    [[nodiscard]] bool isValid() const noexcept
+    {
+        return budgetMs > 0.0 && numCalls > 0.0;
+    }
+
+    /** Calculates the budget figures from the processing statistics of a harness. */
+    static RealtimeBudget forProcessing (const ProcessorHarness& harness)
+    {
+        RealtimeBudget b;
+        const auto spec = harness.getCurrentProcessSpec();
+        b.numCalls = harness.queryProcessingDurationNumSamples();
+        if (spec.sampleRate <= 0.0 || b.numCalls <= 0.0)
+            return b;
+
+        b.budgetMs = static_cast<double> (spec.maximumBlockSize) * 1000.0 / spec.sampleRate;
+        const auto mean = harness.queryProcessingDurationAverage();
+        const auto p99 = harness.queryProcessingDurationPercentile (99.0);
+        b.meanFraction = mean / b.budgetMs;
+        b.p99Fraction = p99 / b.budgetMs;
+        b.p99_9Fraction = harness.queryProcessingDurationPercentile (99.9) / b.budgetMs;
+        b.maxFraction = harness.queryProcessingDurationMax() / b.budgetMs;
+        b.deadlineMisses = harness.queryProcessingDeadlineMisses();
+        b.maxInstancesAtMean = mean > 0.0 ? static_cast<int> (std::floor (b.budgetMs / mean)) : 0;
+        b.maxInstancesAtP99 = p99 > 0.0 ? static_cast<int> (std::floor (b.budgetMs / p99)) : 0;
+        return b;
+    }
+};
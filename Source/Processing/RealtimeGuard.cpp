@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 18 Oct 2026 10:14:27pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+#include <new>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <execinfo.h>
+#endif
+
+#if DSP_TESTBENCH_RT_GUARD && JUCE_LINUX && defined (__GLIBC__)
+ #define DSP_TESTBENCH_RT_GUARD_MALLOC 1
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <cerrno>
+
+// glibc's allocator entry points, which the interposed functions forward to
+extern "C"
+{
+    void* __libc_malloc (size_t size);
+    void* __libc_calloc (size_t count, size_t size);
+    void* __libc_realloc (void* ptr, size_t size);
+    void* __libc_memalign (size_t alignment, size_t size);
+    void* __libc_valloc (size_t size);
+    void* __libc_pvalloc (size_t size);
+    void __libc_free (void* ptr);
+}
+#else
+ #define DSP_TESTBENCH_RT_GUARD_MALLOC 0
+#endif
+
+namespace
+{
+    // Constant initialised, so it is safe to use from the interposed functions at any time (including during static initialisation)
+    thread_local RealtimeGuard::Violations* activeViolations = nullptr;
+
+   #if DSP_TESTBENCH_RT_GUARD
+    void recordViolation (const RealtimeGuard::Kind kind) noexcept
+    {
+        if (auto* violations = activeViolations)
+        {
+            // Disarm while recording, so anything the recording itself calls (e.g. backtrace loading the unwinder) isn't counted
+            activeViolations = nullptr;
+            violations->record (kind);
+            activeViolations = violations;
+        }
+    }
+
+    void* allocate (const size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+
+        // When malloc is interposed, operator new goes straight to the allocator so that allocations aren't counted twice
+       #if DSP_TESTBENCH_RT_GUARD_MALLOC
+        return __libc_malloc (size == 0 ? 1 : size);
+       #else
+        return std::malloc (size == 0 ? 1 : size);
+       #endif
+    }
+
+    void deallocate (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            recordViolation (RealtimeGuard::Kind::deallocation);
+
+       #if DSP_TESTBENCH_RT_GUARD_MALLOC
+        __libc_free (ptr);
+       #else
+        std::free (ptr);
+       #endif
+    }
+
+    void* allocateAligned (const size_t size, const std::align_val_t alignment) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        const auto align = jmax (sizeof (void*), static_cast<size_t> (alignment));
+
+       #if DSP_TESTBENCH_RT_GUARD_MALLOC
+        return __libc_memalign (align, size == 0 ? 1 : size);
+       #elif JUCE_WINDOWS
+        return _aligned_malloc (size == 0 ? 1 : size, align);
+       #else
+        void* ptr = nullptr;
+        return posix_memalign (&ptr, align, size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+       #endif
+    }
+
+    void deallocateAligned (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            recordViolation (RealtimeGuard::Kind::deallocation);
+
+       #if DSP_TESTBENCH_RT_GUARD_MALLOC
+        __libc_free (ptr);
+       #elif JUCE_WINDOWS
+        _aligned_free (ptr);
+       #else
+        std::free (ptr);
+       #endif
+    }
+
+    void* allocateOrThrow (const size_t size)
+    {
+        if (auto* ptr = allocate (size))
+            return ptr;
+        throw std::bad_alloc();
+    }
+
+    void* allocateAlignedOrThrow (const size_t size, const std::align_val_t alignment)
+    {
+        if (auto* ptr = allocateAligned (size, alignment))
+            return ptr;
+        throw std::bad_alloc();
+    }
+   #endif
+}
+
+// =================================================================================================================================
+
+#if DSP_TESTBENCH_RT_GUARD_MALLOC
+extern "C"
+{
+    void* malloc (size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_malloc (size);
+    }
+    void* calloc (size_t count, size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_calloc (count, size);
+    }
+    void* realloc (void* ptr, size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_realloc (ptr, size);
+    }
+    void* memalign (size_t alignment, size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_memalign (alignment, size);
+    }
+    void* aligned_alloc (size_t alignment, size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_memalign (alignment, size);
+    }
+    int posix_memalign (void** result, size_t alignment, size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        if (alignment < sizeof (void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+        auto* ptr = __libc_memalign (alignment, size);
+        if (ptr == nullptr)
+            return ENOMEM;
+        *result = ptr;
+        return 0;
+    }
+    void* valloc (size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_valloc (size);
+    }
+    void* pvalloc (size_t size) noexcept
+    {
+        recordViolation (RealtimeGuard::Kind::allocation);
+        return __libc_pvalloc (size);
+    }
+    void free (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            recordViolation (RealtimeGuard::Kind::deallocation);
+        __libc_free (ptr);
+    }
+
+    int pthread_mutex_lock (pthread_mutex_t* mutex) noexcept
+    {
+        using LockFunction = int (*) (pthread_mutex_t*);
+
+        // A function local static would need a guard (which can lock a mutex), so the real function is looked up on first use instead
+        static std::atomic<LockFunction> realLock { nullptr };
+        auto lock = realLock.load (std::memory_order_acquire);
+        if (lock == nullptr)
+        {
+            lock = reinterpret_cast<LockFunction> (dlsym (RTLD_NEXT, "pthread_mutex_lock"));
+            realLock.store (lock, std::memory_order_release);
+        }
+
+        recordViolation (RealtimeGuard::Kind::lock);
+        return lock (mutex);
+    }
+}
+#endif
+
+#if DSP_TESTBENCH_RT_GUARD
+void* operator new (size_t size)                                    { return allocateOrThrow (size); }
+void* operator new[] (size_t size)                                  { return allocateOrThrow (size); }
+void* operator new (size_t size, const std::nothrow_t&) noexcept    { return allocate (size); }
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept  { return allocate (size); }
+void operator delete (void* ptr) noexcept                           { deallocate (ptr); }
+void operator delete[] (void* ptr) noexcept                         { deallocate (ptr); }
+void operator delete (void* ptr, size_t) noexcept                   { deallocate (ptr); }
+void operator delete[] (void* ptr, size_t) noexcept                 { deallocate (ptr); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept    { deallocate (ptr); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept  { deallocate (ptr); }
+
+void* operator new (size_t size, std::align_val_t alignment)                                    { return allocateAlignedOrThrow (size, alignment); }
+void* operator new[] (size_t size, std::align_val_t alignment)                                  { return allocateAlignedOrThrow (size, alignment); }
+void* operator new (size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept    { return allocateAligned (size, alignment); }
+void* operator new[] (size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept  { return allocateAligned (size, alignment); }
+void operator delete (void* ptr, std::align_val_t) noexcept                                     { deallocateAligned (ptr); }
+void operator delete[] (void* ptr, std::align_val_t) noexcept                                   { deallocateAligned (ptr); }
+void operator delete (void* ptr, size_t, std::align_val_t) noexcept                             { deallocateAligned (ptr); }
+void operator delete[] (void* ptr, size_t, std::align_val_t) noexcept                           { deallocateAligned (ptr); }
+void operator delete (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept              { deallocateAligned (ptr); }
+void operator delete[] (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept            { deallocateAligned (ptr); }
+#endif
+
+// =================================================================================================================================
+
+void RealtimeGuard::Violations::reset() noexcept
+{
+    for (auto& count : counts)
+        count.store (0, std::memory_order_relaxed);
+    numStackTraces.store (0, std::memory_order_relaxed);
+}
+int64 RealtimeGuard::Violations::getCount (const Kind kind) const noexcept
+{
+    return counts[static_cast<size_t> (kind)].load (std::memory_order_relaxed);
+}
+int64 RealtimeGuard::Violations::getTotal() const noexcept
+{
+    int64 total = 0;
+    for (const auto& count : counts)
+        total += count.load (std::memory_order_relaxed);
+    return total;
+}
+void RealtimeGuard::Violations::record (const Kind kind) noexcept
+{
+    counts[static_cast<size_t> (kind)].fetch_add (1, std::memory_order_relaxed);
+    if (!captureStackTraces)
+        return;
+
+   #if JUCE_LINUX || JUCE_MAC
+    std::array<void*, maxFrames> frames;
+    const auto numFrames = backtrace (frames.data(), maxFrames);
+
+    // Only distinct stack traces are kept, as the same call is usually made on every block
+    const auto numTraces = numStackTraces.load (std::memory_order_relaxed);
+    for (auto i = 0; i < numTraces; ++i)
+    {
+        auto& trace = stackTraces[static_cast<size_t> (i)];
+        if (trace.kind == kind && trace.numFrames == numFrames && std::equal (frames.begin(), frames.begin() + numFrames, trace.frames.begin()))
+        {
+            trace.count.fetch_add (1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    if (numTraces < maxStackTraces)
+    {
+        // The trace is filled in before it is published, so another thread never reads a partial one
+        auto& trace = stackTraces[static_cast<size_t> (numTraces)];
+        trace.kind = kind;
+        trace.count.store (1, std::memory_order_relaxed);
+        trace.numFrames = numFrames;
+        trace.frames = frames;
+        numStackTraces.store (numTraces + 1, std::memory_order_release);
+    }
+   #endif
+}
+StringArray RealtimeGuard::Violations::getStackTraceDescriptions() const
+{
+    StringArray descriptions;
+    const auto numTraces = numStackTraces.load (std::memory_order_acquire);
+    for (auto i = 0; i < numTraces; ++i)
+    {
+        const auto& trace = stackTraces[static_cast<size_t> (i)];
+        String description;
+        description << trace.count.load (std::memory_order_relaxed) << " " << getKindName (trace.kind) << " from:" << newLine;
+
+       #if JUCE_LINUX || JUCE_MAC
+        if (auto** symbols = backtrace_symbols (trace.frames.data(), trace.numFrames))
+        {
+            for (auto f = 0; f < trace.numFrames; ++f)
+                description << "    " << symbols[f] << newLine;
+            ::free (symbols);
+        }
+       #endif
+        descriptions.add (description);
+    }
+    return descriptions;
+}
+
+RealtimeGuard::ScopedGuard::ScopedGuard (Violations* violationsToRecordInto) noexcept
+    : violations (violationsToRecordInto)
+{
+    if (violations != nullptr)
+    {
+        previousViolations = activeViolations;
+        activeViolations = violations;
+    }
+}
+RealtimeGuard::ScopedGuard::~ScopedGuard() noexcept
+{
+    if (violations != nullptr)
+        activeViolations = previousViolations;
+}
+
+bool RealtimeGuard::canDetectMalloc()
+{
+   #if DSP_TESTBENCH_RT_GUARD_MALLOC
+    return true;
+   #else
+    return false;
+   #endif
+}
+bool RealtimeGuard::canDetectLocks()
+{
+   #if DSP_TESTBENCH_RT_GUARD_MALLOC
+    return true;
+   #else
+    return false;
+   #endif
+}
+bool RealtimeGuard::canCaptureStackTraces()
+{
+   #if JUCE_LINUX || JUCE_MAC
+    return true;
+   #else
+    return false;
+   #endif
+}
+String RealtimeGuard::getKindName (const Kind kind)
+{
+    switch (kind)
+    {
+        case Kind::allocation: return "allocations";
+        case Kind::deallocation: return "deallocations";
+        case Kind::lock: return "locks";
+        default: return {};
+    }
+}
+String RealtimeGuard::getCountsText (const Violations& violations)
+{
+    StringArray parts;
+    for (auto k = 0; k < static_cast<int> (Kind::numKinds); ++k)
+    {
+        const auto kind = static_cast<Kind> (k);
+        if (kind != Kind::lock || canDetectLocks())
+            parts.add (String (violations.getCount (kind)) + " " + getKindName (kind));
+    }
+    return parts.joinIntoString (", ");
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 18 Oct 2026 10:14:27pm
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+#include <atomic>
+
+/** Set this to 1 to build the functions the guard intercepts (see RealtimeGuard). It is off by default, as replacing the global
+ *  allocation functions conflicts with sanitizers (e.g. ASan) & other allocators (e.g. jemalloc or tcmalloc).
+ */
+#ifndef DSP_TESTBENCH_RT_GUARD
+ #define DSP_TESTBENCH_RT_GUARD 0
+#endif
+
+/**
+ * Detects calls which aren't real-time safe (memory allocation & blocking locks) made by a thread while a ScopedGuard is armed.
+ *
+ * When DSP_TESTBENCH_RT_GUARD is 1, the global operator new & delete (including the aligned versions) are replaced on all
+ * platforms. On Linux (glibc), malloc, calloc, realloc, free, valloc, pvalloc & the aligned allocation functions are also
+ * interposed (forwarding to glibc's allocator), as is pthread_mutex_lock (which JUCE's CriticalSection & std::mutex both use).
+ * The interposed functions only check a thread local pointer while no guard is armed, so the cost to the rest of the application
+ * is negligible. Memory mapped directly (e.g. mmap) isn't detected, and without DSP_TESTBENCH_RT_GUARD nothing is.
+ */
+class RealtimeGuard
+{
+public:
+
+    enum class Kind : int
+    {
+        allocation = 0,
+        deallocation,
+        lock,
+        numKinds
+    };
+
+    /** Violations recorded while a guard was armed, along with the distinct stack traces of the first few of them. */
+    struct Violations
+    {
+        static constexpr int maxStackTraces = 8;
+        static constexpr int maxFrames = 32;
+
+        struct StackTrace
+        {
+            Kind kind = Kind::allocation;
+            std::atomic<int64> count { 0 };                 /**< Number of violations with this stack trace. */
+            int numFrames = 0;
+            std::array<void*, maxFrames> frames {};
+        };
+
+        // Recorded on the guarded thread & read on others (e.g. the GUI while the live audio path is guarded), hence atomic
+        std::array<std::atomic<int64>, static_cast<size_t> (Kind::numKinds)> counts {};
+        std::array<StackTrace, maxStackTraces> stackTraces {};
+        std::atomic<int> numStackTraces { 0 };              /**< Each stack trace is complete before this is incremented. */
+        bool captureStackTraces = false;                    /**< Capturing is much slower than counting, so it is optional. */
+
+        /** Clears the counts & stack traces (but not whether stack traces are captured). */
+        void reset() noexcept;
+
+        [[nodiscard]] int64 getCount (const Kind kind) const noexcept;
+        [[nodiscard]] int64 getTotal() const noexcept;
+
+        /** Records a violation. This is called from the interposed functions, so it mustn't allocate or lock. */
+        void record (const Kind kind) noexcept;
+
+        /** Returns a description of each stack trace (with the symbols resolved, which allocates, so don't call this on a guarded thread). */
+        [[nodiscard]] StringArray getStackTraceDescriptions() const;
+    };
+
+    /** Arms the guard on the calling thread for its lifetime, so that any violations made by the thread are recorded into the
+     *  given object (which must outlive the guard). Does nothing if the object is null, so it can be left in place when the guard
+     *  isn't wanted. Guards may be nested, in which case the innermost one records the violations.
+     */
+    class ScopedGuard
+    {
+    public:
+        explicit ScopedGuard (Violations* violationsToRecordInto) noexcept;
+        ~ScopedGuard() noexcept;
+
+    private:
+        Violations* violations;
+        Violations* previousViolations = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedGuard)
+    };
+
+    RealtimeGuard() = delete;
+
+    /** Returns true if the intercepting functions are built in (i.e. DSP_TESTBENCH_RT_GUARD is 1), otherwise a guard detects nothing. */
+    static constexpr bool isCompiledIn() noexcept
+    {
+        return DSP_TESTBENCH_RT_GUARD != 0;
+    }
+
+    /** Returns true if malloc & free (rather than just operator new & delete) are intercepted on this platform. This is only
+     *  the case on Linux with glibc, so elsewhere allocations made with malloc (e.g. by C libraries) aren't detected.
+     */
+    static bool canDetectMalloc();
+
+    /** Returns true if blocking locks are intercepted on this platform (Linux with glibc only). */
+    static bool canDetectLocks();
+
+    /** Returns true if stack traces can be captured on this platform. */
+    static bool canCaptureStackTraces();
+
+    /** Returns a short name for a kind of violation (e.g. "allocations"). */
+    static String getKindName (const Kind kind);
+
+    /** Returns a summary of the counts (e.g. "2 allocations, 2 deallocations, 0 locks"). */
+    static String getCountsText (const Violations& violations);
+};
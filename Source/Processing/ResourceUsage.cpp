@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    ResourceUsage.cpp
+    Created: 19 Oct 2026 1:12:36am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "ResourceUsage.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/resource.h>
+#endif
+
+void ResourceUsage::Totals::add (const Sample& before, const Sample& after) noexcept
+{
+    for (size_t c = 0; c < counts.size(); ++c)
+        counts[c] += jmax (static_cast<int64> (0), after.counts[c] - before.counts[c]);
+    peakRssGrowthKb += jmax (static_cast<int64> (0), after.peakRssKb - before.peakRssKb);
+
+    const auto faults = (after.counts[minorFaults] - before.counts[minorFaults]) + (after.counts[majorFaults] - before.counts[majorFaults]);
+    if (faults > 0)
+    {
+        if (firstFaultingCall < 0)
+            firstFaultingCall = numCalls;
+        callsWithFaults++;
+    }
+    numCalls++;
+}
+double ResourceUsage::Totals::getPerCall (const Counter counter) const noexcept
+{
+    if (numCalls <= 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double> (counts[static_cast<size_t> (counter)]) / static_cast<double> (numCalls);
+}
+bool ResourceUsage::isSupported()
+{
+   #if JUCE_LINUX || JUCE_MAC
+    return true;
+   #else
+    return false;
+   #endif
+}
+ResourceUsage::Sample ResourceUsage::sample() noexcept
+{
+    Sample s;
+   #if JUCE_LINUX || JUCE_MAC
+    rusage usage {};
+   #if JUCE_LINUX
+    const auto result = getrusage (RUSAGE_THREAD, &usage);
+   #else
+    const auto result = getrusage (RUSAGE_SELF, &usage);
+   #endif
+    if (result == 0)
+    {
+        s.counts[minorFaults] = static_cast<int64> (usage.ru_minflt);
+        s.counts[majorFaults] = static_cast<int64> (usage.ru_majflt);
+        s.counts[voluntarySwitches] = static_cast<int64> (usage.ru_nvcsw);
+        s.counts[involuntarySwitches] = static_cast<int64> (usage.ru_nivcsw);
+
+        // ru_maxrss is in KB on Linux, but in bytes on macOS
+       #if JUCE_MAC
+        s.peakRssKb = static_cast<int64> (usage.ru_maxrss) / 1024;
+       #else
+        s.peakRssKb = static_cast<int64> (usage.ru_maxrss);
+       #endif
+    }
+   #endif
+    return s;
+}
+String ResourceUsage::getCounterName (const Counter counter)
+{
+    switch (counter)
+    {
+        case minorFaults: return "Minor faults";
+        case majorFaults: return "Major faults";
+        case voluntarySwitches: return "Voluntary switches";
+        case involuntarySwitches: return "Involuntary switches";
+        default: return {};
+    }
+}
+String ResourceUsage::getTotalsText (const Totals& totals)
+{
+    String txt;
+    for (auto c = 0; c < numCounters; ++c)
+    {
+        const auto counter = static_cast<Counter> (c);
+        txt << (c > 0 ? ", " : "") << getCounterName (counter).toLowerCase() << " " << totals.counts[static_cast<size_t> (c)];
+
+        // The faulting calls count either kind of fault, so they follow both counts rather than qualifying the major faults
+        if (counter == majorFaults && totals.callsWithFaults > 0)
+            txt << ", minor or major faults in " << totals.callsWithFaults << " of " << totals.numCalls << " calls (first at call " << totals.firstFaultingCall << ")";
+    }
+    txt << ", peak RSS +" << totals.peakRssGrowthKb << " KB";
+    return txt;
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    ResourceUsage.h
+    Created: 19 Oct 2026 1:12:36am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+
+/**
+ * Operating system resource counters (page faults, context switches & peak resident set size) sampled around each call of a
+ * harness routine using getrusage, so that they can be attributed to prepare, process or reset.
+ *
+ * The faults & context switches are counted for the calling thread on Linux (RUSAGE_THREAD), but for the whole process on macOS,
+ * and the peak RSS is always the high-water mark of the whole process, so its growth is attributed to whichever routine was
+ * running when it grew. A processor which faults pages in on first touch in process() looks fine on average but glitches on the
+ * audio thread, which this makes visible. The counters aren't available on Windows.
+ */
+class ResourceUsage
+{
+public:
+
+    enum Counter
+    {
+        minorFaults = 0,        /**< Page faults serviced without I/O (e.g. first touch of newly allocated memory). */
+        majorFaults,            /**< Page faults which needed I/O (e.g. memory which had been swapped out or a memory mapped file). */
+        voluntarySwitches,      /**< Context switches because the thread blocked (e.g. waiting on a lock or I/O). */
+        involuntarySwitches,    /**< Context switches because the thread was preempted. */
+        numCounters
+    };
+
+    /** Counters at a point in time. */
+    struct Sample
+    {
+        std::array<int64, numCounters> counts {};
+        int64 peakRssKb = 0;
+    };
+
+    /** Counts accumulated over a number of calls. */
+    struct Totals
+    {
+        std::array<int64, numCounters> counts {};
+        int64 peakRssGrowthKb = 0;      /**< How much the process' peak RSS grew during the calls. */
+        int64 numCalls = 0;
+        int64 callsWithFaults = 0;      /**< Number of calls which caused any page faults. */
+        int64 firstFaultingCall = -1;   /**< Index of the first call which caused a page fault (-1 if none did). */
+
+        void reset() noexcept
+        {
+            counts.fill (0);
+            peakRssGrowthKb = 0;
+            numCalls = 0;
+            callsWithFaults = 0;
+            firstFaultingCall = -1;
+        }
+
+        /** Adds the difference between the samples taken before & after a call. */
+        void add (const Sample& before, const Sample& after) noexcept;
+
+        /** Returns the average count per call (NaN if there haven't been any calls). */
+        [[nodiscard]] double getPerCall (const Counter counter) const noexcept;
+    };
+
+    ResourceUsage() = delete;
+
+    /** Returns true if the counters are supported on this platform. */
+    static bool isSupported();
+
+    /** Returns the current counters (for the calling thread where the platform supports it). This is a single system call. */
+    static Sample sample() noexcept;
+
+    static String getCounterName (const Counter counter);
+
+    /** Returns a summary of the totals (e.g. "minor faults 12, major faults 0, minor or major faults in 3 of 1000 calls (first at call 0), ..."). */
+    static String getTotalsText (const Totals& totals);
+};
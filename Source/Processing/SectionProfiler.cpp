@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    SectionProfiler.cpp
+    Created: 19 Oct 2026 2:51:23am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#include "SectionProfiler.h"
+#include <cstring>
+
+void SectionProfiler::setTimer (const BenchmarkTimer* timerToUse) noexcept
+{
+    timer = timerToUse;
+}
+void SectionProfiler::beginCall() noexcept
+{
+    jassert (timer != nullptr);
+    stackSize = 0;
+    active = timer != nullptr ? this : nullptr;
+}
+void SectionProfiler::endCall() noexcept
+{
+    active = nullptr;
+
+    // A section still open here would be a bug in the processor (or an exception thrown out of process())
+    jassert (stackSize == 0);
+    stackSize = 0;
+}
+void SectionProfiler::commitCall (const bool shouldKeep) noexcept
+{
+    for (auto i = 0; i < numSections; ++i)
+    {
+        const auto s = static_cast<size_t> (i);
+        if (shouldKeep && callEntries[s] > 0)
+        {
+            auto& section = sections[s];
+            section.numCalls++;
+            section.numEntries += callEntries[s];
+            section.durationSum += callDurations[s];
+            section.durationMax = jmax (section.durationMax, callDurations[s]);
+        }
+        callDurations[s] = 0.0;
+        callEntries[s] = 0;
+    }
+    if (shouldKeep)
+        numCalls++;
+}
+void SectionProfiler::reset() noexcept
+{
+    sections.fill ({});
+    numSections = 0;
+    callDurations.fill (0.0);
+    callEntries.fill (0);
+    stackSize = 0;
+    numCalls = 0.0;
+    numDropped = 0;
+}
+int SectionProfiler::getNumSections() const noexcept
+{
+    return numSections;
+}
+const SectionProfiler::Section& SectionProfiler::getSection (const int index) const noexcept
+{
+    jassert (index >= 0 && index < numSections);
+    return sections[static_cast<size_t> (index)];
+}
+double SectionProfiler::getNumCalls() const noexcept
+{
+    return numCalls;
+}
+int64 SectionProfiler::getNumDropped() const noexcept
+{
+    return numDropped;
+}
+String SectionProfiler::getTreeText (const double processAverageMs) const
+{
+    const auto us = [] (const double ms) { return String (ms * 1000.0, 2).paddedLeft (' ', 10); };
+
+    String txt;
+    txt << String ("Section").paddedRight (' ', 32) << "  Avg (us)  Max (us)  Runs/call  % of process" << newLine;
+
+    // The sections are in the order they first ran, so a depth first walk of the children gives the tree
+    std::function<void (int)> addChildren = [&] (const int parent)
+    {
+        for (auto i = 0; i < numSections; ++i)
+        {
+            const auto& section = sections[static_cast<size_t> (i)];
+            if (section.parent != parent)
+                continue;
+
+            const auto average = getAverage (i);
+            txt << (String::repeatedString ("  ", section.depth) + section.name).paddedRight (' ', 32)
+                << us (average) << us (section.durationMax)
+                << String (numCalls > 0.0 ? section.numEntries / numCalls : 0.0, 2).paddedLeft (' ', 11)
+                << (processAverageMs > 0.0 ? String (average / processAverageMs * 100.0, 1) + "%" : String ("-")).paddedLeft (' ', 14) << newLine;
+            addChildren (i);
+        }
+    };
+    addChildren (-1);
+
+    // Time in process() which isn't in any top level section
+    auto sectionsMs = 0.0;
+    for (auto i = 0; i < numSections; ++i)
+        if (sections[static_cast<size_t> (i)].parent < 0)
+            sectionsMs += getAverage (i);
+    if (processAverageMs > 0.0)
+        txt << String ("(outside sections)").paddedRight (' ', 32) << us (jmax (0.0, processAverageMs - sectionsMs)) << String().paddedLeft (' ', 21)
+            << (String (jmax (0.0, processAverageMs - sectionsMs) / processAverageMs * 100.0, 1) + "%").paddedLeft (' ', 14) << newLine;
+
+    if (numDropped > 0)
+        txt << numDropped << " section runs weren't timed (more than " << maxSections << " sections or nested deeper than " << maxDepth << ")" << newLine;
+    return txt;
+}
+var SectionProfiler::getAsJson (const double processAverageMs) const
+{
+    std::function<Array<var> (int)> getChildren = [&] (const int parent)
+    {
+        Array<var> children;
+        for (auto i = 0; i < numSections; ++i)
+        {
+            const auto& section = sections[static_cast<size_t> (i)];
+            if (section.parent != parent)
+                continue;
+
+            const auto average = getAverage (i);
+            auto* sectionObj = new DynamicObject();
+            sectionObj->setProperty ("name", String (section.name));
+            sectionObj->setProperty ("avg_us", average * 1000.0);
+            sectionObj->setProperty ("max_us", section.durationMax * 1000.0);
+            sectionObj->setProperty ("runs_per_call", numCalls > 0.0 ? section.numEntries / numCalls : 0.0);
+            sectionObj->setProperty ("percent_of_process", processAverageMs > 0.0 ? var (average / processAverageMs * 100.0) : var());
+            sectionObj->setProperty ("children", getChildren (i));
+            children.add (var (sectionObj));
+        }
+        return children;
+    };
+    return getChildren (-1);
+}
+int SectionProfiler::enter (const char* name) noexcept
+{
+    if (stackSize >= maxDepth)
+    {
+        numDropped++;
+        return -1;
+    }
+
+    const auto index = findOrAddSection (name, stackSize > 0 ? stackSections[static_cast<size_t> (stackSize - 1)] : -1);
+    if (index < 0)
+    {
+        numDropped++;
+        return -1;
+    }
+
+    // The clock is read last, so the bookkeeping isn't included in the section
+    stackSections[static_cast<size_t> (stackSize)] = index;
+    stackTicks[static_cast<size_t> (stackSize)] = timer->start();
+    stackSize++;
+    return index;
+}
+void SectionProfiler::exit (const int index) noexcept
+{
+    // The clock is read first, so the bookkeeping isn't included in the section
+    const auto ticks = timer->stop();
+    if (index < 0 || stackSize <= 0)
+        return;
+
+    stackSize--;
+    jassert (stackSections[static_cast<size_t> (stackSize)] == index);
+    callDurations[static_cast<size_t> (index)] += timer->getElapsedMs (stackTicks[static_cast<size_t> (stackSize)], ticks);
+    callEntries[static_cast<size_t> (index)]++;
+}
+int SectionProfiler::findOrAddSection (const char* name, const int parent) noexcept
+{
+    for (auto i = 0; i < numSections; ++i)
+    {
+        const auto& section = sections[static_cast<size_t> (i)];
+        // Identical literals are usually merged, so the pointer comparison is normally enough
+        if (section.parent == parent && (section.name == name || std::strcmp (section.name, name) == 0))
+            return i;
+    }
+
+    if (numSections >= maxSections)
+        return -1;
+
+    auto& section = sections[static_cast<size_t> (numSections)];
+    section = {};
+    section.name = name;
+    section.parent = parent;
+    section.depth = parent >= 0 ? sections[static_cast<size_t> (parent)].depth + 1 : 0;
+    return numSections++;
+}
+double SectionProfiler::getAverage (const int index) const noexcept
+{
+    return numCalls > 0.0 ? sections[static_cast<size_t> (index)].durationSum / numCalls : 0.0;
+}
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    SectionProfiler.h
+    Created: 19 Oct 2026 2:51:23am
+    Author:  Andrew
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkTimer.h"
+#include <array>
+
+/** Set this to 0 to compile out the DSP_TESTBENCH_SECTION macro (e.g. to ship a processor without removing its sections). */
+#ifndef DSP_TESTBENCH_SECTION_PROFILING
+ #define DSP_TESTBENCH_SECTION_PROFILING 1
+#endif
+
+/**
+ * Times the rest of the enclosing scope as a named section of your process() method, e.g.
+ *
+ *      void process (const dsp::ProcessContextReplacing<float>& context) override
+ *      {
+ *          {
+ *              DSP_TESTBENCH_SECTION ("coefficients");
+ *              updateCoefficients();
+ *          }
+ *          DSP_TESTBENCH_SECTION ("filter");
+ *          ...
+ *      }
+ *
+ * Sections can be nested & the name must be a string literal (or otherwise outlive the harness). The times are only recorded while
+ * the ProcessorHarness has section profiling enabled, otherwise a section costs a thread local read, and nothing at all if
+ * DSP_TESTBENCH_SECTION_PROFILING is 0.
+ */
+#if DSP_TESTBENCH_SECTION_PROFILING
+ #define DSP_TESTBENCH_SECTION(name) const SectionProfiler::ScopedSection JUCE_JOIN_MACRO (dspTestbenchSection_, __LINE__) (name)
+#else
+ #define DSP_TESTBENCH_SECTION(name)
+#endif
+
+/**
+ * Aggregates the times of the named sections (see DSP_TESTBENCH_SECTION) run by each call of a processor's process() method into
+ * a tree, so the breakdown of the total can be seen without hand instrumenting the processor.
+ *
+ * The ProcessorHarness activates the profiler on its thread around each process() call, then commits the times of the sections in
+ * that call once it knows whether the call was a warm-up (which is left out, like the process statistics). There is a fixed number
+ * of sections & nesting levels, so nothing here allocates or locks. Each section adds a timer read at either end, which is
+ * included in the process time (and the times of any enclosing sections).
+ */
+class SectionProfiler
+{
+public:
+
+    /** Maximum number of distinct sections (sections beyond this aren't timed & are counted by getNumDropped()). */
+    static constexpr int maxSections = 64;
+
+    /** Maximum nesting depth of sections. */
+    static constexpr int maxDepth = 16;
+
+    struct Section
+    {
+        const char* name = nullptr;
+        int parent = -1;                /**< Index of the enclosing section (-1 for a top level section). */
+        int depth = 0;
+        double numCalls = 0.0;          /**< Number of process calls which ran this section. */
+        double numEntries = 0.0;        /**< Number of times the section ran (e.g. more than the calls if it is in a loop). */
+        double durationSum = 0.0;       /**< Sum of the time spent in the section (in milliseconds). */
+        double durationMax = 0.0;       /**< Highest time spent in the section during a single process call. */
+    };
+
+    /** Times a section while it is in scope (use the DSP_TESTBENCH_SECTION macro rather than this directly). */
+    class ScopedSection
+    {
+    public:
+        explicit ScopedSection (const char* name) noexcept
+            : profiler (active)
+        {
+            if (profiler != nullptr)
+                index = profiler->enter (name);
+        }
+
+        ~ScopedSection() noexcept
+        {
+            if (profiler != nullptr)
+                profiler->exit (index);
+        }
+
+    private:
+        SectionProfiler* profiler;
+        int index = -1;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedSection)
+    };
+
+    SectionProfiler() = default;
+
+    /** Returns true if the DSP_TESTBENCH_SECTION macro is compiled in. */
+    static constexpr bool isCompiledIn() noexcept
+    {
+        return DSP_TESTBENCH_SECTION_PROFILING != 0;
+    }
+
+    /** Set the timer used to time the sections (the harness's timer, so the overhead compensation matches). */
+    void setTimer (const BenchmarkTimer* timerToUse) noexcept;
+
+    /** Activates the profiler on the calling thread (call this before process()). */
+    void beginCall() noexcept;
+
+    /** Deactivates the profiler (call this after process()). */
+    void endCall() noexcept;
+
+    /** Adds the times of the sections of the last call to the totals if shouldKeep is true (i.e. it wasn't a warm-up call). */
+    void commitCall (const bool shouldKeep) noexcept;
+
+    /** Clears the sections & totals. */
+    void reset() noexcept;
+
+    [[nodiscard]] int getNumSections() const noexcept;
+
+    /** Returns a section (they are in the order they first ran, so each section comes after its parent). */
+    [[nodiscard]] const Section& getSection (const int index) const noexcept;
+
+    /** Returns the number of process calls committed. */
+    [[nodiscard]] double getNumCalls() const noexcept;
+
+    /** Returns the number of times a section wasn't timed because there were too many sections or they were nested too deeply. */
+    [[nodiscard]] int64 getNumDropped() const noexcept;
+
+    /** Returns the breakdown as an indented tree, with the average time of each section per process call & as a percentage of the
+     *  average process time (which should be the steady state average of the harness).
+     */
+    [[nodiscard]] String getTreeText (const double processAverageMs) const;
+
+    /** Returns the breakdown as an array of top level sections, each with an array of its children. */
+    [[nodiscard]] var getAsJson (const double processAverageMs) const;
+
+private:
+
+    int enter (const char* name) noexcept;
+    void exit (const int index) noexcept;
+    int findOrAddSection (const char* name, const int parent) noexcept;
+
+    [[nodiscard]] double getAverage (const int index) const noexcept;
+
+    static inline thread_local SectionProfiler* active = nullptr;
+
+    const BenchmarkTimer* timer = nullptr;
+    std::array<Section, maxSections> sections {};
+    int numSections = 0;
+
+    // Times of the current call (committed by commitCall())
+    std::array<double, maxSections> callDurations {};
+    std::array<int, maxSections> callEntries {};
+
+    std::array<int, maxDepth> stackSections {};
+    std::array<int64, maxDepth> stackTicks {};
+    int stackSize = 0;
+
+    double numCalls = 0.0;
+    int64 numDropped = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SectionProfiler)
+};